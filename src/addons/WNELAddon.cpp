@@ -1,5 +1,7 @@
 #include "WNELAddon.h"
 #include "../core/ConfigManager.h"
+#include "../core/LaunchTimings.h"
+#include "../core/RendererProcessManager.h"
 #include <QDir>
 #include <QFileInfo>
 #include <QJsonDocument>
@@ -18,6 +20,7 @@
 #include <QMessageBox>
 #include <QApplication>
 #include <QRandomGenerator>
+#include <QElapsedTimer>
 
 Q_LOGGING_CATEGORY(wnelAddon, "app.wnelAddon")
 
@@ -54,13 +57,22 @@ WallpaperInfo ExternalWallpaperInfo::toWallpaperInfo() const
 
 WNELAddon::WNELAddon(QObject* parent)
     : QObject(parent)
-    , m_wallpaperProcess(nullptr)
+    , m_renderers(new RendererProcessManager("wnel", this))
     , m_enabled(false)
     , m_fileWatcher(new QFileSystemWatcher(this))
 {
+    connect(m_renderers, &RendererProcessManager::processFinished, this, &WNELAddon::onProcessFinished);
+    connect(m_renderers, &RendererProcessManager::processError, this, &WNELAddon::onProcessError);
+    connect(m_renderers, &RendererProcessManager::outputReady, this, &WNELAddon::onProcessOutput);
+    connect(m_renderers, &RendererProcessManager::firstOutput, this, [this](const QString& screenRoot) {
+        LaunchTimings::instance().markPhase(m_renderers->wallpaperOn(screenRoot), LaunchTimings::Phase::FirstOutput);
+    });
+    
     ConfigManager& config = ConfigManager::instance();
     m_enabled = config.isWNELAddonEnabled();
     m_externalWallpapersPath = config.externalWallpapersPath();
+    m_renderers->setCaptureMode(RendererOutputWorker::captureModeFromString(config.outputCaptureMode()));
+    m_renderers->setOutputLimits(config.outputCollapseRepeats(), config.outputLineBudget());
     
     if (m_enabled) {
         ensureExternalWallpapersDirectory();
@@ -454,8 +466,14 @@ bool WNELAddon::launchExternalWallpaper(const QString& wallpaperId, const QStrin
         return false;
     }
     
-    // Stop any currently running wallpaper
-    stopWallpaper();
+    // Stop the wallpaper on the target output only; launch timings are measured from here
+    QString screenRoot = WallpaperManager::resolveScreenRoot(wallpaperId, additionalArgs);
+    LaunchTimings& timings = LaunchTimings::instance();
+    QElapsedTimer launchTimer;
+    launchTimer.start();
+    stopWallpaperOnScreen(screenRoot);
+    timings.beginLaunch(wallpaperId, "wnel", launchTimer);
+    timings.markPhase(wallpaperId, LaunchTimings::Phase::OldProcessExited);
     
     // Get binary path
     ConfigManager& config = ConfigManager::instance();
@@ -464,12 +482,14 @@ bool WNELAddon::launchExternalWallpaper(const QString& wallpaperId, const QStrin
     // Validate binary path
     QFileInfo binaryInfo(binaryPath);
     if (!binaryInfo.exists()) {
+        timings.abortLaunch(wallpaperId);
         qCWarning(wnelAddon) << "WNEL binary not found at:" << binaryPath;
         emit errorOccurred(QString("WNEL binary not found at: %1").arg(binaryPath));
         return false;
     }
     
     if (!binaryInfo.isExecutable()) {
+        timings.abortLaunch(wallpaperId);
         qCWarning(wnelAddon) << "WNEL binary is not executable:" << binaryPath;
         emit errorOccurred(QString("WNEL binary is not executable: %1").arg(binaryPath));
         return false;
@@ -478,27 +498,19 @@ bool WNELAddon::launchExternalWallpaper(const QString& wallpaperId, const QStrin
     // Validate symlink path
     QFileInfo symlinkInfo(info.symlinkPath);
     if (!symlinkInfo.exists()) {
+        timings.abortLaunch(wallpaperId);
         qCWarning(wnelAddon) << "External wallpaper symlink not found:" << info.symlinkPath;
         emit errorOccurred(QString("External wallpaper file not found: %1").arg(info.symlinkPath));
         return false;
     }
     
-    // Create process
-    m_wallpaperProcess = new QProcess(this);
-    connect(m_wallpaperProcess, QOverload<int, QProcess::ExitStatus>::of(&QProcess::finished),
-            this, &WNELAddon::onProcessFinished);
-    connect(m_wallpaperProcess, &QProcess::errorOccurred, this, &WNELAddon::onProcessError);
-    connect(m_wallpaperProcess, &QProcess::readyReadStandardOutput, this, &WNELAddon::onProcessOutput);
-    connect(m_wallpaperProcess, &QProcess::readyReadStandardError, this, &WNELAddon::onProcessOutput);
-    
     // Build command line arguments
     QStringList args;
     
     // Add wallpaper-specific settings from ConfigManager
     
-    // Add output (screen-root) if configured for this wallpaper
-    QString screenRoot = config.getWallpaperScreenRoot(wallpaperId);
-    if (!screenRoot.isEmpty()) {
+    // Add output (screen-root) unless the UI already passed it
+    if (!screenRoot.isEmpty() && RendererProcessManager::screenFromArgs(additionalArgs).isEmpty()) {
         args << "--output" << screenRoot; // WNEL uses --output instead of --screen-root
     }
     
@@ -575,6 +587,7 @@ bool WNELAddon::launchExternalWallpaper(const QString& wallpaperId, const QStrin
     
     // Add media file path at the end
     args.append(info.symlinkPath);
+    timings.markPhase(wallpaperId, LaunchTimings::Phase::ArgvBuilt);
     
     qCDebug(wnelAddon) << "Original arguments:" << additionalArgs.join(" ");
     qCDebug(wnelAddon) << "Converted WNEL arguments:" << args.join(" ");
@@ -585,20 +598,26 @@ bool WNELAddon::launchExternalWallpaper(const QString& wallpaperId, const QStrin
     QProcessEnvironment env = QProcessEnvironment::systemEnvironment();
     env.insert("__NV_PRIME_RENDER_OFFLOAD", "1");
     env.insert("__GLX_VENDOR_LIBRARY_NAME", "nvidia");
-    m_wallpaperProcess->setProcessEnvironment(env);
     
-    // Start process
-    m_wallpaperProcess->start(binaryPath, args);
-    
-    if (!m_wallpaperProcess->waitForStarted(5000)) {
-        QString errorMsg = QString("Failed to start WNEL process: %1").arg(m_wallpaperProcess->errorString());
+    // Start the renderer for this output
+    if (!m_renderers->start(screenRoot, wallpaperId, binaryPath, args, QString(), env)) {
+        timings.abortLaunch(wallpaperId);
+        QString errorMsg = QString("Failed to start WNEL process: %1").arg(m_renderers->lastError());
         qCWarning(wnelAddon) << errorMsg;
         emit errorOccurred(errorMsg);
-        m_wallpaperProcess->deleteLater();
-        m_wallpaperProcess = nullptr;
         return false;
     }
     
+    if (m_renderers->isAdopted(screenRoot)) {
+        // Already running since the previous session, so there is no launch to time
+        timings.abortLaunch(wallpaperId);
+        qCInfo(wnelAddon) << "Adopted running WNEL process" << m_renderers->processId(screenRoot)
+                          << "on" << RendererProcessManager::displayName(screenRoot);
+    } else {
+        timings.markPhase(wallpaperId, LaunchTimings::Phase::Spawned);
+        timings.watchSteadyState(wallpaperId, m_renderers->processId(screenRoot));
+    }
+    
     m_currentWallpaperId = wallpaperId;
     emit wallpaperLaunched(wallpaperId);
     
@@ -607,30 +626,45 @@ bool WNELAddon::launchExternalWallpaper(const QString& wallpaperId, const QStrin
 
 void WNELAddon::stopWallpaper()
 {
-    if (m_wallpaperProcess) {
-        qCDebug(wnelAddon) << "Stopping external wallpaper process";
-        
-        // Disconnect signals to prevent double cleanup
-        m_wallpaperProcess->disconnect();
-        
-        m_wallpaperProcess->terminate();
-        if (!m_wallpaperProcess->waitForFinished(3000)) {
-            qCWarning(wnelAddon) << "Process did not terminate gracefully, killing it";
-            m_wallpaperProcess->kill();
-            m_wallpaperProcess->waitForFinished(1000);
-        }
-        
-        m_wallpaperProcess->deleteLater();
-        m_wallpaperProcess = nullptr;
-        
+    // Stop the renderers on every output
+    const QStringList screens = m_renderers->screens();
+    for (const QString& screenRoot : screens) {
+        stopWallpaperOnScreen(screenRoot);
+    }
+}
+
+bool WNELAddon::stopWallpaperOnScreen(const QString& screenRoot)
+{
+    if (!m_renderers->hasRenderer(screenRoot)) {
+        return false;
+    }
+    
+    qCDebug(wnelAddon) << "Stopping external wallpaper process on" << RendererProcessManager::displayName(screenRoot);
+    
+    QString wallpaperId = m_renderers->wallpaperOn(screenRoot);
+    m_renderers->stop(screenRoot, 3000);
+    
+    LaunchTimings::instance().abortLaunch(wallpaperId);
+    if (m_currentWallpaperId == wallpaperId && !isWallpaperActive(wallpaperId)) {
         m_currentWallpaperId.clear();
-        emit wallpaperStopped();
     }
+    emit wallpaperStopped();
+    return true;
 }
 
 bool WNELAddon::isWallpaperRunning() const
 {
-    return m_wallpaperProcess && m_wallpaperProcess->state() == QProcess::Running;
+    return m_renderers->isAnyRunning();
+}
+
+bool WNELAddon::isWallpaperActive(const QString& wallpaperId) const
+{
+    return !m_renderers->screensShowing(wallpaperId).isEmpty();
+}
+
+QStringList WNELAddon::activeScreens() const
+{
+    return m_renderers->screens();
 }
 
 QString WNELAddon::getCurrentWallpaper() const
@@ -778,23 +812,24 @@ void WNELAddon::refreshExternalWallpapers()
     qCDebug(wnelAddon) << "Refreshed external wallpapers, found:" << m_externalWallpapers.size();
 }
 
-void WNELAddon::onProcessFinished(int exitCode, QProcess::ExitStatus exitStatus)
+void WNELAddon::onProcessFinished(const QString& screenRoot, const QString& wallpaperId, int exitCode, QProcess::ExitStatus exitStatus)
 {
     Q_UNUSED(exitStatus)
-    qCDebug(wnelAddon) << "External wallpaper process finished with exit code:" << exitCode;
+    qCDebug(wnelAddon) << "External wallpaper process on" << RendererProcessManager::displayName(screenRoot)
+                       << "finished with exit code:" << exitCode;
     
-    if (m_wallpaperProcess) {
-        // Don't call deleteLater here if we manually stopped the process
-        // as stopWallpaper() already handles cleanup
-        m_wallpaperProcess = nullptr;
+    LaunchTimings::instance().abortLaunch(wallpaperId);
+    if (m_currentWallpaperId == wallpaperId && !isWallpaperActive(wallpaperId)) {
+        m_currentWallpaperId.clear();
     }
-    
-    m_currentWallpaperId.clear();
     emit wallpaperStopped();
 }
 
-void WNELAddon::onProcessError(QProcess::ProcessError error)
+void WNELAddon::onProcessError(const QString& screenRoot, const QString& wallpaperId, QProcess::ProcessError error)
 {
+    Q_UNUSED(screenRoot)
+    Q_UNUSED(wallpaperId)
+    
     QString errorString;
     switch (error) {
     case QProcess::FailedToStart:
@@ -821,18 +856,17 @@ void WNELAddon::onProcessError(QProcess::ProcessError error)
     emit errorOccurred(errorString);
 }
 
-void WNELAddon::onProcessOutput()
+void WNELAddon::onProcessOutput(const QString& screenRoot, const RendererOutput& output)
 {
-    if (m_wallpaperProcess) {
-        QByteArray standardOutput = m_wallpaperProcess->readAllStandardOutput();
-        QByteArray standardError = m_wallpaperProcess->readAllStandardError();
-        
-        if (!standardOutput.isEmpty()) {
-            emit outputReceived(QString::fromUtf8(standardOutput));
-        }
-        
-        if (!standardError.isEmpty()) {
-            emit outputReceived(QString::fromUtf8(standardError));
-        }
+    Q_UNUSED(screenRoot)
+    
+    // One block in the order the renderer wrote it
+    QStringList lines;
+    lines.reserve(output.entries.size());
+    for (const RendererOutput::Entry& entry : output.entries) {
+        lines << entry.displayText();
+    }
+    if (!lines.isEmpty()) {
+        emit outputReceived(lines.join("\n"), output.severity);
     }
 }
@@ -13,6 +13,9 @@
 #include <QDir>
 #include <QPixmap>
 #include "../core/WallpaperManager.h"
+#include "../core/RendererOutputWorker.h"
+
+class RendererProcessManager;
 
 // Extend WallpaperInfo to support external wallpapers
 struct ExternalWallpaperInfo {
@@ -58,6 +61,12 @@ public:
     bool isWallpaperRunning() const;
     QString getCurrentWallpaper() const;
     
+    // Per-output renderers, keyed by output name
+    bool stopWallpaperOnScreen(const QString& screenRoot);
+    bool isWallpaperActive(const QString& wallpaperId) const;
+    QStringList activeScreens() const;
+    RendererProcessManager* renderers() const { return m_renderers; }
+    
     // Preview generation
     bool generatePreviewFromVideo(const QString& videoPath, const QString& outputPath, const QSize& size = QSize(900, 900));
     bool generatePreviewFromImage(const QString& imagePath, const QString& outputPath, const QSize& size = QSize(900, 900));
@@ -83,12 +92,13 @@ signals:
     void wallpaperLaunched(const QString& wallpaperId);
     void wallpaperStopped();
     void errorOccurred(const QString& error);
-    void outputReceived(const QString& output);
+    void outputReceived(const QString& output,
+                        RendererLogClassifier::Severity severity = RendererLogClassifier::Severity::Info);
 
 private slots:
-    void onProcessFinished(int exitCode, QProcess::ExitStatus exitStatus);
-    void onProcessError(QProcess::ProcessError error);
-    void onProcessOutput();
+    void onProcessFinished(const QString& screenRoot, const QString& wallpaperId, int exitCode, QProcess::ExitStatus exitStatus);
+    void onProcessError(const QString& screenRoot, const QString& wallpaperId, QProcess::ProcessError error);
+    void onProcessOutput(const QString& screenRoot, const RendererOutput& output);
 
 private:
     // Helper methods
@@ -97,8 +107,8 @@ private:
     void refreshExternalWallpapers();
     
     // Member variables
-    QProcess* m_wallpaperProcess;
-    QString m_currentWallpaperId;
+    RendererProcessManager* m_renderers;
+    QString m_currentWallpaperId;  // most recently launched wallpaper
     QString m_externalWallpapersPath;
     bool m_enabled;
     QList<ExternalWallpaperInfo> m_externalWallpapers;
@@ -0,0 +1,275 @@
+#include "AnimatedPreviewCache.h"
+#include "ThumbnailCache.h"
+#include <QDir>
+#include <QFile>
+#include <QFileInfo>
+#include <QSaveFile>
+#include <QBuffer>
+#include <QDataStream>
+#include <QImage>
+#include <QImageReader>
+#include <QThread>
+#include <QLoggingCategory>
+#include <algorithm>
+
+Q_LOGGING_CATEGORY(animatedPreviewCache, "app.animatedPreviewCache")
+
+namespace {
+constexpr quint32 STRIP_MAGIC = 0x57475053; // "WGPS"
+constexpr quint16 STRIP_VERSION = 1;
+constexpr int JPEG_QUALITY = 85;
+// GIFs with a zero delay are shown at the rate browsers use for them
+constexpr int DEFAULT_FRAME_DELAY = 100;
+
+bool isOpaque(const QImage& image)
+{
+    if (!image.hasAlphaChannel()) {
+        return true;
+    }
+    
+    QImage argb = image.convertToFormat(QImage::Format_ARGB32);
+    for (int y = 0; y < argb.height(); ++y) {
+        const QRgb* line = reinterpret_cast<const QRgb*>(argb.constScanLine(y));
+        for (int x = 0; x < argb.width(); ++x) {
+            if (qAlpha(line[x]) != 255) {
+                return false;
+            }
+        }
+    }
+    return true;
+}
+}
+
+AnimatedPreviewCache::AnimatedPreviewCache()
+    : QObject(nullptr)
+    , m_nextRequestId(1)
+    , m_transcoded(0)
+    , m_cancelledJobs(0)
+{
+    // Transcoding a large GIF takes seconds of CPU; one thread in the
+    // background is plenty since every strip is only made once
+    m_pool.setMaxThreadCount(1);
+    m_pool.setExpiryTimeout(10000);
+    
+    // Make sure the cache outlives the pool during static destruction
+    ThumbnailCache::instance();
+}
+
+AnimatedPreviewCache::~AnimatedPreviewCache()
+{
+    m_pool.clear();
+    m_pool.waitForDone();
+}
+
+AnimatedPreviewCache& AnimatedPreviewCache::instance()
+{
+    static AnimatedPreviewCache instance;
+    return instance;
+}
+
+QString AnimatedPreviewCache::stripPath(const QString& key)
+{
+    return QDir(ThumbnailCache::instance().directory()).filePath(key + ".strip");
+}
+
+quint64 AnimatedPreviewCache::load(const QString& path, const QSize& size, QObject* context, Callback callback)
+{
+    if (!callback) {
+        return 0;
+    }
+    
+    QString key = ThumbnailCache::cacheKey(path, size);
+    if (key.isEmpty() || size.isEmpty()) {
+        callback(nullptr);
+        return 0;
+    }
+    
+    quint64 requestId = m_nextRequestId++;
+    m_requestKeys.insert(requestId, key);
+    
+    // Someone else is already waiting for this strip
+    auto pending = m_pending.find(key);
+    if (pending != m_pending.end()) {
+        pending->waiters.append(Waiter{ requestId, QPointer<QObject>(context), std::move(callback) });
+        return requestId;
+    }
+    auto cancelled = std::make_shared<std::atomic<bool>>(false);
+    m_pending.insert(key, Job{ cancelled, { Waiter{ requestId, QPointer<QObject>(context), std::move(callback) } } });
+    
+    m_pool.start([this, key, path, size, cancelled]() {
+        // Strips for rows that went away while queued cost nothing
+        if (cancelled->load()) {
+            return;
+        }
+        QThread::currentThread()->setPriority(QThread::LowPriority);
+        
+        ThumbnailCache& cache = ThumbnailCache::instance();
+        QString file = stripPath(key);
+        StripPtr strip = cache.isEnabled() ? read(file) : nullptr;
+        bool transcoded = false;
+        if (strip) {
+            cache.touch(file);
+        } else {
+            strip = transcode(path, size, cancelled.get());
+            transcoded = true;
+            if (cancelled->load()) {
+                return;
+            }
+            if (strip && cache.isEnabled() && write(file, *strip)) {
+                cache.entryWritten(QFileInfo(file).size());
+            }
+        }
+        
+        QMetaObject::invokeMethod(this, [this, key, cancelled, strip, transcoded]() {
+            deliver(key, cancelled, strip, transcoded);
+        }, Qt::QueuedConnection);
+    });
+    return requestId;
+}
+
+void AnimatedPreviewCache::cancel(quint64 requestId)
+{
+    QString key = m_requestKeys.take(requestId);
+    auto pending = m_pending.find(key);
+    if (key.isEmpty() || pending == m_pending.end()) {
+        return;
+    }
+    
+    QList<Waiter>& waiters = pending->waiters;
+    waiters.erase(std::remove_if(waiters.begin(), waiters.end(), [requestId](const Waiter& waiter) {
+        return waiter.requestId == requestId;
+    }), waiters.end());
+    
+    // A later request for the same strip starts a job of its own
+    if (waiters.isEmpty()) {
+        pending->cancelled->store(true);
+        m_pending.erase(pending);
+        ++m_cancelledJobs;
+    }
+}
+
+void AnimatedPreviewCache::deliver(const QString& key, const std::shared_ptr<std::atomic<bool>>& cancelled,
+                                   StripPtr strip, bool transcoded)
+{
+    // Cancelled after it finished, and perhaps requested again since
+    auto pending = m_pending.find(key);
+    if (pending == m_pending.end() || pending->cancelled != cancelled) {
+        return;
+    }
+    
+    QList<Waiter> waiters = pending->waiters;
+    m_pending.erase(pending);
+    for (const Waiter& waiter : waiters) {
+        m_requestKeys.remove(waiter.requestId);
+    }
+    
+    if (strip && transcoded) {
+        ++m_transcoded;
+    }
+    
+    for (const Waiter& waiter : waiters) {
+        if (waiter.context) {
+            waiter.callback(strip);
+        }
+    }
+}
+
+AnimatedPreviewCache::StripPtr AnimatedPreviewCache::transcode(const QString& path, const QSize& size,
+                                                               const std::atomic<bool>* cancelled)
+{
+    QImageReader reader(path);
+    if (!reader.canRead()) {
+        qCDebug(animatedPreviewCache) << "Cannot read animated preview" << path << reader.errorString();
+        return nullptr;
+    }
+    
+    // Never decode more pixels than shown; handlers that can't decode scaled
+    // still hand back frames at this size
+    QSize sourceSize = reader.size();
+    if (sourceSize.isValid() &&
+        (sourceSize.width() > size.width() || sourceSize.height() > size.height())) {
+        reader.setScaledSize(sourceSize.scaled(size, Qt::KeepAspectRatio));
+    }
+    
+    auto strip = std::make_shared<AnimatedPreviewStrip>();
+    while (strip->frameCount() < MAX_FRAMES) {
+        if (cancelled && cancelled->load()) {
+            return nullptr;
+        }
+        
+        QImage frame = reader.read();
+        if (frame.isNull()) {
+            break;
+        }
+        
+        QByteArray encoded;
+        QBuffer buffer(&encoded);
+        buffer.open(QIODevice::WriteOnly);
+        bool opaque = isOpaque(frame);
+        if (!frame.save(&buffer, opaque ? "JPG" : "PNG", opaque ? JPEG_QUALITY : -1)) {
+            break;
+        }
+        
+        int delay = reader.nextImageDelay();
+        strip->frameSize = frame.size();
+        strip->delays.append(delay > 0 ? delay : DEFAULT_FRAME_DELAY);
+        strip->frames.append(encoded);
+    }
+    
+    if (strip->frames.isEmpty()) {
+        qCDebug(animatedPreviewCache) << "No frames in animated preview" << path << reader.errorString();
+        return nullptr;
+    }
+    
+    qCDebug(animatedPreviewCache) << "Transcoded" << path << "to" << strip->frameCount()
+                                  << "frames of" << strip->frameSize;
+    return strip;
+}
+
+AnimatedPreviewCache::StripPtr AnimatedPreviewCache::read(const QString& file)
+{
+    QFile input(file);
+    if (!input.open(QIODevice::ReadOnly)) {
+        return nullptr;
+    }
+    
+    QDataStream stream(&input);
+    stream.setVersion(QDataStream::Qt_6_0);
+    quint32 magic = 0;
+    quint16 version = 0;
+    stream >> magic >> version;
+    if (magic != STRIP_MAGIC || version != STRIP_VERSION) {
+        qCWarning(animatedPreviewCache) << "Removing strip in unknown format" << file;
+        input.remove();
+        return nullptr;
+    }
+    
+    auto strip = std::make_shared<AnimatedPreviewStrip>();
+    stream >> strip->frameSize >> strip->delays >> strip->frames;
+    if (stream.status() != QDataStream::Ok || strip->frames.isEmpty() ||
+        strip->frames.size() != strip->delays.size()) {
+        // Truncated or otherwise unreadable entry; drop it and transcode again
+        qCWarning(animatedPreviewCache) << "Removing unreadable strip" << file;
+        input.remove();
+        return nullptr;
+    }
+    return strip;
+}
+
+bool AnimatedPreviewCache::write(const QString& file, const AnimatedPreviewStrip& strip)
+{
+    QSaveFile output(file);
+    if (!output.open(QIODevice::WriteOnly)) {
+        qCWarning(animatedPreviewCache) << "Failed to write strip" << file << output.errorString();
+        return false;
+    }
+    
+    QDataStream stream(&output);
+    stream.setVersion(QDataStream::Qt_6_0);
+    stream << STRIP_MAGIC << STRIP_VERSION << strip.frameSize << strip.delays << strip.frames;
+    if (stream.status() != QDataStream::Ok || !output.commit()) {
+        qCWarning(animatedPreviewCache) << "Failed to write strip" << file << output.errorString();
+        return false;
+    }
+    return true;
+}
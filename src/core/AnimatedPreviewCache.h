@@ -0,0 +1,96 @@
+#ifndef ANIMATEDPREVIEWCACHE_H
+#define ANIMATEDPREVIEWCACHE_H
+
+#include <QObject>
+#include <QByteArray>
+#include <QVector>
+#include <QHash>
+#include <QPointer>
+#include <QSize>
+#include <QString>
+#include <QThreadPool>
+#include <functional>
+#include <memory>
+#include <atomic>
+
+// Animated preview transcoded once to the size it is shown at: every frame is
+// stored as a small JPEG (PNG where it has transparency) next to its delay.
+// Frames are decoded one at a time while playing, so a strip costs a few
+// hundred KB in memory however large the source GIF is.
+struct AnimatedPreviewStrip
+{
+    QSize frameSize;
+    QVector<int> delays;        // ms per frame
+    QVector<QByteArray> frames; // encoded frames
+    
+    int frameCount() const { return frames.size(); }
+};
+
+// Converts animated previews (GIF, animated WebP) into frame strips on a low
+// priority background thread and keeps them in the thumbnail cache directory,
+// where they share its size limit. Later sessions read the strip instead of
+// decoding the original file again. Callbacks run on the GUI thread. A job
+// nobody waits for any more stops before decoding, or between frames, so
+// strips for rows scrolled away don't hold up the ones on screen.
+class AnimatedPreviewCache : public QObject
+{
+    Q_OBJECT
+
+public:
+    using StripPtr = std::shared_ptr<const AnimatedPreviewStrip>;
+    using Callback = std::function<void(StripPtr strip)>;
+    
+    static AnimatedPreviewCache& instance();
+    
+    // Reads the strip for path at size, transcoding it first on a miss. The
+    // callback gets null if the file can't be decoded; it is dropped if context
+    // is destroyed first. Concurrent requests for the same strip share one job.
+    // Returns a request id for cancel(), or 0 if the callback already ran
+    quint64 load(const QString& path, const QSize& size, QObject* context, Callback callback);
+    // Drops the request's callback; the job stops once no request is left
+    void cancel(quint64 requestId);
+    
+    // Transcodes without decoding; any thread, no caching. Gives up with null
+    // once cancelled is set
+    static StripPtr transcode(const QString& path, const QSize& size,
+                              const std::atomic<bool>* cancelled = nullptr);
+    
+    int pendingJobs() const { return m_pending.size(); }
+    quint64 transcodedStrips() const { return m_transcoded; }
+    quint64 cancelledJobs() const { return m_cancelledJobs; }
+    
+    // Long animations are cut here to keep strips small
+    static constexpr int MAX_FRAMES = 300;
+
+private:
+    AnimatedPreviewCache();
+    ~AnimatedPreviewCache();
+    AnimatedPreviewCache(const AnimatedPreviewCache&) = delete;
+    AnimatedPreviewCache& operator=(const AnimatedPreviewCache&) = delete;
+    
+    struct Waiter {
+        quint64 requestId = 0;
+        QPointer<QObject> context;
+        Callback callback;
+    };
+    
+    struct Job {
+        std::shared_ptr<std::atomic<bool>> cancelled;
+        QList<Waiter> waiters;
+    };
+    
+    void deliver(const QString& key, const std::shared_ptr<std::atomic<bool>>& cancelled,
+                 StripPtr strip, bool transcoded);
+    static QString stripPath(const QString& key);
+    static StripPtr read(const QString& file);
+    static bool write(const QString& file, const AnimatedPreviewStrip& strip);
+    
+    QThreadPool m_pool;
+    QHash<QString, Job> m_pending;              // GUI thread only
+    QHash<quint64, QString> m_requestKeys;      // request id -> strip key
+    quint64 m_nextRequestId;
+    quint64 m_transcoded;
+    quint64 m_cancelledJobs;
+};
+
+#endif // ANIMATEDPREVIEWCACHE_H
@@ -656,6 +656,262 @@ void ConfigManager::setWNELBinaryPath(const QString& path)
     m_settings->sync();
 }
 
+// Power profile settings
+bool ConfigManager::batteryProfileEnabled() const
+{
+    return m_settings->value("power/battery_profile_enabled", false).toBool();
+}
+
+void ConfigManager::setBatteryProfileEnabled(bool enabled)
+{
+    m_settings->setValue("power/battery_profile_enabled", enabled);
+    m_settings->sync();
+}
+
+QString ConfigManager::batteryAction() const
+{
+    return m_settings->value("power/battery_action", "reduce").toString();
+}
+
+void ConfigManager::setBatteryAction(const QString& action)
+{
+    m_settings->setValue("power/battery_action", action);
+    m_settings->sync();
+}
+
+int ConfigManager::batteryFps() const
+{
+    return m_settings->value("power/battery_fps", 15).toInt();
+}
+
+void ConfigManager::setBatteryFps(int fps)
+{
+    m_settings->setValue("power/battery_fps", fps);
+    m_settings->sync();
+}
+
+bool ConfigManager::batterySilent() const
+{
+    return m_settings->value("power/battery_silent", true).toBool();
+}
+
+void ConfigManager::setBatterySilent(bool silent)
+{
+    m_settings->setValue("power/battery_silent", silent);
+    m_settings->sync();
+}
+
+QString ConfigManager::powerSupplySysfsRoot() const
+{
+    return m_settings->value("power/sysfs_root", "/sys/class/power_supply").toString();
+}
+
+void ConfigManager::setPowerSupplySysfsRoot(const QString& path)
+{
+    m_settings->setValue("power/sysfs_root", path);
+    m_settings->sync();
+}
+
+int ConfigManager::powerPollInterval() const
+{
+    return m_settings->value("power/poll_interval", 10).toInt();
+}
+
+void ConfigManager::setPowerPollInterval(int seconds)
+{
+    m_settings->setValue("power/poll_interval", seconds);
+    m_settings->sync();
+}
+
+// Renderer output settings
+QString ConfigManager::outputCaptureMode() const
+{
+    return m_settings->value("output/capture_mode", "full").toString();
+}
+
+void ConfigManager::setOutputCaptureMode(const QString& mode)
+{
+    m_settings->setValue("output/capture_mode", mode);
+    m_settings->sync();
+}
+
+int ConfigManager::outputLogLines() const
+{
+    return m_settings->value("output/log_lines", 10000).toInt();
+}
+
+void ConfigManager::setOutputLogLines(int lines)
+{
+    m_settings->setValue("output/log_lines", lines);
+    m_settings->sync();
+}
+
+bool ConfigManager::outputCollapseRepeats() const
+{
+    return m_settings->value("output/collapse_repeats", true).toBool();
+}
+
+void ConfigManager::setOutputCollapseRepeats(bool collapse)
+{
+    m_settings->setValue("output/collapse_repeats", collapse);
+    m_settings->sync();
+}
+
+int ConfigManager::outputLineBudget() const
+{
+    return m_settings->value("output/line_budget", 200).toInt();
+}
+
+void ConfigManager::setOutputLineBudget(int linesPerSecond)
+{
+    m_settings->setValue("output/line_budget", linesPerSecond);
+    m_settings->sync();
+}
+
+bool ConfigManager::outputFileLogging() const
+{
+    return m_settings->value("output/file_logging", true).toBool();
+}
+
+void ConfigManager::setOutputFileLogging(bool enabled)
+{
+    m_settings->setValue("output/file_logging", enabled);
+    m_settings->sync();
+}
+
+QString ConfigManager::outputLogDirectory() const
+{
+    return m_settings->value("output/log_directory", "").toString();
+}
+
+void ConfigManager::setOutputLogDirectory(const QString& path)
+{
+    m_settings->setValue("output/log_directory", path);
+    m_settings->sync();
+}
+
+int ConfigManager::outputLogFileSizeKb() const
+{
+    return m_settings->value("output/file_size_kb", 5120).toInt();
+}
+
+void ConfigManager::setOutputLogFileSizeKb(int sizeKb)
+{
+    m_settings->setValue("output/file_size_kb", sizeKb);
+    m_settings->sync();
+}
+
+int ConfigManager::outputLogFileCount() const
+{
+    return m_settings->value("output/file_count", 5).toInt();
+}
+
+void ConfigManager::setOutputLogFileCount(int count)
+{
+    m_settings->setValue("output/file_count", count);
+    m_settings->sync();
+}
+
+bool ConfigManager::outputCompressRotatedLogs() const
+{
+    return m_settings->value("output/compress_rotated", false).toBool();
+}
+
+void ConfigManager::setOutputCompressRotatedLogs(bool compress)
+{
+    m_settings->setValue("output/compress_rotated", compress);
+    m_settings->sync();
+}
+
+// Preview settings
+bool ConfigManager::thumbnailCacheEnabled() const
+{
+    return m_settings->value("previews/thumbnail_cache", true).toBool();
+}
+
+void ConfigManager::setThumbnailCacheEnabled(bool enabled)
+{
+    m_settings->setValue("previews/thumbnail_cache", enabled);
+    m_settings->sync();
+}
+
+int ConfigManager::thumbnailCacheSizeMb() const
+{
+    return m_settings->value("previews/thumbnail_cache_mb", 256).toInt();
+}
+
+void ConfigManager::setThumbnailCacheSizeMb(int sizeMb)
+{
+    m_settings->setValue("previews/thumbnail_cache_mb", sizeMb);
+    m_settings->sync();
+}
+
+int ConfigManager::previewMemoryBudgetMb() const
+{
+    return m_settings->value("previews/memory_budget_mb", 128).toInt();
+}
+
+void ConfigManager::setPreviewMemoryBudgetMb(int sizeMb)
+{
+    m_settings->setValue("previews/memory_budget_mb", sizeMb);
+    m_settings->sync();
+}
+
+int ConfigManager::previewAnimationFrameBudget() const
+{
+    return m_settings->value("previews/animation_frame_budget", 120).toInt();
+}
+
+void ConfigManager::setPreviewAnimationFrameBudget(int framesPerSecond)
+{
+    m_settings->setValue("previews/animation_frame_budget", framesPerSecond);
+    m_settings->sync();
+}
+
+bool ConfigManager::previewPrefetchEnabled() const
+{
+    return m_settings->value("previews/prefetch_enabled", true).toBool();
+}
+
+void ConfigManager::setPreviewPrefetchEnabled(bool enabled)
+{
+    m_settings->setValue("previews/prefetch_enabled", enabled);
+    m_settings->sync();
+}
+
+QString ConfigManager::previewAnimationPolicy() const
+{
+    return m_settings->value("previews/animation_policy", "always").toString();
+}
+
+void ConfigManager::setPreviewAnimationPolicy(const QString& policy)
+{
+    m_settings->setValue("previews/animation_policy", policy);
+    m_settings->sync();
+}
+
+int ConfigManager::previewAnimationLimit() const
+{
+    return m_settings->value("previews/animation_limit", 12).toInt();
+}
+
+void ConfigManager::setPreviewAnimationLimit(int limit)
+{
+    m_settings->setValue("previews/animation_limit", limit);
+    m_settings->sync();
+}
+
+QString ConfigManager::librarySortOrder() const
+{
+    return m_settings->value("ui/library_sort_order", "default").toString();
+}
+
+void ConfigManager::setLibrarySortOrder(const QString& order)
+{
+    m_settings->setValue("ui/library_sort_order", order);
+    m_settings->sync();
+}
+
 // Generic settings access for custom configuration values
 QVariant ConfigManager::value(const QString& key, const QVariant& defaultValue) const
 {
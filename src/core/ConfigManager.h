@@ -149,6 +149,58 @@ public:
     QString wnelBinaryPath() const;
     void setWNELBinaryPath(const QString& path);
     
+    // Power profile settings
+    bool batteryProfileEnabled() const;
+    void setBatteryProfileEnabled(bool enabled);
+    QString batteryAction() const;
+    void setBatteryAction(const QString& action);
+    int batteryFps() const;
+    void setBatteryFps(int fps);
+    bool batterySilent() const;
+    void setBatterySilent(bool silent);
+    QString powerSupplySysfsRoot() const;
+    void setPowerSupplySysfsRoot(const QString& path);
+    int powerPollInterval() const;
+    void setPowerPollInterval(int seconds);
+    
+    // Renderer output settings
+    QString outputCaptureMode() const;
+    void setOutputCaptureMode(const QString& mode);
+    int outputLogLines() const;
+    void setOutputLogLines(int lines);
+    bool outputCollapseRepeats() const;
+    void setOutputCollapseRepeats(bool collapse);
+    int outputLineBudget() const;
+    void setOutputLineBudget(int linesPerSecond);
+    bool outputFileLogging() const;
+    void setOutputFileLogging(bool enabled);
+    QString outputLogDirectory() const;
+    void setOutputLogDirectory(const QString& path);
+    int outputLogFileSizeKb() const;
+    void setOutputLogFileSizeKb(int sizeKb);
+    int outputLogFileCount() const;
+    void setOutputLogFileCount(int count);
+    bool outputCompressRotatedLogs() const;
+    void setOutputCompressRotatedLogs(bool compress);
+    
+    // Preview settings
+    bool thumbnailCacheEnabled() const;
+    void setThumbnailCacheEnabled(bool enabled);
+    int thumbnailCacheSizeMb() const;
+    void setThumbnailCacheSizeMb(int sizeMb);
+    int previewMemoryBudgetMb() const;
+    void setPreviewMemoryBudgetMb(int sizeMb);
+    int previewAnimationFrameBudget() const;
+    void setPreviewAnimationFrameBudget(int framesPerSecond);
+    bool previewPrefetchEnabled() const;
+    void setPreviewPrefetchEnabled(bool enabled);
+    QString previewAnimationPolicy() const;
+    void setPreviewAnimationPolicy(const QString& policy);
+    int previewAnimationLimit() const;
+    void setPreviewAnimationLimit(int limit);
+    QString librarySortOrder() const;
+    void setLibrarySortOrder(const QString& order);
+    
     // Generic settings access for custom configuration values
     QVariant value(const QString& key, const QVariant& defaultValue = QVariant()) const;
     void setValue(const QString& key, const QVariant& value);
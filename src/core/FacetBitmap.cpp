@@ -0,0 +1,345 @@
+#include "FacetBitmap.h"
+#include <algorithm>
+#include <iterator>
+
+bool FacetBitmap::Container::contains(quint16 value) const
+{
+    if (isBitmap()) {
+        return (words.at(value >> 6) >> (value & 63)) & 1;
+    }
+    return std::binary_search(values.constBegin(), values.constEnd(), value);
+}
+
+FacetBitmap::Container FacetBitmap::fromWords(quint16 key, QVector<quint64> words)
+{
+    Container container;
+    container.key = key;
+    for (quint64 word : words) {
+        container.cardinality += qPopulationCount(word);
+    }
+    
+    if (container.cardinality > ARRAY_MAX) {
+        container.words = std::move(words);
+        return container;
+    }
+    
+    // Small enough for the array form again
+    container.values.reserve(container.cardinality);
+    for (int i = 0; i < words.size(); ++i) {
+        for (quint64 word = words.at(i); word; word &= word - 1) {
+            container.values.append(quint16(i * 64 + qCountTrailingZeroBits(word)));
+        }
+    }
+    return container;
+}
+
+FacetBitmap::Container FacetBitmap::fromValues(quint16 key, QVector<quint16> values)
+{
+    if (values.size() > ARRAY_MAX) {
+        QVector<quint64> words(BITMAP_WORDS, 0);
+        for (quint16 value : values) {
+            words[value >> 6] |= quint64(1) << (value & 63);
+        }
+        return fromWords(key, std::move(words));
+    }
+    
+    Container container;
+    container.key = key;
+    container.cardinality = values.size();
+    container.values = std::move(values);
+    return container;
+}
+
+QVector<quint64> FacetBitmap::toWords(const Container& container)
+{
+    if (container.isBitmap()) {
+        return container.words;
+    }
+    
+    QVector<quint64> words(BITMAP_WORDS, 0);
+    for (quint16 value : container.values) {
+        words[value >> 6] |= quint64(1) << (value & 63);
+    }
+    return words;
+}
+
+FacetBitmap FacetBitmap::fromRows(const QVector<int>& rows)
+{
+    FacetBitmap bitmap;
+    for (int row : rows) {
+        bitmap.append(row);
+    }
+    return bitmap;
+}
+
+FacetBitmap FacetBitmap::range(int count)
+{
+    FacetBitmap bitmap;
+    for (int start = 0; start < count; start += 65536) {
+        int length = qMin(count - start, 65536);
+        QVector<quint64> words(BITMAP_WORDS, 0);
+        std::fill(words.begin(), words.begin() + length / 64, ~quint64(0));
+        if (length % 64) {
+            words[length / 64] = (quint64(1) << (length % 64)) - 1;
+        }
+        bitmap.m_containers.append(fromWords(quint16(start >> 16), std::move(words)));
+    }
+    return bitmap;
+}
+
+void FacetBitmap::append(int row)
+{
+    quint16 key = quint16(quint32(row) >> 16);
+    quint16 value = quint16(row & 0xffff);
+    
+    if (m_containers.isEmpty() || m_containers.last().key != key) {
+        Container container;
+        container.key = key;
+        m_containers.append(container);
+    }
+    
+    Container& container = m_containers.last();
+    if (container.isBitmap()) {
+        container.words[value >> 6] |= quint64(1) << (value & 63);
+        ++container.cardinality;
+        return;
+    }
+    
+    container.values.append(value);
+    ++container.cardinality;
+    if (container.cardinality > ARRAY_MAX) {
+        container = fromValues(key, std::move(container.values));
+    }
+}
+
+bool FacetBitmap::contains(int row) const
+{
+    quint16 key = quint16(quint32(row) >> 16);
+    auto it = std::lower_bound(m_containers.constBegin(), m_containers.constEnd(), key,
+                               [](const Container& container, quint16 key) { return container.key < key; });
+    return it != m_containers.constEnd() && it->key == key && it->contains(quint16(row & 0xffff));
+}
+
+int FacetBitmap::count() const
+{
+    int total = 0;
+    for (const Container& container : m_containers) {
+        total += container.cardinality;
+    }
+    return total;
+}
+
+QVector<int> FacetBitmap::rows() const
+{
+    QVector<int> rows;
+    rows.reserve(count());
+    for (const Container& container : m_containers) {
+        int base = int(container.key) << 16;
+        if (!container.isBitmap()) {
+            for (quint16 value : container.values) {
+                rows.append(base + value);
+            }
+            continue;
+        }
+        for (int i = 0; i < BITMAP_WORDS; ++i) {
+            for (quint64 word = container.words.at(i); word; word &= word - 1) {
+                rows.append(base + i * 64 + qCountTrailingZeroBits(word));
+            }
+        }
+    }
+    return rows;
+}
+
+FacetBitmap::Container FacetBitmap::intersect(const Container& a, const Container& b)
+{
+    if (a.isBitmap() && b.isBitmap()) {
+        QVector<quint64> words(BITMAP_WORDS);
+        for (int i = 0; i < BITMAP_WORDS; ++i) {
+            words[i] = a.words.at(i) & b.words.at(i);
+        }
+        return fromWords(a.key, std::move(words));
+    }
+    
+    // An array result can only shrink, so it never needs converting
+    QVector<quint16> values;
+    if (a.isBitmap() || b.isBitmap()) {
+        const Container& array = a.isBitmap() ? b : a;
+        const Container& bitmap = a.isBitmap() ? a : b;
+        for (quint16 value : array.values) {
+            if (bitmap.contains(value)) {
+                values.append(value);
+            }
+        }
+    } else {
+        std::set_intersection(a.values.constBegin(), a.values.constEnd(),
+                              b.values.constBegin(), b.values.constEnd(), std::back_inserter(values));
+    }
+    return fromValues(a.key, std::move(values));
+}
+
+FacetBitmap::Container FacetBitmap::unite(const Container& a, const Container& b)
+{
+    if (a.isBitmap() || b.isBitmap() || a.cardinality + b.cardinality > ARRAY_MAX) {
+        QVector<quint64> words = toWords(a.isBitmap() ? a : b);
+        const Container& other = a.isBitmap() ? b : a;
+        if (other.isBitmap()) {
+            for (int i = 0; i < BITMAP_WORDS; ++i) {
+                words[i] |= other.words.at(i);
+            }
+        } else {
+            for (quint16 value : other.values) {
+                words[value >> 6] |= quint64(1) << (value & 63);
+            }
+        }
+        return fromWords(a.key, std::move(words));
+    }
+    
+    QVector<quint16> values;
+    values.reserve(a.cardinality + b.cardinality);
+    std::set_union(a.values.constBegin(), a.values.constEnd(),
+                   b.values.constBegin(), b.values.constEnd(), std::back_inserter(values));
+    return fromValues(a.key, std::move(values));
+}
+
+FacetBitmap::Container FacetBitmap::subtract(const Container& a, const Container& b)
+{
+    if (a.isBitmap()) {
+        QVector<quint64> words = a.words;
+        if (b.isBitmap()) {
+            for (int i = 0; i < BITMAP_WORDS; ++i) {
+                words[i] &= ~b.words.at(i);
+            }
+        } else {
+            for (quint16 value : b.values) {
+                words[value >> 6] &= ~(quint64(1) << (value & 63));
+            }
+        }
+        return fromWords(a.key, std::move(words));
+    }
+    
+    QVector<quint16> values;
+    if (b.isBitmap()) {
+        for (quint16 value : a.values) {
+            if (!b.contains(value)) {
+                values.append(value);
+            }
+        }
+    } else {
+        std::set_difference(a.values.constBegin(), a.values.constEnd(),
+                            b.values.constBegin(), b.values.constEnd(), std::back_inserter(values));
+    }
+    return fromValues(a.key, std::move(values));
+}
+
+int FacetBitmap::intersectionCount(const Container& a, const Container& b)
+{
+    if (a.isBitmap() && b.isBitmap()) {
+        int total = 0;
+        for (int i = 0; i < BITMAP_WORDS; ++i) {
+            total += qPopulationCount(a.words.at(i) & b.words.at(i));
+        }
+        return total;
+    }
+    
+    if (a.isBitmap() || b.isBitmap()) {
+        const Container& array = a.isBitmap() ? b : a;
+        const Container& bitmap = a.isBitmap() ? a : b;
+        int total = 0;
+        for (quint16 value : array.values) {
+            total += bitmap.contains(value);
+        }
+        return total;
+    }
+    
+    int total = 0;
+    auto x = a.values.constBegin();
+    auto y = b.values.constBegin();
+    while (x != a.values.constEnd() && y != b.values.constEnd()) {
+        if (*x < *y) {
+            ++x;
+        } else if (*y < *x) {
+            ++y;
+        } else {
+            ++total;
+            ++x;
+            ++y;
+        }
+    }
+    return total;
+}
+
+FacetBitmap FacetBitmap::operator&(const FacetBitmap& other) const
+{
+    FacetBitmap result;
+    auto x = m_containers.constBegin();
+    auto y = other.m_containers.constBegin();
+    while (x != m_containers.constEnd() && y != other.m_containers.constEnd()) {
+        if (x->key < y->key) {
+            ++x;
+        } else if (y->key < x->key) {
+            ++y;
+        } else {
+            Container container = intersect(*x, *y);
+            if (container.cardinality > 0) {
+                result.m_containers.append(std::move(container));
+            }
+            ++x;
+            ++y;
+        }
+    }
+    return result;
+}
+
+FacetBitmap FacetBitmap::operator|(const FacetBitmap& other) const
+{
+    FacetBitmap result;
+    auto x = m_containers.constBegin();
+    auto y = other.m_containers.constBegin();
+    while (x != m_containers.constEnd() || y != other.m_containers.constEnd()) {
+        if (y == other.m_containers.constEnd() || (x != m_containers.constEnd() && x->key < y->key)) {
+            result.m_containers.append(*x++);
+        } else if (x == m_containers.constEnd() || y->key < x->key) {
+            result.m_containers.append(*y++);
+        } else {
+            result.m_containers.append(unite(*x++, *y++));
+        }
+    }
+    return result;
+}
+
+FacetBitmap FacetBitmap::andNot(const FacetBitmap& other) const
+{
+    FacetBitmap result;
+    auto y = other.m_containers.constBegin();
+    for (const Container& container : m_containers) {
+        while (y != other.m_containers.constEnd() && y->key < container.key) {
+            ++y;
+        }
+        if (y == other.m_containers.constEnd() || y->key != container.key) {
+            result.m_containers.append(container);
+            continue;
+        }
+        Container difference = subtract(container, *y);
+        if (difference.cardinality > 0) {
+            result.m_containers.append(std::move(difference));
+        }
+    }
+    return result;
+}
+
+int FacetBitmap::intersectionCount(const FacetBitmap& other) const
+{
+    int total = 0;
+    auto x = m_containers.constBegin();
+    auto y = other.m_containers.constBegin();
+    while (x != m_containers.constEnd() && y != other.m_containers.constEnd()) {
+        if (x->key < y->key) {
+            ++x;
+        } else if (y->key < x->key) {
+            ++y;
+        } else {
+            total += intersectionCount(*x++, *y++);
+        }
+    }
+    return total;
+}
@@ -0,0 +1,64 @@
+#ifndef FACETBITMAP_H
+#define FACETBITMAP_H
+
+#include <QVector>
+#include <QtGlobal>
+
+// Compressed set of catalog rows, laid out like a roaring bitmap. Rows are
+// split by their high 16 bits into containers. A container with few rows is
+// a sorted array of the low 16 bits; one with more than ARRAY_MAX rows is a
+// plain 65536 bit bitmap, which is then the smaller of the two. Rare tags
+// stay a few bytes, common ones a fixed 8 KiB per 65536 rows, and AND, OR
+// and counts work container by container without expanding anything.
+class FacetBitmap
+{
+public:
+    FacetBitmap() = default;
+    
+    // rows must be ascending
+    static FacetBitmap fromRows(const QVector<int>& rows);
+    // Rows 0 to count - 1
+    static FacetBitmap range(int count);
+    
+    // Appends a row greater than any already present
+    void append(int row);
+    
+    bool contains(int row) const;
+    bool isEmpty() const { return m_containers.isEmpty(); }
+    int count() const;
+    // Ascending
+    QVector<int> rows() const;
+    
+    FacetBitmap operator&(const FacetBitmap& other) const;
+    FacetBitmap operator|(const FacetBitmap& other) const;
+    FacetBitmap andNot(const FacetBitmap& other) const;
+    // Same as (*this & other).count(), without building the result
+    int intersectionCount(const FacetBitmap& other) const;
+    
+    static constexpr int ARRAY_MAX = 4096;
+    static constexpr int BITMAP_WORDS = 65536 / 64;
+
+private:
+    struct Container {
+        quint16 key = 0;                // high 16 bits of the rows
+        int cardinality = 0;
+        QVector<quint16> values;        // array form, ascending
+        QVector<quint64> words;         // bitmap form, BITMAP_WORDS long
+        
+        bool isBitmap() const { return !words.isEmpty(); }
+        bool contains(quint16 value) const;
+    };
+    
+    static Container fromWords(quint16 key, QVector<quint64> words);
+    static Container fromValues(quint16 key, QVector<quint16> values);
+    static QVector<quint64> toWords(const Container& container);
+    
+    static Container intersect(const Container& a, const Container& b);
+    static Container unite(const Container& a, const Container& b);
+    static Container subtract(const Container& a, const Container& b);
+    static int intersectionCount(const Container& a, const Container& b);
+    
+    QVector<Container> m_containers;    // ascending keys, none empty
+};
+
+#endif // FACETBITMAP_H
@@ -0,0 +1,320 @@
+#include "LaunchTimings.h"
+#include <QFile>
+#include <QFileInfo>
+#include <QDir>
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QDateTime>
+#include <QLoggingCategory>
+#include <unistd.h>
+
+Q_LOGGING_CATEGORY(launchTimings, "app.launchTimings")
+
+namespace {
+// Steady state detection: sample interval, allowed CPU drift between samples
+// (in percent of one core), number of consecutive calm samples and a timeout
+constexpr int STEADY_POLL_INTERVAL_MS = 250;
+constexpr double STEADY_CPU_DELTA_PERCENT = 5.0;
+constexpr int STEADY_REQUIRED_SAMPLES = 4;
+constexpr qint64 STEADY_TIMEOUT_MS = 30000;
+}
+
+void LaunchTimings::Histogram::add(qint64 ms)
+{
+    const QVector<qint64>& bounds = LaunchTimings::bucketBounds();
+    if (counts.size() != bounds.size() + 1) {
+        counts.fill(0, bounds.size() + 1);
+    }
+
+    int bucket = bounds.size();
+    for (int i = 0; i < bounds.size(); ++i) {
+        if (ms < bounds[i]) {
+            bucket = i;
+            break;
+        }
+    }
+
+    counts[bucket]++;
+    samples++;
+    totalMs += ms;
+    lastMs = ms;
+    maxMs = qMax(maxMs, ms);
+    minMs = (minMs < 0) ? ms : qMin(minMs, ms);
+}
+
+LaunchTimings::LaunchTimings(QObject* parent)
+    : QObject(parent)
+    , m_steadyStateTimer(new QTimer(this))
+{
+    m_steadyStateTimer->setInterval(STEADY_POLL_INTERVAL_MS);
+    connect(m_steadyStateTimer, &QTimer::timeout, this, &LaunchTimings::pollSteadyState);
+}
+
+LaunchTimings& LaunchTimings::instance()
+{
+    static LaunchTimings instance;
+    return instance;
+}
+
+QString LaunchTimings::phaseName(Phase phase)
+{
+    switch (phase) {
+    case Phase::OldProcessExited:
+        return "old_process_exited";
+    case Phase::ArgvBuilt:
+        return "argv_built";
+    case Phase::Spawned:
+        return "spawned";
+    case Phase::FirstOutput:
+        return "first_output";
+    case Phase::SteadyState:
+        return "steady_state";
+    }
+    return "unknown";
+}
+
+const QVector<qint64>& LaunchTimings::bucketBounds()
+{
+    // Upper bounds (exclusive) in milliseconds; the last bucket is open ended
+    static const QVector<qint64> bounds = { 10, 50, 100, 250, 500, 1000, 2000, 5000, 10000 };
+    return bounds;
+}
+
+void LaunchTimings::beginLaunch(const QString& wallpaperId, const QString& source, const QElapsedTimer& startedAt)
+{
+    ActiveLaunch launch;
+    launch.timer = startedAt;
+    launch.source = source;
+    m_active.insert(wallpaperId, launch);
+}
+
+void LaunchTimings::markPhase(const QString& wallpaperId, Phase phase)
+{
+    auto it = m_active.find(wallpaperId);
+    if (it == m_active.end() || it->reached.contains(phase)) {
+        return;
+    }
+
+    qint64 elapsed = it->timer.elapsed();
+    it->reached.append(phase);
+    m_histograms[wallpaperId][phase].add(elapsed);
+
+    qCDebug(launchTimings) << it->source << wallpaperId << phaseName(phase) << elapsed << "ms";
+
+    if (phase == Phase::SteadyState) {
+        m_active.erase(it);
+    }
+
+    emit timingsChanged(wallpaperId);
+}
+
+void LaunchTimings::abortLaunch(const QString& wallpaperId)
+{
+    if (m_active.remove(wallpaperId) > 0) {
+        qCDebug(launchTimings) << "Launch tracking stopped for" << wallpaperId;
+    }
+}
+
+void LaunchTimings::watchSteadyState(const QString& wallpaperId, qint64 pid)
+{
+    auto it = m_active.find(wallpaperId);
+    if (it == m_active.end() || pid <= 0) {
+        return;
+    }
+
+    it->pid = pid;
+    it->stableSamples = 0;
+    it->lastCpuPercent = -1.0;
+    it->lastSampleMs = it->timer.elapsed();
+    if (!readProcessCpuTicks(pid, it->lastCpuTicks)) {
+        qCDebug(launchTimings) << "CPU statistics unavailable for pid" << pid;
+        return;
+    }
+
+    if (!m_steadyStateTimer->isActive()) {
+        m_steadyStateTimer->start();
+    }
+}
+
+void LaunchTimings::pollSteadyState()
+{
+    static const double ticksPerSecond = static_cast<double>(sysconf(_SC_CLK_TCK));
+
+    QStringList settled;
+    QStringList expired;
+    bool anyWatching = false;
+
+    for (auto it = m_active.begin(); it != m_active.end(); ++it) {
+        ActiveLaunch& launch = it.value();
+        if (launch.pid <= 0) {
+            continue;
+        }
+
+        qint64 nowMs = launch.timer.elapsed();
+        if (nowMs > STEADY_TIMEOUT_MS) {
+            expired << it.key();
+            continue;
+        }
+
+        quint64 ticks = 0;
+        if (!readProcessCpuTicks(launch.pid, ticks)) {
+            expired << it.key();
+            continue;
+        }
+
+        anyWatching = true;
+
+        double seconds = (nowMs - launch.lastSampleMs) / 1000.0;
+        if (seconds <= 0.0) {
+            continue;
+        }
+
+        // CPU usage of the last interval, compared against the previous interval
+        double usage = ((ticks - launch.lastCpuTicks) / ticksPerSecond) / seconds * 100.0;
+        double previousUsage = launch.lastCpuPercent;
+        launch.lastCpuTicks = ticks;
+        launch.lastSampleMs = nowMs;
+        launch.lastCpuPercent = usage;
+
+        if (previousUsage >= 0.0 && qAbs(usage - previousUsage) < STEADY_CPU_DELTA_PERCENT) {
+            launch.stableSamples++;
+        } else {
+            launch.stableSamples = 0;
+        }
+
+        if (launch.stableSamples >= STEADY_REQUIRED_SAMPLES) {
+            settled << it.key();
+        }
+    }
+
+    for (const QString& wallpaperId : settled) {
+        markPhase(wallpaperId, Phase::SteadyState);
+    }
+
+    for (const QString& wallpaperId : expired) {
+        qCDebug(launchTimings) << "Steady state not reached for" << wallpaperId;
+        abortLaunch(wallpaperId);
+    }
+
+    if (!anyWatching || m_active.isEmpty()) {
+        m_steadyStateTimer->stop();
+    }
+}
+
+bool LaunchTimings::readProcessCpuTicks(qint64 pid, quint64& ticks)
+{
+    QFile statFile(QString("/proc/%1/stat").arg(pid));
+    if (!statFile.open(QIODevice::ReadOnly)) {
+        return false;
+    }
+
+    // The command name may contain spaces, so parse after the closing parenthesis.
+    // Fields after it start at "state" (field 3); utime and stime are fields 14 and 15.
+    QByteArray data = statFile.readAll();
+    int closeParen = data.lastIndexOf(')');
+    if (closeParen < 0) {
+        return false;
+    }
+
+    QList<QByteArray> fields = data.mid(closeParen + 2).split(' ');
+    if (fields.size() < 13) {
+        return false;
+    }
+
+    ticks = fields[11].toULongLong() + fields[12].toULongLong();
+    return true;
+}
+
+QStringList LaunchTimings::trackedWallpapers() const
+{
+    QStringList ids = m_histograms.keys();
+    ids.sort();
+    return ids;
+}
+
+QMap<LaunchTimings::Phase, LaunchTimings::Histogram> LaunchTimings::histograms(const QString& wallpaperId) const
+{
+    return m_histograms.value(wallpaperId);
+}
+
+void LaunchTimings::clear()
+{
+    m_histograms.clear();
+    emit timingsChanged(QString());
+}
+
+QJsonObject LaunchTimings::toJson() const
+{
+    QJsonArray bounds;
+    for (qint64 bound : bucketBounds()) {
+        bounds.append(bound);
+    }
+
+    QJsonObject wallpapers;
+    for (const QString& wallpaperId : trackedWallpapers()) {
+        QJsonObject phases;
+        const QMap<Phase, Histogram> phaseHistograms = m_histograms.value(wallpaperId);
+        for (auto it = phaseHistograms.constBegin(); it != phaseHistograms.constEnd(); ++it) {
+            const Histogram& histogram = it.value();
+            QJsonArray counts;
+            for (int count : histogram.counts) {
+                counts.append(count);
+            }
+
+            QJsonObject phaseObject;
+            phaseObject["samples"] = histogram.samples;
+            phaseObject["min_ms"] = histogram.minMs;
+            phaseObject["max_ms"] = histogram.maxMs;
+            phaseObject["avg_ms"] = histogram.averageMs();
+            phaseObject["last_ms"] = histogram.lastMs;
+            phaseObject["buckets"] = counts;
+            phases[phaseName(it.key())] = phaseObject;
+        }
+        wallpapers[wallpaperId] = phases;
+    }
+
+    QJsonObject root;
+    root["generated"] = QDateTime::currentDateTime().toString(Qt::ISODate);
+    root["origin"] = "stop_requested";
+    root["bucket_upper_bounds_ms"] = bounds;
+    root["wallpapers"] = wallpapers;
+    return root;
+}
+
+QString LaunchTimings::toText() const
+{
+    QStringList lines;
+    for (const QString& wallpaperId : trackedWallpapers()) {
+        lines << QString("Wallpaper %1").arg(wallpaperId);
+        const QMap<Phase, Histogram> phaseHistograms = m_histograms.value(wallpaperId);
+        for (auto it = phaseHistograms.constBegin(); it != phaseHistograms.constEnd(); ++it) {
+            const Histogram& histogram = it.value();
+            lines << QString("  %1: n=%2 last=%3ms avg=%4ms min=%5ms max=%6ms")
+                         .arg(phaseName(it.key()), -20)
+                         .arg(histogram.samples)
+                         .arg(histogram.lastMs)
+                         .arg(histogram.averageMs())
+                         .arg(histogram.minMs)
+                         .arg(histogram.maxMs);
+        }
+    }
+
+    if (lines.isEmpty()) {
+        return "No launches recorded yet.";
+    }
+    return lines.join("\n");
+}
+
+bool LaunchTimings::dumpToFile(const QString& filePath) const
+{
+    QDir().mkpath(QFileInfo(filePath).absolutePath());
+
+    QFile file(filePath);
+    if (!file.open(QIODevice::WriteOnly | QIODevice::Truncate)) {
+        qCWarning(launchTimings) << "Failed to write launch timings to" << filePath << file.errorString();
+        return false;
+    }
+
+    file.write(QJsonDocument(toJson()).toJson(QJsonDocument::Indented));
+    return true;
+}
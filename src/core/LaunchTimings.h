@@ -0,0 +1,95 @@
+#ifndef LAUNCHTIMINGS_H
+#define LAUNCHTIMINGS_H
+
+#include <QObject>
+#include <QString>
+#include <QStringList>
+#include <QHash>
+#include <QMap>
+#include <QVector>
+#include <QElapsedTimer>
+#include <QJsonObject>
+#include <QTimer>
+
+// Records how long each phase of a wallpaper launch takes and keeps
+// per-wallpaper latency histograms. All phases are measured from the moment
+// the launch asked the previous renderer to stop.
+class LaunchTimings : public QObject
+{
+    Q_OBJECT
+
+public:
+    enum class Phase {
+        OldProcessExited,   // previous renderer told to exit; the launch does not wait for it
+        ArgvBuilt,          // command line assembled
+        Spawned,            // QProcess reported started
+        FirstOutput,        // first byte on stdout/stderr
+        SteadyState         // renderer CPU usage settled
+    };
+
+    // Bucketed latency distribution for one phase (milliseconds since launch start)
+    struct Histogram {
+        QVector<int> counts;
+        int samples = 0;
+        qint64 minMs = -1;
+        qint64 maxMs = 0;
+        qint64 totalMs = 0;
+        qint64 lastMs = -1;
+
+        void add(qint64 ms);
+        qint64 averageMs() const { return samples > 0 ? totalMs / samples : 0; }
+    };
+
+    static LaunchTimings& instance();
+
+    static QString phaseName(Phase phase);
+    static const QVector<qint64>& bucketBounds();
+
+    // Launch tracking, keyed by wallpaper id. startedAt is the stop request.
+    void beginLaunch(const QString& wallpaperId, const QString& source, const QElapsedTimer& startedAt);
+    void markPhase(const QString& wallpaperId, Phase phase);
+    void abortLaunch(const QString& wallpaperId);
+
+    // Poll /proc/<pid>/stat until CPU usage of the renderer settles
+    void watchSteadyState(const QString& wallpaperId, qint64 pid);
+
+    // Histogram access
+    QStringList trackedWallpapers() const;
+    QMap<Phase, Histogram> histograms(const QString& wallpaperId) const;
+    void clear();
+
+    QJsonObject toJson() const;
+    QString toText() const;
+    bool dumpToFile(const QString& filePath) const;
+
+signals:
+    void timingsChanged(const QString& wallpaperId);
+
+private:
+    explicit LaunchTimings(QObject* parent = nullptr);
+    ~LaunchTimings() = default;
+
+    // Prevent copying
+    LaunchTimings(const LaunchTimings&) = delete;
+    LaunchTimings& operator=(const LaunchTimings&) = delete;
+
+    struct ActiveLaunch {
+        QElapsedTimer timer;
+        QString source;
+        qint64 pid = 0;
+        quint64 lastCpuTicks = 0;
+        qint64 lastSampleMs = 0;
+        double lastCpuPercent = -1.0;
+        int stableSamples = 0;
+        QList<Phase> reached;
+    };
+
+    void pollSteadyState();
+    static bool readProcessCpuTicks(qint64 pid, quint64& ticks);
+
+    QHash<QString, ActiveLaunch> m_active;
+    QHash<QString, QMap<Phase, Histogram>> m_histograms;
+    QTimer* m_steadyStateTimer;
+};
+
+#endif // LAUNCHTIMINGS_H
@@ -0,0 +1,139 @@
+#include "PowerProfileService.h"
+#include "ConfigManager.h"
+#include <QDir>
+#include <QFile>
+#include <QLoggingCategory>
+
+Q_LOGGING_CATEGORY(powerProfile, "app.powerProfile")
+
+namespace {
+QString readSysfsValue(const QString& path)
+{
+    QFile file(path);
+    if (!file.open(QIODevice::ReadOnly)) {
+        return QString();
+    }
+    return QString::fromUtf8(file.readAll()).trimmed();
+}
+}
+
+PowerProfileService::PowerProfileService(QObject* parent)
+    : QObject(parent)
+    , m_pollTimer(new QTimer(this))
+    , m_onBattery(false)
+    , m_stateKnown(false)
+{
+    connect(m_pollTimer, &QTimer::timeout, this, &PowerProfileService::poll);
+    reloadSettings();
+}
+
+PowerProfileService::~PowerProfileService()
+{
+}
+
+void PowerProfileService::start()
+{
+    poll();
+    m_pollTimer->start();
+}
+
+void PowerProfileService::stop()
+{
+    m_pollTimer->stop();
+}
+
+void PowerProfileService::reloadSettings()
+{
+    ConfigManager& config = ConfigManager::instance();
+    m_sysfsRoot = config.powerSupplySysfsRoot();
+    m_pollTimer->setInterval(qMax(1, config.powerPollInterval()) * 1000);
+}
+
+bool PowerProfileService::isBatteryProfileActive() const
+{
+    return m_onBattery && ConfigManager::instance().batteryProfileEnabled();
+}
+
+PowerProfileService::BatteryAction PowerProfileService::batteryAction() const
+{
+    return ConfigManager::instance().batteryAction() == "pause" ? BatteryAction::Pause : BatteryAction::Reduce;
+}
+
+void PowerProfileService::applyBatteryProfile(int& fps, bool& silent) const
+{
+    if (!isBatteryProfileActive() || batteryAction() != BatteryAction::Reduce) {
+        return;
+    }
+    
+    ConfigManager& config = ConfigManager::instance();
+    fps = qMin(fps, config.batteryFps());
+    if (config.batterySilent()) {
+        silent = true;
+    }
+}
+
+bool PowerProfileService::readPowerState(const QString& sysfsRoot, bool& onBattery)
+{
+    QDir root(sysfsRoot);
+    if (!root.exists()) {
+        return false;
+    }
+    
+    bool foundSupply = false;
+    bool externalOnline = false;
+    bool batteryDischarging = false;
+    
+    const QStringList supplies = root.entryList(QDir::Dirs | QDir::NoDotAndDotDot | QDir::System);
+    for (const QString& supply : supplies) {
+        QString supplyPath = root.filePath(supply);
+        QString type = readSysfsValue(supplyPath + "/type");
+        if (type.isEmpty()) {
+            continue;
+        }
+        
+        foundSupply = true;
+        if (type == "Battery") {
+            // Peripheral batteries (mice, headsets) report scope "Device"
+            if (readSysfsValue(supplyPath + "/scope") == "Device") {
+                continue;
+            }
+            if (readSysfsValue(supplyPath + "/status") == "Discharging") {
+                batteryDischarging = true;
+            }
+        } else if (readSysfsValue(supplyPath + "/online") == "1") {
+            // Mains, USB, USB_C, ...
+            externalOnline = true;
+        }
+    }
+    
+    if (!foundSupply) {
+        return false;
+    }
+    
+    onBattery = !externalOnline && batteryDischarging;
+    return true;
+}
+
+void PowerProfileService::poll()
+{
+    bool onBattery = false;
+    if (!readPowerState(m_sysfsRoot, onBattery)) {
+        if (!m_stateKnown) {
+            qCDebug(powerProfile) << "No power supply information under" << m_sysfsRoot;
+        }
+        onBattery = false;
+    }
+    
+    if (m_stateKnown && onBattery == m_onBattery) {
+        return;
+    }
+    
+    bool changed = m_stateKnown || onBattery;
+    m_stateKnown = true;
+    m_onBattery = onBattery;
+    
+    if (changed) {
+        qCInfo(powerProfile) << "Power source changed:" << (onBattery ? "battery" : "AC");
+        emit powerSourceChanged(onBattery);
+    }
+}
@@ -0,0 +1,51 @@
+#ifndef POWERPROFILESERVICE_H
+#define POWERPROFILESERVICE_H
+
+#include <QObject>
+#include <QString>
+#include <QTimer>
+
+// Watches the power supplies under /sys/class/power_supply (or a configured
+// root, e.g. a fake tree for testing) and tells whether the lighter battery
+// profile should be applied to running wallpapers.
+class PowerProfileService : public QObject
+{
+    Q_OBJECT
+
+public:
+    enum class BatteryAction {
+        Reduce,     // relaunch with lower fps / silent
+        Pause       // suspend the renderers until AC returns
+    };
+    
+    explicit PowerProfileService(QObject* parent = nullptr);
+    ~PowerProfileService();
+    
+    void start();
+    void stop();
+    void reloadSettings();
+    
+    bool isOnBattery() const { return m_onBattery; }
+    bool isBatteryProfileActive() const;
+    BatteryAction batteryAction() const;
+    
+    // Lower the launch settings the battery profile covers
+    void applyBatteryProfile(int& fps, bool& silent) const;
+    
+    // Inspect a power_supply tree; returns false when no supply information exists
+    static bool readPowerState(const QString& sysfsRoot, bool& onBattery);
+
+public slots:
+    void poll();
+
+signals:
+    void powerSourceChanged(bool onBattery);
+
+private:
+    QTimer* m_pollTimer;
+    QString m_sysfsRoot;
+    bool m_onBattery;
+    bool m_stateKnown;
+};
+
+#endif // POWERPROFILESERVICE_H
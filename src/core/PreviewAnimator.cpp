@@ -0,0 +1,286 @@
+#include "PreviewAnimator.h"
+#include "ConfigManager.h"
+#include <QImage>
+#include <QVector>
+#include <QPair>
+#include <QLoggingCategory>
+#include <algorithm>
+
+Q_LOGGING_CATEGORY(previewAnimator, "app.previewAnimator")
+
+PreviewAnimator::PreviewAnimator()
+    : QObject(nullptr)
+    , m_lastTick(0)
+    , m_frameTokens(0.0)
+    , m_frameBudget(qMax(1, ConfigManager::instance().previewAnimationFrameBudget()))
+    , m_policy(policyFromString(ConfigManager::instance().previewAnimationPolicy()))
+    , m_maxConcurrent(qMax(1, ConfigManager::instance().previewAnimationLimit()))
+    , m_liveCount(0)
+    , m_peakLiveCount(0)
+    , m_paused(false)
+    , m_nextId(1)
+    , m_framesDecoded(0)
+    , m_framesDeferred(0)
+{
+    connect(&m_clock, &QTimer::timeout, this, &PreviewAnimator::tick);
+    m_time.start();
+    
+    // Make sure the strip cache outlives the animator during static destruction
+    AnimatedPreviewCache::instance();
+}
+
+PreviewAnimator& PreviewAnimator::instance()
+{
+    static PreviewAnimator instance;
+    return instance;
+}
+
+bool PreviewAnimator::isAnimatedPreview(const QString& path)
+{
+    QString lowerPath = path.toLower();
+    return lowerPath.endsWith(".gif") || lowerPath.endsWith(".webp");
+}
+
+quint64 PreviewAnimator::start(const QString& path, const QSize& size, QWidget* widget, FrameCallback callback)
+{
+    if (path.isEmpty() || size.isEmpty() || !widget || !callback) {
+        return 0;
+    }
+    
+    Animation animation;
+    animation.path = path;
+    animation.size = size;
+    animation.devicePixelRatio = widget->devicePixelRatioF();
+    animation.widget = widget;
+    animation.callback = std::move(callback);
+    
+    // Nothing plays until the strip is read or transcoded in the background;
+    // the item keeps showing its thumbnail meanwhile
+    quint64 id = m_nextId++;
+    m_animations.insert(id, animation);
+    quint64 request = AnimatedPreviewCache::instance().load(path, size * animation.devicePixelRatio, this,
+        [this, id](AnimatedPreviewCache::StripPtr strip) {
+            stripReady(id, strip);
+        });
+    
+    // A file that can't be animated may already be gone again
+    auto it = m_animations.find(id);
+    if (it != m_animations.end() && !it->strip) {
+        it->stripRequest = request;
+    }
+    return id;
+}
+
+void PreviewAnimator::stripReady(quint64 id, AnimatedPreviewCache::StripPtr strip)
+{
+    auto it = m_animations.find(id);
+    if (it == m_animations.end()) {
+        return;
+    }
+    it->stripRequest = 0;
+    
+    // A single frame GIF or still WebP is a still; the thumbnail already shows it
+    if (!strip || strip->frameCount() < 2) {
+        qCDebug(previewAnimator) << "Nothing to animate in" << it->path;
+        m_animations.erase(it);
+        updateClock();
+        return;
+    }
+    
+    it->strip = strip;
+    it->frameIndex = 0;
+    it->nextFrameAt = m_time.elapsed();
+    updateClock();
+}
+
+void PreviewAnimator::stop(quint64 id)
+{
+    auto it = m_animations.find(id);
+    if (it == m_animations.end()) {
+        return;
+    }
+    
+    // The strip isn't needed any more; its job stops if nobody else waits
+    if (it->stripRequest != 0) {
+        AnimatedPreviewCache::instance().cancel(it->stripRequest);
+    }
+    m_animations.erase(it);
+    updateClock();
+}
+
+void PreviewAnimator::setPaused(bool paused)
+{
+    m_paused = paused;
+    updateClock();
+}
+
+void PreviewAnimator::setFrameBudget(int framesPerSecond)
+{
+    m_frameBudget = qMax(1, framesPerSecond);
+}
+
+PreviewAnimator::Policy PreviewAnimator::policyFromString(const QString& policy)
+{
+    if (policy == "hover") {
+        return Policy::Hover;
+    }
+    if (policy == "selected") {
+        return Policy::Selected;
+    }
+    return Policy::Always;
+}
+
+void PreviewAnimator::setPolicy(Policy policy)
+{
+    if (m_policy != policy) {
+        m_policy = policy;
+        emit policyChanged();
+    }
+}
+
+bool PreviewAnimator::shouldAnimate(bool hovered, bool selected) const
+{
+    switch (m_policy) {
+    case Policy::Hover:
+        return hovered;
+    case Policy::Selected:
+        return selected;
+    case Policy::Always:
+    default:
+        return true;
+    }
+}
+
+void PreviewAnimator::setMaxConcurrent(int animations)
+{
+    m_maxConcurrent = qMax(1, animations);
+}
+
+QString PreviewAnimator::statsText() const
+{
+    return QString("%1 playing (peak %2) of %3 started, %4 frames decoded, %5 deferred")
+        .arg(m_liveCount)
+        .arg(m_peakLiveCount)
+        .arg(m_animations.size())
+        .arg(m_framesDecoded)
+        .arg(m_framesDeferred);
+}
+
+bool PreviewAnimator::isOnScreen(const Animation& animation)
+{
+    QWidget* widget = animation.widget;
+    if (!widget || !widget->isVisible()) {
+        return false;
+    }
+    
+    QWidget* window = widget->window();
+    if (!window->isVisible() || window->isMinimized()) {
+        return false;
+    }
+    return !widget->visibleRegion().isEmpty();
+}
+
+bool PreviewAnimator::decodeNextFrame(Animation& animation, qint64 now)
+{
+    const AnimatedPreviewStrip& strip = *animation.strip;
+    int index = animation.frameIndex;
+    QImage frame = QImage::fromData(strip.frames.at(index));
+    if (frame.isNull()) {
+        return false;
+    }
+    
+    animation.frameIndex = (index + 1) % strip.frameCount();
+    animation.nextFrameAt = now + qMax(strip.delays.at(index), 1000 / MAX_FPS);
+    ++m_framesDecoded;
+    
+    // The callback may stop this animation, so nothing touches it afterwards
+    QPixmap pixmap = QPixmap::fromImage(frame);
+    pixmap.setDevicePixelRatio(animation.devicePixelRatio);
+    FrameCallback callback = animation.callback;
+    callback(pixmap);
+    return true;
+}
+
+void PreviewAnimator::tick()
+{
+    qint64 now = m_time.elapsed();
+    qint64 elapsed = now - m_lastTick;
+    m_lastTick = now;
+    
+    // Refill the frame budget; after a pause only a short burst is allowed
+    m_frameTokens = qMin(m_frameTokens + elapsed * m_frameBudget / 1000.0,
+                         qMax(1.0, m_frameBudget / 10.0));
+    
+    QVector<quint64> live;
+    QList<quint64> orphaned;
+    for (auto it = m_animations.cbegin(); it != m_animations.cend(); ++it) {
+        if (!it->widget) {
+            orphaned.append(it.key());
+            continue;
+        }
+        if (it->strip && isOnScreen(it.value())) {
+            live.append(it.key());
+        }
+    }
+    for (quint64 id : orphaned) {
+        m_animations.remove(id);
+    }
+    
+    // Past the cap, the animations started last hold their current frame
+    std::sort(live.begin(), live.end());
+    if (live.size() > m_maxConcurrent) {
+        live.resize(m_maxConcurrent);
+    }
+    m_liveCount = live.size();
+    m_peakLiveCount = qMax(m_peakLiveCount, m_liveCount);
+    bool onScreen = !live.isEmpty();
+    
+    QVector<QPair<qint64, quint64>> due;
+    for (quint64 id : live) {
+        qint64 nextFrameAt = m_animations.constFind(id)->nextFrameAt;
+        if (nextFrameAt <= now) {
+            due.append(qMakePair(nextFrameAt, id));
+        }
+    }
+    
+    // Longest waiting first, so a tight budget slows every animation evenly
+    std::sort(due.begin(), due.end());
+    for (int i = 0; i < due.size(); ++i) {
+        if (m_frameTokens < 1.0) {
+            m_framesDeferred += due.size() - i;
+            break;
+        }
+        
+        quint64 id = due.at(i).second;
+        auto it = m_animations.find(id);
+        if (it == m_animations.end()) {
+            continue;
+        }
+        
+        m_frameTokens -= 1.0;
+        if (!decodeNextFrame(it.value(), now)) {
+            qCWarning(previewAnimator) << "Broken frame in animation strip for" << it->path;
+            m_animations.remove(id);
+        }
+    }
+    
+    updateClock(onScreen);
+}
+
+void PreviewAnimator::updateClock(bool onScreen)
+{
+    if (m_paused || m_animations.isEmpty()) {
+        m_clock.stop();
+        m_liveCount = 0;
+        return;
+    }
+    
+    // Nothing visible to animate: keep polling slowly for the window to return
+    int interval = onScreen ? 1000 / MAX_FPS : IDLE_INTERVAL;
+    if (!m_clock.isActive()) {
+        m_lastTick = m_time.elapsed();
+        m_clock.start(interval);
+    } else if (m_clock.interval() != interval) {
+        m_clock.setInterval(interval);
+    }
+}
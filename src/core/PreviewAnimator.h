@@ -0,0 +1,123 @@
+#ifndef PREVIEWANIMATOR_H
+#define PREVIEWANIMATOR_H
+
+#include <QObject>
+#include <QWidget>
+#include <QPointer>
+#include <QPixmap>
+#include <QSize>
+#include <QString>
+#include <QHash>
+#include <QTimer>
+#include <QElapsedTimer>
+#include <functional>
+#include "AnimatedPreviewCache.h"
+
+// Plays every animated preview in the app from one clock. Animations play from
+// thumbnail sized strips made once by AnimatedPreviewCache, only while their
+// widget is on screen, and within a global budget of frames per second; when
+// the budget runs out animations slow down instead of the GUI thread falling
+// behind. Nothing is decoded while the window is hidden or minimized. GUI
+// thread only.
+class PreviewAnimator : public QObject
+{
+    Q_OBJECT
+
+public:
+    using FrameCallback = std::function<void(const QPixmap& frame)>;
+    
+    // Which on-screen previews play
+    enum class Policy {
+        Always,     // every animated preview on screen
+        Hover,      // only the one under the mouse
+        Selected    // only the selected one
+    };
+    
+    static PreviewAnimator& instance();
+    
+    static Policy policyFromString(const QString& policy);
+    Policy policy() const { return m_policy; }
+    void setPolicy(Policy policy);
+    // Whether the policy lets an on-screen preview in this state animate
+    bool shouldAnimate(bool hovered, bool selected) const;
+    
+    // Hard cap on animations advancing at once; the oldest ones win
+    int maxConcurrent() const { return m_maxConcurrent; }
+    void setMaxConcurrent(int animations);
+    
+    static bool isAnimatedPreview(const QString& path);
+    
+    // Frames fitted to size, at the widget's pixel ratio, go to callback while
+    // widget is visible, once the strip is ready. Returns an id for stop(), or
+    // 0 if there is nothing to animate; a file that turns out to be a still
+    // simply never sends frames
+    quint64 start(const QString& path, const QSize& size, QWidget* widget, FrameCallback callback);
+    void stop(quint64 id);
+    
+    // Stops the clock altogether, e.g. while the window is in the tray
+    void setPaused(bool paused);
+    bool isPaused() const { return m_paused; }
+    
+    int frameBudget() const { return m_frameBudget; }
+    void setFrameBudget(int framesPerSecond);
+    
+    // Counters
+    int animationCount() const { return m_animations.size(); }
+    int liveAnimationCount() const { return m_liveCount; }   // on screen and within the cap
+    int peakLiveAnimationCount() const { return m_peakLiveCount; }
+    quint64 framesDecoded() const { return m_framesDecoded; }
+    quint64 framesDeferred() const { return m_framesDeferred; }
+    QString statsText() const;
+    
+    // No single animation runs faster than this
+    static constexpr int MAX_FPS = 30;
+    // Idle poll while nothing animated is on screen
+    static constexpr int IDLE_INTERVAL = 250;
+
+signals:
+    // Views re-evaluate which of their previews should play
+    void policyChanged();
+
+private slots:
+    void tick();
+
+private:
+    PreviewAnimator();
+    ~PreviewAnimator() override = default;
+    PreviewAnimator(const PreviewAnimator&) = delete;
+    PreviewAnimator& operator=(const PreviewAnimator&) = delete;
+    
+    struct Animation {
+        QString path;
+        QSize size;
+        qreal devicePixelRatio = 1.0;
+        QPointer<QWidget> widget;
+        FrameCallback callback;
+        AnimatedPreviewCache::StripPtr strip;   // null until transcoded
+        quint64 stripRequest = 0;               // AnimatedPreviewCache request until then
+        int frameIndex = 0;
+        qint64 nextFrameAt = 0;
+    };
+    
+    static bool isOnScreen(const Animation& animation);
+    void stripReady(quint64 id, AnimatedPreviewCache::StripPtr strip);
+    bool decodeNextFrame(Animation& animation, qint64 now);
+    void updateClock(bool onScreen = true);
+    
+    QHash<quint64, Animation> m_animations;
+    QTimer m_clock;
+    QElapsedTimer m_time;
+    qint64 m_lastTick;
+    double m_frameTokens;
+    int m_frameBudget;
+    Policy m_policy;
+    int m_maxConcurrent;
+    int m_liveCount;
+    int m_peakLiveCount;
+    bool m_paused;
+    quint64 m_nextId;
+    quint64 m_framesDecoded;
+    quint64 m_framesDeferred;
+};
+
+#endif // PREVIEWANIMATOR_H
@@ -0,0 +1,103 @@
+#include "PreviewLoader.h"
+#include "ThumbnailCache.h"
+#include "PreviewPlaceholder.h"
+#include <QThread>
+#include <QLoggingCategory>
+
+Q_LOGGING_CATEGORY(previewLoader, "app.previewLoader")
+
+PreviewLoader::PreviewLoader()
+    : QObject(nullptr)
+    , m_nextRequestId(1)
+    , m_cancelledRequests(0)
+{
+    // Decoding is mostly disk bound; a few threads keep the pipe full without
+    // competing with the renderers for CPU
+    m_pool.setMaxThreadCount(qBound(2, QThread::idealThreadCount() / 2, 4));
+    m_pool.setExpiryTimeout(10000);
+    
+    // Make sure the caches outlive the pool during static destruction
+    ThumbnailCache::instance();
+    PreviewPlaceholder::instance();
+}
+
+PreviewLoader::~PreviewLoader()
+{
+    for (Request& request : m_requests) {
+        request.cancelled->store(true);
+    }
+    m_pool.clear();
+    m_pool.waitForDone();
+}
+
+PreviewLoader& PreviewLoader::instance()
+{
+    static PreviewLoader instance;
+    return instance;
+}
+
+quint64 PreviewLoader::load(const QString& path, const QSize& targetSize, QObject* context,
+                            Callback callback, bool useThumbnailCache)
+{
+    if (path.isEmpty() || targetSize.isEmpty() || !callback) {
+        return 0;
+    }
+    
+    quint64 requestId = m_nextRequestId++;
+    auto cancelled = std::make_shared<std::atomic<bool>>(false);
+    m_requests.insert(requestId, Request{ cancelled, QPointer<QObject>(context), std::move(callback) });
+    
+    m_pool.start([this, requestId, cancelled, path, targetSize, useThumbnailCache]() {
+        // Requests for items that went away while queued cost nothing
+        if (cancelled->load()) {
+            return;
+        }
+        
+        QImage image = useThumbnailCache ? ThumbnailCache::instance().thumbnail(path, targetSize)
+                                         : ThumbnailCache::decodeScaled(path, targetSize);
+        
+        // The first decode of a preview leaves its placeholder behind for
+        // every later one
+        PreviewPlaceholder::instance().update(path, image);
+        if (cancelled->load()) {
+            return;
+        }
+        
+        QMetaObject::invokeMethod(this, [this, requestId, image]() {
+            deliver(requestId, image);
+        }, Qt::QueuedConnection);
+    });
+    
+    return requestId;
+}
+
+void PreviewLoader::cancel(quint64 requestId)
+{
+    auto it = m_requests.find(requestId);
+    if (it == m_requests.end()) {
+        return;
+    }
+    
+    it->cancelled->store(true);
+    m_requests.erase(it);
+    ++m_cancelledRequests;
+}
+
+void PreviewLoader::deliver(quint64 requestId, const QImage& image)
+{
+    auto it = m_requests.find(requestId);
+    if (it == m_requests.end()) {
+        return;
+    }
+    
+    Request request = it.value();
+    m_requests.erase(it);
+    
+    if (!request.context) {
+        return;
+    }
+    if (image.isNull()) {
+        qCDebug(previewLoader) << "Preview decode failed for request" << requestId;
+    }
+    request.callback(image);
+}
@@ -0,0 +1,57 @@
+#ifndef PREVIEWLOADER_H
+#define PREVIEWLOADER_H
+
+#include <QObject>
+#include <QImage>
+#include <QSize>
+#include <QString>
+#include <QHash>
+#include <QPointer>
+#include <QThreadPool>
+#include <functional>
+#include <memory>
+#include <atomic>
+
+// Decodes preview images on a small worker pool so the GUI thread never waits
+// on image I/O. Images are decoded straight at the requested size and, for
+// grid thumbnails, go through the ThumbnailCache. Callbacks run on the GUI
+// thread; cancelled requests are skipped before decoding if still queued, and
+// their results are dropped, as are results for destroyed context objects.
+class PreviewLoader : public QObject
+{
+    Q_OBJECT
+
+public:
+    using Callback = std::function<void(const QImage& image)>;
+    
+    static PreviewLoader& instance();
+    
+    // Returns a request id for cancel(), or 0 if there is nothing to load
+    quint64 load(const QString& path, const QSize& targetSize, QObject* context,
+                 Callback callback, bool useThumbnailCache = true);
+    void cancel(quint64 requestId);
+    
+    int pendingRequests() const { return m_requests.size(); }
+    quint64 cancelledRequests() const { return m_cancelledRequests; }
+
+private:
+    PreviewLoader();
+    ~PreviewLoader();
+    PreviewLoader(const PreviewLoader&) = delete;
+    PreviewLoader& operator=(const PreviewLoader&) = delete;
+    
+    void deliver(quint64 requestId, const QImage& image);
+    
+    struct Request {
+        std::shared_ptr<std::atomic<bool>> cancelled;
+        QPointer<QObject> context;
+        Callback callback;
+    };
+    
+    QThreadPool m_pool;
+    QHash<quint64, Request> m_requests;   // GUI thread only
+    quint64 m_nextRequestId;
+    quint64 m_cancelledRequests;
+};
+
+#endif // PREVIEWLOADER_H
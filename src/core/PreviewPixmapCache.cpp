@@ -0,0 +1,163 @@
+#include "PreviewPixmapCache.h"
+#include "PreviewLoader.h"
+#include "ConfigManager.h"
+#include <QLoggingCategory>
+
+Q_LOGGING_CATEGORY(previewPixmapCache, "app.previewPixmapCache")
+
+PreviewPixmapCache::PreviewPixmapCache()
+    : m_budgetBytes(qMax(1, ConfigManager::instance().previewMemoryBudgetMb()) * 1024LL * 1024)
+    , m_usedBytes(0)
+    , m_hits(0)
+    , m_misses(0)
+    , m_evictions(0)
+{
+}
+
+PreviewPixmapCache& PreviewPixmapCache::instance()
+{
+    static PreviewPixmapCache instance;
+    return instance;
+}
+
+QString PreviewPixmapCache::key(const QString& path, const QSize& size, qreal devicePixelRatio)
+{
+    if (devicePixelRatio == 1.0) {
+        return QString("%1@%2x%3").arg(path).arg(size.width()).arg(size.height());
+    }
+    QSize pixels = size * devicePixelRatio;
+    return QString("%1@%2x%3@%4x").arg(path).arg(pixels.width()).arg(pixels.height()).arg(devicePixelRatio);
+}
+
+qint64 PreviewPixmapCache::pixmapCost(const QPixmap& pixmap)
+{
+    return qint64(pixmap.width()) * pixmap.height() * qMax(1, pixmap.depth()) / 8;
+}
+
+quint64 PreviewPixmapCache::load(const QString& path, const QSize& size, QObject* context,
+                                 Callback callback, bool useThumbnailCache, qreal devicePixelRatio)
+{
+    QString cacheKey = key(path, size, devicePixelRatio);
+    QPixmap cached = acquire(cacheKey);
+    if (!cached.isNull()) {
+        callback(cached);
+        return 0;
+    }
+    
+    // PreviewLoader drops the result if context is gone by then. The thumbnail
+    // cache is keyed by target size, so each pixel ratio gets its own entries
+    return PreviewLoader::instance().load(path, size * devicePixelRatio, context,
+        [this, cacheKey, callback, devicePixelRatio](const QImage& image) {
+            if (image.isNull()) {
+                callback(QPixmap());
+                return;
+            }
+            QPixmap pixmap = QPixmap::fromImage(image);
+            pixmap.setDevicePixelRatio(devicePixelRatio);
+            // Another widget may have loaded the same preview meanwhile; share its copy
+            callback(insert(cacheKey, pixmap));
+        }, useThumbnailCache);
+}
+
+void PreviewPixmapCache::cancel(quint64 requestId)
+{
+    PreviewLoader::instance().cancel(requestId);
+}
+
+QPixmap PreviewPixmapCache::acquire(const QString& key)
+{
+    auto it = m_entries.find(key);
+    if (it == m_entries.end()) {
+        ++m_misses;
+        return QPixmap();
+    }
+    
+    ++m_hits;
+    ++it->references;
+    touch(key);
+    return it->pixmap;
+}
+
+QPixmap PreviewPixmapCache::insert(const QString& key, const QPixmap& pixmap)
+{
+    auto it = m_entries.find(key);
+    if (it != m_entries.end()) {
+        ++it->references;
+        touch(key);
+        return it->pixmap;
+    }
+    
+    if (pixmap.isNull()) {
+        return pixmap;
+    }
+    
+    Entry entry;
+    entry.pixmap = pixmap;
+    entry.references = 1;
+    entry.cost = pixmapCost(pixmap);
+    m_lru.push_front(key);
+    entry.lruPosition = m_lru.begin();
+    m_entries.insert(key, entry);
+    m_usedBytes += entry.cost;
+    
+    evict();
+    return pixmap;
+}
+
+void PreviewPixmapCache::release(const QString& key)
+{
+    auto it = m_entries.find(key);
+    if (it == m_entries.end() || it->references <= 0) {
+        qCWarning(previewPixmapCache) << "Unbalanced release of" << key;
+        return;
+    }
+    
+    --it->references;
+    if (it->references == 0 && m_usedBytes > m_budgetBytes) {
+        evict();
+    }
+}
+
+void PreviewPixmapCache::setMemoryBudget(qint64 bytes)
+{
+    m_budgetBytes = qMax<qint64>(4 * 1024 * 1024, bytes);
+    evict();
+}
+
+void PreviewPixmapCache::touch(const QString& key)
+{
+    auto it = m_entries.find(key);
+    if (it != m_entries.end()) {
+        m_lru.splice(m_lru.begin(), m_lru, it->lruPosition);
+    }
+}
+
+void PreviewPixmapCache::evict()
+{
+    // Walk from the least recently used end; referenced entries are on screen
+    // and stay, even if that leaves the cache over budget
+    auto position = m_lru.end();
+    while (m_usedBytes > m_budgetBytes && position != m_lru.begin()) {
+        --position;
+        auto it = m_entries.find(*position);
+        if (it == m_entries.end() || it->references > 0) {
+            continue;
+        }
+        
+        m_usedBytes -= it->cost;
+        m_entries.erase(it);
+        position = m_lru.erase(position);
+        ++m_evictions;
+    }
+}
+
+QString PreviewPixmapCache::statsText() const
+{
+    quint64 lookups = m_hits + m_misses;
+    return QString("%1 of %2 MB in %3 previews, %4% hits, %5 evictions")
+        .arg(m_usedBytes / (1024.0 * 1024.0), 0, 'f', 1)
+        .arg(m_budgetBytes / (1024 * 1024))
+        .arg(m_entries.size())
+        .arg(lookups > 0 ? 100.0 * m_hits / lookups : 0.0, 0, 'f', 0)
+        .arg(m_evictions);
+}
@@ -0,0 +1,79 @@
+#ifndef PREVIEWPIXMAPCACHE_H
+#define PREVIEWPIXMAPCACHE_H
+
+#include <QPixmap>
+#include <QSize>
+#include <QString>
+#include <QHash>
+#include <QObject>
+#include <functional>
+#include <list>
+
+// Process wide store of decoded preview pixmaps, shared by the wallpaper grid,
+// the playlist and the properties panel. Entries are reference counted: a
+// widget holds a reference while it shows a pixmap and releases it when done.
+// Unreferenced entries stay cached in LRU order until the memory budget is
+// exceeded. GUI thread only.
+class PreviewPixmapCache
+{
+public:
+    using Callback = std::function<void(const QPixmap& pixmap)>;
+    
+    static PreviewPixmapCache& instance();
+    
+    // size is in logical pixels; previews for HiDPI screens are keyed, decoded
+    // and cached at size * devicePixelRatio device pixels
+    static QString key(const QString& path, const QSize& size, qreal devicePixelRatio = 1.0);
+    
+    // Calls back right away on a hit and returns 0; otherwise decodes through
+    // PreviewLoader and returns its request id. A non-null pixmap handed to
+    // the callback carries a reference the caller must release(), and has
+    // devicePixelRatio set so it paints at size without being scaled again
+    quint64 load(const QString& path, const QSize& size, QObject* context,
+                 Callback callback, bool useThumbnailCache = true, qreal devicePixelRatio = 1.0);
+    void cancel(quint64 requestId);
+    
+    // A null pixmap on a miss; a hit takes a reference
+    QPixmap acquire(const QString& key);
+    // Stores pixmap (or keeps an existing entry) and takes a reference to it
+    QPixmap insert(const QString& key, const QPixmap& pixmap);
+    void release(const QString& key);
+    
+    qint64 memoryBudget() const { return m_budgetBytes; }
+    void setMemoryBudget(qint64 bytes);
+    
+    // Counters
+    qint64 memoryUsed() const { return m_usedBytes; }
+    int entryCount() const { return m_entries.size(); }
+    quint64 hits() const { return m_hits; }
+    quint64 misses() const { return m_misses; }
+    quint64 evictions() const { return m_evictions; }
+    QString statsText() const;
+
+private:
+    PreviewPixmapCache();
+    ~PreviewPixmapCache() = default;
+    PreviewPixmapCache(const PreviewPixmapCache&) = delete;
+    PreviewPixmapCache& operator=(const PreviewPixmapCache&) = delete;
+    
+    static qint64 pixmapCost(const QPixmap& pixmap);
+    void touch(const QString& key);
+    void evict();
+    
+    struct Entry {
+        QPixmap pixmap;
+        int references = 0;
+        qint64 cost = 0;
+        std::list<QString>::iterator lruPosition;
+    };
+    
+    QHash<QString, Entry> m_entries;
+    std::list<QString> m_lru;   // most recently used first
+    qint64 m_budgetBytes;
+    qint64 m_usedBytes;
+    quint64 m_hits;
+    quint64 m_misses;
+    quint64 m_evictions;
+};
+
+#endif // PREVIEWPIXMAPCACHE_H
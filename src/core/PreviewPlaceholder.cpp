@@ -0,0 +1,370 @@
+#include "PreviewPlaceholder.h"
+#include "ThumbnailCache.h"
+#include <QDir>
+#include <QFile>
+#include <QFileInfo>
+#include <QDateTime>
+#include <QSaveFile>
+#include <QDataStream>
+#include <QMutexLocker>
+#include <QLoggingCategory>
+#include <cmath>
+
+Q_LOGGING_CATEGORY(previewPlaceholder, "app.previewPlaceholder")
+
+namespace {
+constexpr quint32 STORE_MAGIC = 0x57475048; // "WGPH"
+constexpr quint16 STORE_VERSION = 1;
+
+constexpr int COMPONENTS_X = 4;
+constexpr int COMPONENTS_Y = 3;
+constexpr int COMPONENTS = COMPONENTS_X * COMPONENTS_Y;
+// Component counts, aspect ratio, DC colour and AC scale, then 3 bytes per AC
+constexpr int HEADER_BYTES = 7;
+constexpr int ENCODED_BYTES = HEADER_BYTES + (COMPONENTS - 1) * 3;
+
+// Only the lowest frequencies survive, so a small sample encodes the same as
+// the full thumbnail, and a small decode stretches without visible steps
+constexpr int SAMPLE_SIZE = 32;
+constexpr int RENDER_SIZE = 32;
+
+// Write the store once this many placeholders are new, besides after a scan
+constexpr int SAVE_BATCH = 64;
+
+const float* srgbToLinearTable()
+{
+    static float table[256];
+    static bool initialized = [] {
+        for (int i = 0; i < 256; ++i) {
+            float v = i / 255.0f;
+            table[i] = v <= 0.04045f ? v / 12.92f : std::pow((v + 0.055f) / 1.055f, 2.4f);
+        }
+        return true;
+    }();
+    Q_UNUSED(initialized);
+    return table;
+}
+
+int linearToSrgb(float value)
+{
+    float v = qBound(0.0f, value, 1.0f);
+    float srgb = v <= 0.0031308f ? v * 12.92f : 1.055f * std::pow(v, 1.0f / 2.4f) - 0.055f;
+    return qBound(0, int(srgb * 255.0f + 0.5f), 255);
+}
+
+float signedPow(float value, float exponent)
+{
+    return std::copysign(std::pow(std::fabs(value), exponent), value);
+}
+}
+
+PreviewPlaceholder::PreviewPlaceholder()
+    : m_unsaved(0)
+{
+    read();
+}
+
+PreviewPlaceholder::~PreviewPlaceholder()
+{
+    save();
+}
+
+PreviewPlaceholder& PreviewPlaceholder::instance()
+{
+    static PreviewPlaceholder instance;
+    return instance;
+}
+
+QString PreviewPlaceholder::storePath()
+{
+    // Next to the thumbnails rather than inside them, where pruning would
+    // delete it
+    QFileInfo thumbnails(ThumbnailCache::defaultDirectory());
+    return QDir(thumbnails.path()).filePath("placeholders.dat");
+}
+
+QByteArray PreviewPlaceholder::encode(const QImage& image)
+{
+    if (image.isNull()) {
+        return QByteArray();
+    }
+    
+    QImage sample = image.scaled(SAMPLE_SIZE, SAMPLE_SIZE, Qt::IgnoreAspectRatio, Qt::SmoothTransformation)
+                        .convertToFormat(QImage::Format_RGB32);
+    const int width = sample.width();
+    const int height = sample.height();
+    const float* toLinear = srgbToLinearTable();
+    
+    // Cosine basis per axis, shared by all pixels of a row or column
+    float basisX[COMPONENTS_X][SAMPLE_SIZE];
+    float basisY[COMPONENTS_Y][SAMPLE_SIZE];
+    for (int i = 0; i < COMPONENTS_X; ++i) {
+        for (int x = 0; x < width; ++x) {
+            basisX[i][x] = std::cos(float(M_PI) * i * (x + 0.5f) / width);
+        }
+    }
+    for (int j = 0; j < COMPONENTS_Y; ++j) {
+        for (int y = 0; y < height; ++y) {
+            basisY[j][y] = std::cos(float(M_PI) * j * (y + 0.5f) / height);
+        }
+    }
+    
+    float factors[COMPONENTS][3] = {};
+    for (int y = 0; y < height; ++y) {
+        const QRgb* line = reinterpret_cast<const QRgb*>(sample.constScanLine(y));
+        for (int x = 0; x < width; ++x) {
+            float r = toLinear[qRed(line[x])];
+            float g = toLinear[qGreen(line[x])];
+            float b = toLinear[qBlue(line[x])];
+            for (int j = 0; j < COMPONENTS_Y; ++j) {
+                for (int i = 0; i < COMPONENTS_X; ++i) {
+                    float basis = basisX[i][x] * basisY[j][y];
+                    float* factor = factors[j * COMPONENTS_X + i];
+                    factor[0] += basis * r;
+                    factor[1] += basis * g;
+                    factor[2] += basis * b;
+                }
+            }
+        }
+    }
+    
+    float maximumAc = 0.0f;
+    for (int c = 0; c < COMPONENTS; ++c) {
+        float normalisation = (c == 0 ? 1.0f : 2.0f) / (width * height);
+        for (float& value : factors[c]) {
+            value *= normalisation;
+            if (c > 0) {
+                maximumAc = qMax(maximumAc, std::fabs(value));
+            }
+        }
+    }
+    
+    QByteArray encoded;
+    encoded.reserve(ENCODED_BYTES);
+    encoded.append(char((COMPONENTS_X - 1) | ((COMPONENTS_Y - 1) << 4)));
+    
+    // Aspect ratio as 8.8 fixed point, so cards can size the placeholder like
+    // the thumbnail it stands in for
+    quint16 aspect = quint16(qBound(1, qRound(image.width() * 256.0 / image.height()), 0xffff));
+    encoded.append(char(aspect >> 8));
+    encoded.append(char(aspect & 0xff));
+    
+    for (int channel = 0; channel < 3; ++channel) {
+        encoded.append(char(linearToSrgb(factors[0][channel])));
+    }
+    
+    int quantisedMaximum = qBound(0, int(maximumAc * 256.0f), 255);
+    float acScale = (quantisedMaximum + 1) / 256.0f;
+    encoded.append(char(quantisedMaximum));
+    
+    for (int c = 1; c < COMPONENTS; ++c) {
+        for (int channel = 0; channel < 3; ++channel) {
+            float value = signedPow(factors[c][channel] / acScale, 0.5f);
+            encoded.append(char(qBound(0, int(std::floor(value * 127.5f + 128.0f)), 255)));
+        }
+    }
+    
+    return encoded;
+}
+
+bool PreviewPlaceholder::isValid(const QByteArray& placeholder)
+{
+    return placeholder.size() == ENCODED_BYTES &&
+           quint8(placeholder.at(0)) == ((COMPONENTS_X - 1) | ((COMPONENTS_Y - 1) << 4));
+}
+
+qreal PreviewPlaceholder::aspectRatio(const QByteArray& placeholder)
+{
+    if (!isValid(placeholder)) {
+        return 0.0;
+    }
+    
+    quint16 aspect = quint16((quint8(placeholder.at(1)) << 8) | quint8(placeholder.at(2)));
+    return aspect / 256.0;
+}
+
+QImage PreviewPlaceholder::render(const QByteArray& placeholder, const QSize& size)
+{
+    if (!isValid(placeholder) || size.isEmpty()) {
+        return QImage();
+    }
+    
+    const auto* data = reinterpret_cast<const quint8*>(placeholder.constData());
+    const float* toLinear = srgbToLinearTable();
+    float acScale = (data[6] + 1) / 256.0f;
+    
+    float factors[COMPONENTS][3];
+    for (int channel = 0; channel < 3; ++channel) {
+        factors[0][channel] = toLinear[data[3 + channel]];
+    }
+    for (int c = 1; c < COMPONENTS; ++c) {
+        for (int channel = 0; channel < 3; ++channel) {
+            float value = (data[HEADER_BYTES + (c - 1) * 3 + channel] - 127.5f) / 127.5f;
+            factors[c][channel] = signedPow(value, 2.0f) * acScale;
+        }
+    }
+    
+    QSize renderSize = size;
+    if (size.width() > RENDER_SIZE || size.height() > RENDER_SIZE) {
+        renderSize = size.scaled(RENDER_SIZE, RENDER_SIZE, Qt::KeepAspectRatio).expandedTo(QSize(1, 1));
+    }
+    
+    const int width = renderSize.width();
+    const int height = renderSize.height();
+    QImage image(renderSize, QImage::Format_RGB32);
+    for (int y = 0; y < height; ++y) {
+        QRgb* line = reinterpret_cast<QRgb*>(image.scanLine(y));
+        for (int x = 0; x < width; ++x) {
+            float r = 0.0f;
+            float g = 0.0f;
+            float b = 0.0f;
+            for (int j = 0; j < COMPONENTS_Y; ++j) {
+                float basisY = std::cos(float(M_PI) * j * (y + 0.5f) / height);
+                for (int i = 0; i < COMPONENTS_X; ++i) {
+                    float basis = std::cos(float(M_PI) * i * (x + 0.5f) / width) * basisY;
+                    const float* factor = factors[j * COMPONENTS_X + i];
+                    r += factor[0] * basis;
+                    g += factor[1] * basis;
+                    b += factor[2] * basis;
+                }
+            }
+            line[x] = qRgb(linearToSrgb(r), linearToSrgb(g), linearToSrgb(b));
+        }
+    }
+    
+    if (renderSize == size) {
+        return image;
+    }
+    return image.scaled(size, Qt::IgnoreAspectRatio, Qt::SmoothTransformation);
+}
+
+QByteArray PreviewPlaceholder::lookup(const QString& previewPath) const
+{
+    if (previewPath.isEmpty()) {
+        return QByteArray();
+    }
+    
+    qint64 modified = QFileInfo(previewPath).lastModified().toMSecsSinceEpoch();
+    QMutexLocker locker(&m_mutex);
+    auto it = m_entries.constFind(previewPath);
+    if (it == m_entries.constEnd() || it->modified != modified) {
+        return QByteArray();
+    }
+    return it->placeholder;
+}
+
+QByteArray PreviewPlaceholder::cached(const QString& previewPath) const
+{
+    QMutexLocker locker(&m_mutex);
+    auto it = m_entries.constFind(previewPath);
+    return it == m_entries.constEnd() ? QByteArray() : it->placeholder;
+}
+
+void PreviewPlaceholder::update(const QString& previewPath, const QImage& image)
+{
+    if (previewPath.isEmpty() || image.isNull()) {
+        return;
+    }
+    
+    qint64 modified = QFileInfo(previewPath).lastModified().toMSecsSinceEpoch();
+    {
+        QMutexLocker locker(&m_mutex);
+        auto it = m_entries.constFind(previewPath);
+        if (it != m_entries.constEnd() && it->modified == modified) {
+            return;
+        }
+    }
+    
+    // Encoding takes well under a millisecond on the small sample
+    QByteArray placeholder = encode(image);
+    if (placeholder.isEmpty()) {
+        return;
+    }
+    
+    bool saveNow = false;
+    {
+        QMutexLocker locker(&m_mutex);
+        m_entries.insert(previewPath, Entry{ modified, placeholder });
+        saveNow = ++m_unsaved >= SAVE_BATCH;
+    }
+    if (saveNow) {
+        save();
+    }
+}
+
+int PreviewPlaceholder::entryCount() const
+{
+    QMutexLocker locker(&m_mutex);
+    return m_entries.size();
+}
+
+void PreviewPlaceholder::read()
+{
+    QFile input(storePath());
+    if (!input.open(QIODevice::ReadOnly)) {
+        return;
+    }
+    
+    QDataStream stream(&input);
+    stream.setVersion(QDataStream::Qt_6_0);
+    quint32 magic = 0;
+    quint16 version = 0;
+    quint32 count = 0;
+    stream >> magic >> version >> count;
+    if (magic != STORE_MAGIC || version != STORE_VERSION) {
+        qCWarning(previewPlaceholder) << "Ignoring placeholder store in unknown format" << input.fileName();
+        return;
+    }
+    
+    m_entries.reserve(int(count));
+    for (quint32 i = 0; i < count && stream.status() == QDataStream::Ok; ++i) {
+        QString path;
+        Entry entry;
+        stream >> path >> entry.modified >> entry.placeholder;
+        if (stream.status() == QDataStream::Ok && isValid(entry.placeholder)) {
+            m_entries.insert(path, entry);
+        }
+    }
+    
+    if (stream.status() != QDataStream::Ok) {
+        qCWarning(previewPlaceholder) << "Placeholder store is truncated, kept" << m_entries.size() << "entries";
+    } else {
+        qCDebug(previewPlaceholder) << "Read" << m_entries.size() << "placeholders";
+    }
+}
+
+void PreviewPlaceholder::save()
+{
+    // One writer at a time; readers and update() only wait for the copy
+    QMutexLocker saveLocker(&m_saveMutex);
+    
+    QHash<QString, Entry> entries;
+    {
+        QMutexLocker locker(&m_mutex);
+        if (m_unsaved == 0) {
+            return;
+        }
+        entries = m_entries;
+        m_unsaved = 0;
+    }
+    
+    QDir().mkpath(QFileInfo(storePath()).path());
+    QSaveFile output(storePath());
+    if (!output.open(QIODevice::WriteOnly)) {
+        qCWarning(previewPlaceholder) << "Failed to write placeholder store" << output.errorString();
+        return;
+    }
+    
+    QDataStream stream(&output);
+    stream.setVersion(QDataStream::Qt_6_0);
+    stream << STORE_MAGIC << STORE_VERSION << quint32(entries.size());
+    for (auto it = entries.constBegin(); it != entries.constEnd(); ++it) {
+        stream << it.key() << it->modified << it->placeholder;
+    }
+    
+    if (stream.status() != QDataStream::Ok || !output.commit()) {
+        qCWarning(previewPlaceholder) << "Failed to write placeholder store" << output.errorString();
+        return;
+    }
+    qCDebug(previewPlaceholder) << "Saved" << entries.size() << "placeholders";
+}
@@ -0,0 +1,63 @@
+#ifndef PREVIEWPLACEHOLDER_H
+#define PREVIEWPLACEHOLDER_H
+
+#include <QByteArray>
+#include <QImage>
+#include <QSize>
+#include <QString>
+#include <QHash>
+#include <QMutex>
+
+// Tiny blurred stand-in for a wallpaper preview, in the spirit of BlurHash: the
+// lowest 4x3 cosine components of the image plus its aspect ratio, 40 bytes in
+// all. It is computed once, the first time a preview is decoded, and kept in a
+// small store next to the thumbnail cache so the next scan hands it out with
+// the wallpaper's catalog entry. Cards paint it while the real thumbnail is
+// still decoding. The store is thread safe.
+class PreviewPlaceholder
+{
+public:
+    static PreviewPlaceholder& instance();
+    
+    // Empty for a null image
+    static QByteArray encode(const QImage& image);
+    // Placeholder drawn at size, smooth enough to stretch; null if invalid
+    static QImage render(const QByteArray& placeholder, const QSize& size);
+    // Width / height of the original preview, 0 if invalid
+    static qreal aspectRatio(const QByteArray& placeholder);
+    static bool isValid(const QByteArray& placeholder);
+    
+    // Placeholder for previewPath if it is still current; stats the file
+    QByteArray lookup(const QString& previewPath) const;
+    // Whatever is stored for previewPath, without touching the disk
+    QByteArray cached(const QString& previewPath) const;
+    // Encodes image as the placeholder for previewPath unless it already has
+    // an up to date one. Called with every freshly decoded preview
+    void update(const QString& previewPath, const QImage& image);
+    
+    // Writes new placeholders to disk; cheap when there are none
+    void save();
+    
+    static QString storePath();
+    int entryCount() const;
+
+private:
+    PreviewPlaceholder();
+    ~PreviewPlaceholder();
+    PreviewPlaceholder(const PreviewPlaceholder&) = delete;
+    PreviewPlaceholder& operator=(const PreviewPlaceholder&) = delete;
+    
+    void read();
+    
+    struct Entry {
+        qint64 modified = 0;    // preview mtime in ms when it was encoded
+        QByteArray placeholder;
+    };
+    
+    mutable QMutex m_mutex;
+    QMutex m_saveMutex;
+    QHash<QString, Entry> m_entries;
+    int m_unsaved;
+};
+
+#endif // PREVIEWPLACEHOLDER_H
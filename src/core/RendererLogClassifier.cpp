@@ -0,0 +1,183 @@
+#include "RendererLogClassifier.h"
+
+RendererLogClassifier::RendererLogClassifier()
+{
+    const auto options = QRegularExpression::CaseInsensitiveOption;
+    
+    // Sources. mpv prefixes its messages with the module, e.g. "[ao/pulse]" or "[vo/gpu]";
+    // its audio outputs are reported as audio, everything else from mpv as mpv.
+    m_sourceRules = {
+        { QRegularExpression("^\\s*\\[(ao|ad)(/[^\\]]*)?\\]", options), Source::Audio },
+        { QRegularExpression("^\\s*\\[(cplayer|vo|vd|ffmpeg|demux|lavf|osd|stream|file|input|mpv)(/[^\\]]*)?\\]|\\b(lib)?mpv\\b", options), Source::Mpv },
+        { QRegularExpression("\\b(gl|opengl|glew|glfw|egl|glx|glsl|shader|framebuffer|fbo|vulkan|mesa)\\b", options), Source::GL },
+        { QRegularExpression("\\b(audio|sound|pulse(audio)?|pipewire|alsa|openal|sdl_audio|miniaudio)\\b", options), Source::Audio }
+    };
+    
+    // Severities. The benign startup complaints come first so they never count as errors.
+    m_severityRules = {
+        { QRegularExpression("Fullscreen detection not supported|Failed to initialize GLEW"), Severity::Warning },
+        { QRegularExpression("fatal|critical|segmentation fault|core dumped|\\babort(ed|ing)?\\b", options), Severity::Fatal },
+        { QRegularExpression("error|failed", options), Severity::Error },
+        { QRegularExpression("warn|deprecated", options), Severity::Warning },
+        { QRegularExpression("\\b(debug|trace|verbose)\\b", options), Severity::Debug }
+    };
+    
+    // Compile up front; the output workers of all renderers match concurrently afterwards
+    for (SourceRule& rule : m_sourceRules) {
+        rule.pattern.optimize();
+    }
+    for (SeverityRule& rule : m_severityRules) {
+        rule.pattern.optimize();
+    }
+    
+    for (int source = 0; source < SOURCE_COUNT; ++source) {
+        for (int severity = 0; severity < SEVERITY_COUNT; ++severity) {
+            m_counters[source][severity] = 0;
+        }
+    }
+}
+
+RendererLogClassifier& RendererLogClassifier::instance()
+{
+    static RendererLogClassifier instance;
+    return instance;
+}
+
+RendererLogClassifier::Classification RendererLogClassifier::classify(const QString& line, bool count)
+{
+    Classification result;
+    
+    for (const SourceRule& rule : m_sourceRules) {
+        if (rule.pattern.match(line).hasMatch()) {
+            result.source = rule.source;
+            break;
+        }
+    }
+    
+    for (const SeverityRule& rule : m_severityRules) {
+        if (rule.pattern.match(line).hasMatch()) {
+            result.severity = rule.severity;
+            break;
+        }
+    }
+    
+    if (count) {
+        m_counters[static_cast<int>(result.source)][static_cast<int>(result.severity)].fetch_add(1, std::memory_order_relaxed);
+    }
+    return result;
+}
+
+QString RendererLogClassifier::sourceName(Source source)
+{
+    switch (source) {
+    case Source::Engine:
+        return "engine";
+    case Source::Mpv:
+        return "mpv";
+    case Source::GL:
+        return "gl";
+    case Source::Audio:
+        return "audio";
+    case Source::Count:
+        break;
+    }
+    return "unknown";
+}
+
+QString RendererLogClassifier::severityName(Severity severity)
+{
+    switch (severity) {
+    case Severity::Debug:
+        return "debug";
+    case Severity::Info:
+        return "info";
+    case Severity::Warning:
+        return "warning";
+    case Severity::Error:
+        return "error";
+    case Severity::Fatal:
+        return "fatal";
+    case Severity::Count:
+        break;
+    }
+    return "unknown";
+}
+
+quint64 RendererLogClassifier::count(Source source, Severity severity) const
+{
+    return m_counters[static_cast<int>(source)][static_cast<int>(severity)].load(std::memory_order_relaxed);
+}
+
+quint64 RendererLogClassifier::count(Severity severity) const
+{
+    quint64 total = 0;
+    for (int source = 0; source < SOURCE_COUNT; ++source) {
+        total += m_counters[source][static_cast<int>(severity)].load(std::memory_order_relaxed);
+    }
+    return total;
+}
+
+quint64 RendererLogClassifier::totalLines() const
+{
+    quint64 total = 0;
+    for (int severity = 0; severity < SEVERITY_COUNT; ++severity) {
+        total += count(static_cast<Severity>(severity));
+    }
+    return total;
+}
+
+QJsonObject RendererLogClassifier::countersToJson() const
+{
+    QJsonObject sources;
+    for (int source = 0; source < SOURCE_COUNT; ++source) {
+        QJsonObject severities;
+        for (int severity = 0; severity < SEVERITY_COUNT; ++severity) {
+            severities[severityName(static_cast<Severity>(severity))] =
+                static_cast<double>(m_counters[source][severity].load(std::memory_order_relaxed));
+        }
+        sources[sourceName(static_cast<Source>(source))] = severities;
+    }
+    
+    QJsonObject root;
+    root["total_lines"] = static_cast<double>(totalLines());
+    root["sources"] = sources;
+    return root;
+}
+
+RendererLogClassifier::Counters RendererLogClassifier::counters() const
+{
+    Counters counters;
+    for (int source = 0; source < SOURCE_COUNT; ++source) {
+        for (int severity = 0; severity < SEVERITY_COUNT; ++severity) {
+            counters.lines[source][severity] = m_counters[source][severity].load(std::memory_order_relaxed);
+        }
+    }
+    return counters;
+}
+
+quint64 RendererLogClassifier::Counters::count(Severity severity) const
+{
+    quint64 total = 0;
+    for (int source = 0; source < SOURCE_COUNT; ++source) {
+        total += lines[source][static_cast<int>(severity)];
+    }
+    return total;
+}
+
+quint64 RendererLogClassifier::Counters::total() const
+{
+    quint64 total = 0;
+    for (int severity = 0; severity < SEVERITY_COUNT; ++severity) {
+        total += count(static_cast<Severity>(severity));
+    }
+    return total;
+}
+
+void RendererLogClassifier::resetCounters()
+{
+    for (int source = 0; source < SOURCE_COUNT; ++source) {
+        for (int severity = 0; severity < SEVERITY_COUNT; ++severity) {
+            m_counters[source][severity].store(0, std::memory_order_relaxed);
+        }
+    }
+}
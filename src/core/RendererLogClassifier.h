@@ -0,0 +1,92 @@
+#ifndef RENDERERLOGCLASSIFIER_H
+#define RENDERERLOGCLASSIFIER_H
+
+#include <QString>
+#include <QVector>
+#include <QRegularExpression>
+#include <QJsonObject>
+#include <atomic>
+
+// Rule based tagging of renderer output lines by source and severity, shared
+// by all renderer backends. Every classified line bumps a per source/severity
+// counter; the counters are atomics so the output worker threads can update
+// them while the UI reads them.
+class RendererLogClassifier
+{
+public:
+    enum class Source {
+        Engine,
+        Mpv,
+        GL,
+        Audio,
+        Count
+    };
+    
+    enum class Severity {
+        Debug,
+        Info,
+        Warning,
+        Error,
+        Fatal,
+        Count
+    };
+    
+    struct Classification {
+        Source source = Source::Engine;
+        Severity severity = Severity::Info;
+        
+        bool isError() const { return severity >= Severity::Error; }
+        bool isWarningOrWorse() const { return severity >= Severity::Warning; }
+    };
+    
+    // Copy of all counters, so a UI refresh reads one consistent set
+    struct Counters {
+        quint64 lines[static_cast<int>(Source::Count)][static_cast<int>(Severity::Count)] = {};
+        
+        quint64 count(Source source, Severity severity) const { return lines[static_cast<int>(source)][static_cast<int>(severity)]; }
+        quint64 count(Severity severity) const;
+        quint64 total() const;
+    };
+    
+    static RendererLogClassifier& instance();
+    
+    // Classify a line; counted lines show up in the counters
+    Classification classify(const QString& line, bool count = true);
+    
+    static QString sourceName(Source source);
+    static QString severityName(Severity severity);
+    
+    // Counter queries (cheap, lock free)
+    quint64 count(Source source, Severity severity) const;
+    quint64 count(Severity severity) const;
+    quint64 totalLines() const;
+    Counters counters() const;
+    QJsonObject countersToJson() const;
+    void resetCounters();
+
+private:
+    struct SourceRule {
+        QRegularExpression pattern;
+        Source source;
+    };
+    
+    struct SeverityRule {
+        QRegularExpression pattern;
+        Severity severity;
+    };
+    
+    RendererLogClassifier();
+    ~RendererLogClassifier() = default;
+    RendererLogClassifier(const RendererLogClassifier&) = delete;
+    RendererLogClassifier& operator=(const RendererLogClassifier&) = delete;
+    
+    static constexpr int SOURCE_COUNT = static_cast<int>(Source::Count);
+    static constexpr int SEVERITY_COUNT = static_cast<int>(Severity::Count);
+    
+    // First matching rule wins
+    QVector<SourceRule> m_sourceRules;
+    QVector<SeverityRule> m_severityRules;
+    std::atomic<quint64> m_counters[SOURCE_COUNT][SEVERITY_COUNT];
+};
+
+#endif // RENDERERLOGCLASSIFIER_H
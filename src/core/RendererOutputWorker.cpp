@@ -0,0 +1,402 @@
+#include "RendererOutputWorker.h"
+#include <QRegularExpression>
+#include <fcntl.h>
+
+namespace {
+// Interval for summaries of runs that are still going and for the rate limit window
+constexpr int SUMMARY_INTERVAL_MS = 1000;
+
+// Changes to the output files are read at most this often, and read output
+// is handed back to the file system in steps of this size
+constexpr int READ_INTERVAL_MS = 100;
+constexpr qint64 RELEASE_BYTES = 1024 * 1024;
+}
+
+RendererOutputWorker::RendererOutputWorker(QObject* parent)
+    : QObject(parent)
+    , m_watcher(nullptr)
+    , m_readTimer(new QTimer(this))
+    , m_readPending(false)
+    , m_polling(false)
+    , m_summaryTimer(new QTimer(this))
+    , m_captureMode(CaptureMode::Full)
+    , m_collapseRepeats(true)
+    , m_lineBudget(200)
+    , m_collapsedLines(0)
+    , m_droppedLines(0)
+{
+    qRegisterMetaType<RendererOutput>("RendererOutput");
+    
+    // The timer moves to the worker thread together with its parent
+    m_summaryTimer->setInterval(SUMMARY_INTERVAL_MS);
+    connect(m_summaryTimer, &QTimer::timeout, this, &RendererOutputWorker::emitSummaries);
+    m_clock.start();
+    
+    m_readTimer->setSingleShot(true);
+    m_readTimer->setInterval(READ_INTERVAL_MS);
+    connect(m_readTimer, &QTimer::timeout, this, &RendererOutputWorker::onReadTimeout);
+}
+
+RendererOutputWorker::CaptureMode RendererOutputWorker::captureModeFromString(const QString& mode)
+{
+    if (mode == "off") {
+        return CaptureMode::Off;
+    }
+    if (mode == "errors") {
+        return CaptureMode::ErrorsOnly;
+    }
+    return CaptureMode::Full;
+}
+
+QString RendererOutputWorker::captureModeToString(CaptureMode mode)
+{
+    switch (mode) {
+    case CaptureMode::Off:
+        return "off";
+    case CaptureMode::ErrorsOnly:
+        return "errors";
+    case CaptureMode::Full:
+        return "full";
+    }
+    return "full";
+}
+
+void RendererOutputWorker::startTailing(const QString& screenRoot, const QString& standardOutputPath,
+                                        const QString& standardErrorPath, bool skipExisting)
+{
+    stopTailing(screenRoot);
+    
+    // Created here rather than in the constructor so its notifiers live on this thread
+    if (!m_watcher) {
+        m_watcher = new QFileSystemWatcher(this);
+        connect(m_watcher, &QFileSystemWatcher::fileChanged, this, &RendererOutputWorker::scheduleRead);
+    }
+    
+    Tail tail;
+    tail.standardOutput.file = openTail(standardOutputPath, skipExisting);
+    tail.standardError.file = openTail(standardErrorPath, skipExisting);
+    m_tails.insert(screenRoot, tail);
+    
+    // The renderer may have written something before the files were opened
+    scheduleRead();
+}
+
+void RendererOutputWorker::stopTailing(const QString& screenRoot)
+{
+    auto it = m_tails.find(screenRoot);
+    if (it == m_tails.end()) {
+        return;
+    }
+    
+    // The renderer is gone or going; pick up its last lines first. The files
+    // may be unlinked already, the open handles still read them
+    readTail(it.key(), it.value());
+    for (QFile* file : { it->standardOutput.file, it->standardError.file }) {
+        if (file) {
+            m_watcher->removePath(file->fileName());
+            delete file;
+        }
+    }
+    m_tails.erase(it);
+    flush(screenRoot);
+}
+
+void RendererOutputWorker::scheduleRead()
+{
+    // The first change is read right away, later ones together once the interval is over
+    if (m_readTimer->isActive()) {
+        m_readPending = true;
+        return;
+    }
+    
+    for (auto it = m_tails.begin(); it != m_tails.end(); ++it) {
+        readTail(it.key(), it.value());
+    }
+    m_readTimer->start();
+}
+
+void RendererOutputWorker::onReadTimeout()
+{
+    if (m_polling && m_tails.isEmpty()) {
+        m_polling = false;
+    }
+    if (m_readPending || m_polling) {
+        m_readPending = false;
+        scheduleRead();
+    }
+}
+
+QFile* RendererOutputWorker::openTail(const QString& path, bool skipExisting)
+{
+    if (path.isEmpty()) {
+        return nullptr;
+    }
+    
+    // Unbuffered, so every read sees what the renderer appended since; writable
+    // so the part already read can be released
+    QFile* file = new QFile(path, this);
+    if (!file->open(QIODevice::ReadWrite | QIODevice::Unbuffered)) {
+        delete file;
+        return nullptr;
+    }
+    if (skipExisting) {
+        file->seek(file->size());
+    }
+    if (!m_watcher->addPath(path)) {
+        m_polling = true;
+    }
+    return file;
+}
+
+bool RendererOutputWorker::readNew(TailFile& tail, bool skip, QByteArray& data)
+{
+    if (!tail.file) {
+        return false;
+    }
+    
+    qint64 size = tail.file->size();
+    if (size <= tail.file->pos()) {
+        return false;
+    }
+    if (skip) {
+        tail.file->seek(size);
+    } else {
+        data = tail.file->readAll();
+    }
+    
+    // The renderer appends to the file for as long as it runs, so the file is
+    // never truncated (that would race its writes); the part already read is
+    // punched out instead. Where that is unsupported the file grows until the
+    // renderer stops
+    qint64 position = tail.file->pos();
+    if (position - tail.released >= RELEASE_BYTES) {
+#ifdef FALLOC_FL_PUNCH_HOLE
+        ::fallocate(tail.file->handle(), FALLOC_FL_PUNCH_HOLE | FALLOC_FL_KEEP_SIZE,
+                    tail.released, position - tail.released);
+#endif
+        tail.released = position;
+    }
+    return true;
+}
+
+void RendererOutputWorker::readTail(const QString& screenRoot, Tail& tail)
+{
+    // Off only needs to know that the renderer wrote something; the bytes are skipped unread
+    bool skip = m_captureMode == CaptureMode::Off;
+    QByteArray standardOutput;
+    QByteArray standardError;
+    bool outputWritten = readNew(tail.standardOutput, skip, standardOutput);
+    bool errorWritten = readNew(tail.standardError, skip, standardError);
+    if (!outputWritten && !errorWritten) {
+        return;
+    }
+    
+    if (!tail.seenOutput) {
+        tail.seenOutput = true;
+        emit firstOutput(screenRoot);
+    }
+    processOutput(screenRoot, standardOutput, standardError);
+}
+
+void RendererOutputWorker::processOutput(const QString& screenRoot, const QByteArray& standardOutput, const QByteArray& standardError)
+{
+    CaptureMode mode = m_captureMode;
+    if (mode == CaptureMode::Off) {
+        return;
+    }
+    
+    PendingBytes& pending = m_pending[screenRoot];
+    QStringList outputLines;
+    if (mode == CaptureMode::Full) {
+        outputLines = takeLines(pending.standardOutput, standardOutput, false);
+    }
+    QStringList errorLines = takeLines(pending.standardError, standardError, false);
+    
+    RendererOutput output;
+    StreamState& state = m_streams[screenRoot];
+    classify(outputLines, errorLines, state, output);
+    if (!output.isEmpty()) {
+        emit outputReady(screenRoot, output);
+    }
+    
+    if (state.hasSummary() && !m_summaryTimer->isActive()) {
+        m_summaryTimer->start();
+    }
+}
+
+void RendererOutputWorker::flush(const QString& screenRoot)
+{
+    auto it = m_pending.find(screenRoot);
+    if (it == m_pending.end()) {
+        return;
+    }
+    
+    QStringList outputLines = takeLines(it->standardOutput, QByteArray(), true);
+    QStringList errorLines = takeLines(it->standardError, QByteArray(), true);
+    m_pending.erase(it);
+    
+    StreamState state = m_streams.take(screenRoot);
+    if (m_captureMode == CaptureMode::Off) {
+        return;
+    }
+    if (m_captureMode == CaptureMode::ErrorsOnly) {
+        outputLines.clear();
+    }
+    
+    // The renderer is gone, so close any open run and report what the budget dropped
+    RendererOutput output;
+    classify(outputLines, errorLines, state, output);
+    summarizeRepeats(state, output);
+    summarizeDropped(state, output);
+    if (!output.isEmpty()) {
+        emit outputReady(screenRoot, output);
+    }
+}
+
+void RendererOutputWorker::emitSummaries()
+{
+    bool pending = false;
+    qint64 now = m_clock.elapsed();
+    
+    for (auto it = m_streams.begin(); it != m_streams.end(); ++it) {
+        StreamState& state = it.value();
+        RendererOutput output;
+        
+        // A run that is still going gets an interim count but stays collapsed
+        summarizeRepeats(state, output);
+        if (state.windowStartMs >= 0 && now - state.windowStartMs >= SUMMARY_INTERVAL_MS) {
+            summarizeDropped(state, output);
+            state.windowStartMs = -1;
+            state.windowLines = 0;
+        }
+        
+        pending = pending || state.hasSummary();
+        if (!output.isEmpty()) {
+            emit outputReady(it.key(), output);
+        }
+    }
+    
+    if (!pending) {
+        m_summaryTimer->stop();
+    }
+}
+
+QStringList RendererOutputWorker::takeLines(QByteArray& pending, const QByteArray& chunk, bool flushAll)
+{
+    pending.append(chunk);
+    
+    // Keep an incomplete trailing line (and any split UTF-8 sequence in it) for the next chunk
+    int end = flushAll ? pending.size() : pending.lastIndexOf('\n') + 1;
+    if (end <= 0) {
+        return QStringList();
+    }
+    
+    QStringList lines;
+    const QList<QByteArray> rawLines = pending.left(end).split('\n');
+    for (const QByteArray& rawLine : rawLines) {
+        QString line = QString::fromUtf8(rawLine).trimmed();
+        if (!line.isEmpty()) {
+            lines << line;
+        }
+    }
+    pending.remove(0, end);
+    return lines;
+}
+
+QString RendererOutputWorker::repeatKey(const QString& line)
+{
+    // Lines that only differ in numbers (frame counters, timestamps, addresses) count as repeats
+    static const QRegularExpression numbers("0x[0-9a-fA-F]+|\\d+(\\.\\d+)?");
+    QString key = line;
+    key.replace(numbers, "#");
+    return key;
+}
+
+void RendererOutputWorker::classify(const QStringList& standardOutput, const QStringList& standardError,
+                                    StreamState& state, RendererOutput& output)
+{
+    RendererLogClassifier& classifier = RendererLogClassifier::instance();
+    
+    // stdout is only counted; renderers report their problems on stderr
+    for (const QString& line : standardOutput) {
+        RendererOutput::Entry entry;
+        entry.text = line;
+        entry.channel = Channel::StandardOutput;
+        entry.severity = classifier.classify(line).severity;
+        admit(state, entry, output);
+    }
+    
+    bool errorsOnly = m_captureMode == CaptureMode::ErrorsOnly;
+    for (const QString& line : standardError) {
+        RendererLogClassifier::Classification classification = classifier.classify(line);
+        output.severity = qMax(output.severity, classification.severity);
+        if (errorsOnly && !classification.isError()) {
+            continue;
+        }
+        
+        RendererOutput::Entry entry;
+        entry.text = line;
+        entry.channel = classification.isError() ? Channel::Errors : Channel::Log;
+        entry.severity = classification.severity;
+        admit(state, entry, output);
+    }
+}
+
+void RendererOutputWorker::admit(StreamState& state, const RendererOutput::Entry& entry, RendererOutput& output)
+{
+    if (m_collapseRepeats) {
+        QString key = repeatKey(entry.text);
+        if (key == state.repeatKey && entry.channel == state.repeatEntry.channel) {
+            state.repeatEntry = entry;
+            state.repeatCount++;
+            m_collapsedLines++;
+            return;
+        }
+        summarizeRepeats(state, output);
+        state.repeatKey = key;
+        state.repeatEntry = entry;
+    }
+    
+    int budget = m_lineBudget;
+    if (budget > 0) {
+        qint64 now = m_clock.elapsed();
+        if (state.windowStartMs < 0 || now - state.windowStartMs >= SUMMARY_INTERVAL_MS) {
+            summarizeDropped(state, output);
+            state.windowStartMs = now;
+            state.windowLines = 0;
+        }
+        if (++state.windowLines > budget) {
+            state.windowDropped++;
+            m_droppedLines++;
+            return;
+        }
+    }
+    
+    output.entries.append(entry);
+}
+
+void RendererOutputWorker::summarizeRepeats(StreamState& state, RendererOutput& output)
+{
+    // Summaries bypass the budget; there is at most one per run and second.
+    // The run's latest line carries the count, so it reads on its own
+    if (state.repeatCount > 0) {
+        RendererOutput::Entry entry = state.repeatEntry;
+        entry.repeats = state.repeatCount;
+        output.entries.append(entry);
+        state.repeatCount = 0;
+    }
+}
+
+void RendererOutputWorker::summarizeDropped(StreamState& state, RendererOutput& output)
+{
+    if (state.windowDropped > 0) {
+        RendererOutput::Entry entry;
+        entry.text = QString("… %1 lines dropped (more than %2 lines per second)")
+                         .arg(state.windowDropped)
+                         .arg(m_lineBudget.load());
+        entry.channel = Channel::Log;
+        entry.severity = Severity::Warning;
+        output.entries.append(entry);
+        state.windowDropped = 0;
+    }
+}
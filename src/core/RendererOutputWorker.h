@@ -0,0 +1,159 @@
+#ifndef RENDEREROUTPUTWORKER_H
+#define RENDEREROUTPUTWORKER_H
+
+#include <QObject>
+#include <QString>
+#include <QStringList>
+#include <QByteArray>
+#include <QMap>
+#include <QVector>
+#include <QMetaType>
+#include <QTimer>
+#include <QElapsedTimer>
+#include <QFile>
+#include <QFileSystemWatcher>
+#include <atomic>
+#include "RendererLogClassifier.h"
+
+// Decoded renderer output of one chunk, in the order the renderer wrote it
+struct RendererOutput {
+    enum class Channel {
+        StandardOutput,     // stdout lines
+        Log,                // stderr lines that are normal operational logging, and budget notices
+        Errors              // stderr lines classified as error or fatal
+    };
+    
+    struct Entry {
+        QString text;
+        Channel channel = Channel::StandardOutput;
+        RendererLogClassifier::Severity severity = RendererLogClassifier::Severity::Info;
+        int repeats = 0;    // further copies of the line collapsed into this entry
+        
+        QString displayText() const { return repeats > 0 ? QString("%1 … ×%2").arg(text).arg(repeats) : text; }
+    };
+    
+    QVector<Entry> entries;
+    // Worst stderr line of the chunk, including collapsed and dropped ones
+    RendererLogClassifier::Severity severity = RendererLogClassifier::Severity::Debug;
+    
+    bool isEmpty() const { return entries.isEmpty(); }
+};
+Q_DECLARE_METATYPE(RendererOutput)
+
+// Tails the renderers' output files, then decodes and classifies (see
+// RendererLogClassifier) what they write, all off the GUI thread. A change
+// to a file is read right away and further ones at most every 100 ms; whole
+// lines come back via outputReady(), already filtered for the current capture mode.
+//
+// Noisy renderers are kept in check per output: runs of identical (or equal
+// up to numbers) lines collapse into a copy of the line carrying the repeat
+// count, and at most a budget of lines per second gets through, the rest is
+// only counted and reported by a notice in its place.
+class RendererOutputWorker : public QObject
+{
+    Q_OBJECT
+
+public:
+    enum class CaptureMode {
+        Off,            // stdout goes to /dev/null, stderr is only watched for the first output
+        ErrorsOnly,     // stdout goes to /dev/null, only error lines are reported
+        Full
+    };
+    
+    explicit RendererOutputWorker(QObject* parent = nullptr);
+    
+    static CaptureMode captureModeFromString(const QString& mode);
+    static QString captureModeToString(CaptureMode mode);
+    
+    // May be called from any thread; affects chunks processed from now on
+    void setCaptureMode(CaptureMode mode) { m_captureMode = mode; }
+    CaptureMode captureMode() const { return m_captureMode; }
+    
+    // May be called from any thread; a budget of 0 disables rate limiting
+    void setCollapseRepeats(bool collapse) { m_collapseRepeats = collapse; }
+    void setLineBudget(int linesPerSecond) { m_lineBudget = linesPerSecond; }
+    
+    // Overflow counters since startup
+    quint64 collapsedLines() const { return m_collapsedLines; }
+    quint64 droppedLines() const { return m_droppedLines; }
+
+public slots:
+    // Tail the output files of a renderer; an empty path is not tailed.
+    // skipExisting starts at the current end (adopted renderers)
+    void startTailing(const QString& screenRoot, const QString& standardOutputPath,
+                      const QString& standardErrorPath, bool skipExisting);
+    // Read and emit what is left, including a partial last line (renderer stopped or exited)
+    void stopTailing(const QString& screenRoot);
+
+private slots:
+    void emitSummaries();
+    void scheduleRead();
+    void onReadTimeout();
+
+signals:
+    void outputReady(const QString& screenRoot, const RendererOutput& output);
+    // The first bytes a renderer wrote, whatever the capture mode
+    void firstOutput(const QString& screenRoot);
+
+private:
+    struct TailFile {
+        QFile* file = nullptr;
+        qint64 released = 0;            // bytes already read and handed back to the file system
+    };
+    
+    struct Tail {
+        TailFile standardOutput;
+        TailFile standardError;
+        bool seenOutput = false;
+    };
+    
+    struct PendingBytes {
+        QByteArray standardOutput;
+        QByteArray standardError;
+    };
+    
+    using Channel = RendererOutput::Channel;
+    using Severity = RendererLogClassifier::Severity;
+    
+    // Repeat and budget bookkeeping of one output
+    struct StreamState {
+        QString repeatKey;
+        RendererOutput::Entry repeatEntry;  // latest line of the current run
+        int repeatCount = 0;            // lines swallowed since the last shown one
+        qint64 windowStartMs = -1;
+        int windowLines = 0;
+        int windowDropped = 0;
+        
+        bool hasSummary() const { return repeatCount > 0 || windowDropped > 0; }
+    };
+    
+    QFile* openTail(const QString& path, bool skipExisting);
+    static bool readNew(TailFile& tail, bool skip, QByteArray& data);
+    void readTail(const QString& screenRoot, Tail& tail);
+    void processOutput(const QString& screenRoot, const QByteArray& standardOutput, const QByteArray& standardError);
+    void flush(const QString& screenRoot);
+    static QStringList takeLines(QByteArray& pending, const QByteArray& chunk, bool flushAll);
+    static QString repeatKey(const QString& line);
+    void classify(const QStringList& standardOutput, const QStringList& standardError,
+                  StreamState& state, RendererOutput& output);
+    void admit(StreamState& state, const RendererOutput::Entry& entry, RendererOutput& output);
+    void summarizeRepeats(StreamState& state, RendererOutput& output);
+    void summarizeDropped(StreamState& state, RendererOutput& output);
+    
+    QMap<QString, Tail> m_tails;
+    QFileSystemWatcher* m_watcher;      // created on the worker thread
+    QTimer* m_readTimer;
+    bool m_readPending;                 // a change came in while the timer ran
+    bool m_polling;                     // a file could not be watched, so the timer keeps reading
+    QMap<QString, PendingBytes> m_pending;
+    QMap<QString, StreamState> m_streams;
+    QTimer* m_summaryTimer;
+    QElapsedTimer m_clock;
+    std::atomic<CaptureMode> m_captureMode;
+    std::atomic<bool> m_collapseRepeats;
+    std::atomic<int> m_lineBudget;
+    std::atomic<quint64> m_collapsedLines;
+    std::atomic<quint64> m_droppedLines;
+};
+
+#endif // RENDEREROUTPUTWORKER_H
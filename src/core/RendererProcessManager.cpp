@@ -0,0 +1,870 @@
+#include "RendererProcessManager.h"
+#include <QCryptographicHash>
+#include <QDir>
+#include <QElapsedTimer>
+#include <QFile>
+#include <QFileInfo>
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QLoggingCategory>
+#include <QSaveFile>
+#include <QSocketNotifier>
+#include <QStandardPaths>
+#include <QThread>
+#include <cerrno>
+#include <poll.h>
+#include <signal.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+Q_LOGGING_CATEGORY(rendererProcesses, "app.rendererProcesses")
+
+namespace {
+// How long renderers from a previous session wait to be claimed by a
+// matching launch (startup restore, playlist) before they are terminated
+constexpr int ORPHAN_GRACE_MS = 60000;
+
+// How long renderers still exiting get when the manager itself goes away
+constexpr int SHUTDOWN_GRACE_MS = 5000;
+}
+
+RendererProcessManager::RendererProcessManager(const QString& rendererName, QObject* parent)
+    : QObject(parent)
+    , m_rendererName(rendererName)
+    , m_orphanGraceTimer(new QTimer(this))
+    , m_outputThread(new QThread(this))
+    , m_outputWorker(new RendererOutputWorker)
+    , m_captureMode(RendererOutputWorker::CaptureMode::Full)
+{
+    // Output files are tailed, decoded and classified on a worker thread
+    m_outputThread->setObjectName(rendererName + "-output");
+    m_outputWorker->moveToThread(m_outputThread);
+    connect(m_outputThread, &QThread::finished, m_outputWorker, &QObject::deleteLater);
+    connect(m_outputWorker, &RendererOutputWorker::outputReady, this, &RendererProcessManager::outputReady);
+    connect(m_outputWorker, &RendererOutputWorker::firstOutput, this, &RendererProcessManager::firstOutput);
+    m_outputThread->start();
+    
+    m_orphanGraceTimer->setSingleShot(true);
+    m_orphanGraceTimer->setInterval(ORPHAN_GRACE_MS);
+    connect(m_orphanGraceTimer, &QTimer::timeout, this, [this]() {
+        if (!m_orphans.isEmpty()) {
+            qCInfo(rendererProcesses) << "Terminating" << m_orphans.size() << "unclaimed" << m_rendererName
+                                      << "renderer(s) from a previous session";
+            terminateOrphans();
+        }
+    });
+    
+    recoverOrphans();
+}
+
+RendererProcessManager::~RendererProcessManager()
+{
+    stopAll();
+    
+    // Nothing is left to keep responsive, so renderers still exiting get a
+    // last moment here before they are killed. Orphans without a pidfd were
+    // sent SIGTERM and are left to it
+    const QList<Termination*> terminations = m_terminations;
+    m_terminations.clear();
+    QElapsedTimer shutdown;
+    shutdown.start();
+    for (Termination* termination : terminations) {
+        int remaining = static_cast<int>(qMax<qint64>(0, SHUTDOWN_GRACE_MS - shutdown.elapsed()));
+        bool exited = termination->process
+            ? termination->process->waitForFinished(remaining)
+            : termination->pidfd < 0 || waitForExit(termination->pid, termination->pidfd, remaining);
+        if (!exited) {
+            Renderer renderer;
+            renderer.process = termination->process;
+            renderer.pid = termination->pid;
+            renderer.pidfd = termination->pidfd;
+            signalRenderer(renderer, SIGKILL);
+        }
+        if (termination->process) {
+            termination->process->disconnect(this);
+        }
+        if (termination->pidfd >= 0) {
+            ::close(termination->pidfd);
+        }
+        delete termination;
+    }
+    
+    m_outputThread->quit();
+    m_outputThread->wait();
+}
+
+QString RendererProcessManager::screenFromArgs(const QStringList& args)
+{
+    QString screenRoot;
+    for (int i = 0; i + 1 < args.size(); ++i) {
+        if (args[i] == "--screen-root" || args[i] == "--output") {
+            screenRoot = args[i + 1];
+        }
+    }
+    return screenRoot;
+}
+
+QString RendererProcessManager::displayName(const QString& screenRoot)
+{
+    return screenRoot.isEmpty() ? QString("default output") : screenRoot;
+}
+
+QString RendererProcessManager::fingerprint(const QString& program, const QStringList& args)
+{
+    // Only the binary name is hashed: argv[0] may or may not be the resolved path
+    QCryptographicHash hash(QCryptographicHash::Sha1);
+    hash.addData(QFileInfo(program).fileName().toUtf8());
+    for (const QString& arg : args) {
+        hash.addData(QByteArray(1, '\0'));
+        hash.addData(arg.toUtf8());
+    }
+    return QString::fromLatin1(hash.result().toHex());
+}
+
+bool RendererProcessManager::start(const QString& screenRoot, const QString& wallpaperId,
+                                   const QString& program, const QStringList& args,
+                                   const QString& workingDirectory, const QProcessEnvironment& environment,
+                                   int startTimeoutMs)
+{
+    QString launchFingerprint = fingerprint(program, args);
+    
+    // A renderer from the previous session already shows exactly this launch
+    if (adoptOrphan(screenRoot, wallpaperId, launchFingerprint)) {
+        return true;
+    }
+    
+    // Otherwise whatever the previous session left on this output has to go.
+    // Neither waits for the old renderer to exit
+    terminateOrphan(screenRoot);
+    
+    // Only the renderer on this output is replaced, the others keep running
+    stop(screenRoot);
+
+    QProcess* process = new QProcess(this);
+    if (!workingDirectory.isEmpty()) {
+        process->setWorkingDirectory(workingDirectory);
+    }
+    process->setProcessEnvironment(environment);
+    
+    // Output goes to files that outlive the GUI; stdout nobody wants to see
+    // is not even written. stderr always is, it tells when the renderer first
+    // wrote something. The renderer appends, so the worker can release what
+    // it has read while the renderer runs
+    removeOutputFiles(screenRoot);
+    QDir().mkpath(QFileInfo(pidFilePath()).absolutePath());
+    process->setStandardOutputFile(m_captureMode == RendererOutputWorker::CaptureMode::Full
+                                   ? outputFilePath(screenRoot, "stdout") : QProcess::nullDevice(),
+                                   QIODevice::Append);
+    process->setStandardErrorFile(outputFilePath(screenRoot, "stderr"), QIODevice::Append);
+    connectProcess(screenRoot, process);
+
+    Renderer renderer;
+    renderer.process = process;
+    renderer.wallpaperId = wallpaperId;
+    renderer.fingerprint = launchFingerprint;
+    m_renderers.insert(screenRoot, renderer);
+
+    process->start(program, args);
+
+    if (!process->waitForStarted(startTimeoutMs)) {
+        m_lastError = process->errorString();
+        qCWarning(rendererProcesses) << m_rendererName << "failed to start on" << displayName(screenRoot) << ":" << m_lastError;
+        m_renderers.remove(screenRoot);
+        process->disconnect(this);
+        process->deleteLater();
+        return false;
+    }
+    
+    auto it = m_renderers.find(screenRoot);
+    if (it != m_renderers.end() && it->process == process) {
+        it->pid = process->processId();
+        readProcessStartTime(it->pid, it->startTime);
+        openOutputFiles(screenRoot, false);
+    }
+    writePidFile();
+
+    m_lastError.clear();
+    qCInfo(rendererProcesses) << m_rendererName << "started on" << displayName(screenRoot)
+                              << "pid" << process->processId() << "wallpaper" << wallpaperId;
+    emit rendererStarted(screenRoot, wallpaperId);
+    return true;
+}
+
+bool RendererProcessManager::stop(const QString& screenRoot, int terminateTimeoutMs)
+{
+    auto it = m_renderers.find(screenRoot);
+    if (it == m_renderers.end()) {
+        return false;
+    }
+
+    Renderer renderer = it.value();
+    m_renderers.erase(it);
+    writePidFile();
+    closeOutputFiles(screenRoot);
+    
+    // The renderer is off the books now; it exits in the background
+    Termination* termination = new Termination;
+    termination->process = renderer.process;
+    if (renderer.process) {
+        // Disconnect first so a deliberate stop is not reported as an unexpected exit
+        renderer.process->disconnect(this);
+        termination->pid = renderer.process->processId();
+    } else {
+        // Adopted renderer: not our child, so it is signalled and watched through its pidfd
+        if (renderer.exitNotifier) {
+            renderer.exitNotifier->setEnabled(false);
+            renderer.exitNotifier->deleteLater();
+        }
+        termination->pid = renderer.pid;
+        termination->startTime = renderer.startTime;
+        termination->pidfd = renderer.pidfd;
+    }
+    beginTermination(termination, terminateTimeoutMs);
+
+    qCDebug(rendererProcesses) << m_rendererName << "stopping on" << displayName(screenRoot);
+    emit rendererStopped(screenRoot, renderer.wallpaperId);
+    return true;
+}
+
+void RendererProcessManager::stopAll(int terminateTimeoutMs)
+{
+    const QStringList activeScreens = m_renderers.keys();
+    for (const QString& screenRoot : activeScreens) {
+        stop(screenRoot, terminateTimeoutMs);
+    }
+}
+
+bool RendererProcessManager::pause(const QString& screenRoot)
+{
+    auto it = m_renderers.find(screenRoot);
+    if (it == m_renderers.end() || it->paused) {
+        return false;
+    }
+    if (it->process && it->process->state() != QProcess::Running) {
+        return false;
+    }
+    
+    if (!signalRenderer(it.value(), SIGSTOP)) {
+        qCWarning(rendererProcesses) << "Failed to pause" << m_rendererName << "on" << displayName(screenRoot);
+        return false;
+    }
+    
+    it->paused = true;
+    qCDebug(rendererProcesses) << m_rendererName << "paused on" << displayName(screenRoot);
+    return true;
+}
+
+bool RendererProcessManager::resume(const QString& screenRoot)
+{
+    auto it = m_renderers.find(screenRoot);
+    if (it == m_renderers.end() || !it->paused) {
+        return false;
+    }
+    
+    signalRenderer(it.value(), SIGCONT);
+    it->paused = false;
+    qCDebug(rendererProcesses) << m_rendererName << "resumed on" << displayName(screenRoot);
+    return true;
+}
+
+void RendererProcessManager::setCaptureMode(RendererOutputWorker::CaptureMode mode)
+{
+    if (m_captureMode == mode) {
+        return;
+    }
+    
+    m_captureMode = mode;
+    m_outputWorker->setCaptureMode(mode);
+    qCDebug(rendererProcesses) << m_rendererName << "output capture:" << RendererOutputWorker::captureModeToString(mode);
+}
+
+void RendererProcessManager::setOutputLimits(bool collapseRepeats, int lineBudget)
+{
+    m_outputWorker->setCollapseRepeats(collapseRepeats);
+    m_outputWorker->setLineBudget(lineBudget);
+}
+
+void RendererProcessManager::pauseAll()
+{
+    const QStringList activeScreens = m_renderers.keys();
+    for (const QString& screenRoot : activeScreens) {
+        pause(screenRoot);
+    }
+}
+
+void RendererProcessManager::resumeAll()
+{
+    const QStringList activeScreens = m_renderers.keys();
+    for (const QString& screenRoot : activeScreens) {
+        resume(screenRoot);
+    }
+}
+
+bool RendererProcessManager::isPaused(const QString& screenRoot) const
+{
+    return m_renderers.value(screenRoot).paused;
+}
+
+bool RendererProcessManager::isRunning(const QString& screenRoot) const
+{
+    auto it = m_renderers.constFind(screenRoot);
+    if (it == m_renderers.constEnd()) {
+        return false;
+    }
+    // Adopted renderers are dropped as soon as their pidfd reports the exit
+    return !it->process || it->process->state() == QProcess::Running;
+}
+
+bool RendererProcessManager::isAnyRunning() const
+{
+    for (const Renderer& renderer : m_renderers) {
+        if (!renderer.process || renderer.process->state() == QProcess::Running) {
+            return true;
+        }
+    }
+    return false;
+}
+
+QStringList RendererProcessManager::screens() const
+{
+    return m_renderers.keys();
+}
+
+QString RendererProcessManager::wallpaperOn(const QString& screenRoot) const
+{
+    return m_renderers.value(screenRoot).wallpaperId;
+}
+
+QStringList RendererProcessManager::screensShowing(const QString& wallpaperId) const
+{
+    QStringList result;
+    for (auto it = m_renderers.constBegin(); it != m_renderers.constEnd(); ++it) {
+        if (it.value().wallpaperId == wallpaperId) {
+            result << it.key();
+        }
+    }
+    return result;
+}
+
+bool RendererProcessManager::hasRenderer(const QString& screenRoot) const
+{
+    return m_renderers.contains(screenRoot);
+}
+
+bool RendererProcessManager::isAdopted(const QString& screenRoot) const
+{
+    auto it = m_renderers.constFind(screenRoot);
+    return it != m_renderers.constEnd() && !it->process;
+}
+
+QProcess* RendererProcessManager::process(const QString& screenRoot) const
+{
+    return m_renderers.value(screenRoot).process;
+}
+
+qint64 RendererProcessManager::processId(const QString& screenRoot) const
+{
+    auto it = m_renderers.constFind(screenRoot);
+    if (it == m_renderers.constEnd()) {
+        return 0;
+    }
+    return it->process ? it->process->processId() : it->pid;
+}
+
+QStringList RendererProcessManager::orphanScreens() const
+{
+    return m_orphans.keys();
+}
+
+bool RendererProcessManager::terminateOrphan(const QString& screenRoot, int terminateTimeoutMs)
+{
+    Orphan orphan;
+    int pidfd = -1;
+    if (!takeOrphan(screenRoot, orphan, pidfd)) {
+        return false;
+    }
+    
+    qCInfo(rendererProcesses) << "Terminating stale" << m_rendererName << "on" << displayName(screenRoot)
+                              << "pid" << orphan.pid << "wallpaper" << orphan.wallpaperId;
+    
+    Termination* termination = new Termination;
+    termination->pid = orphan.pid;
+    termination->startTime = orphan.startTime;
+    termination->pidfd = pidfd;
+    beginTermination(termination, terminateTimeoutMs);
+    return true;
+}
+
+void RendererProcessManager::terminateOrphans(int terminateTimeoutMs)
+{
+    m_orphanGraceTimer->stop();
+    
+    const QStringList orphans = m_orphans.keys();
+    for (const QString& screenRoot : orphans) {
+        terminateOrphan(screenRoot, terminateTimeoutMs);
+    }
+}
+
+bool RendererProcessManager::takeOrphan(const QString& screenRoot, Orphan& orphan, int& pidfd)
+{
+    auto it = m_orphans.find(screenRoot);
+    if (it == m_orphans.end()) {
+        return false;
+    }
+    
+    orphan = it.value();
+    m_orphans.erase(it);
+    writePidFile();
+    
+    // Whatever it still writes goes to an unlinked file
+    removeOutputFiles(screenRoot);
+    
+    // Pin the process before signalling it, then make sure it is still the renderer we recorded
+    pidfd = openPidfd(orphan.pid);
+    quint64 startTime = 0;
+    if (!readProcessStartTime(orphan.pid, startTime) || startTime != orphan.startTime) {
+        if (pidfd >= 0) {
+            ::close(pidfd);
+            pidfd = -1;
+        }
+        return false;
+    }
+    return true;
+}
+
+void RendererProcessManager::beginTermination(Termination* termination, int terminateTimeoutMs)
+{
+    m_terminations.append(termination);
+    
+    // A stopped process cannot handle SIGTERM, let it continue first
+    Renderer renderer;
+    renderer.process = termination->process;
+    renderer.pid = termination->pid;
+    renderer.pidfd = termination->pidfd;
+    signalRenderer(renderer, SIGCONT);
+    signalRenderer(renderer, SIGTERM);
+    
+    termination->timer = new QTimer(this);
+    termination->timer->setSingleShot(true);
+    connect(termination->timer, &QTimer::timeout, this, [this, termination]() {
+        onTerminationTimeout(termination);
+    });
+    termination->timer->start(terminateTimeoutMs);
+    
+    // Our own renderers report their exit through QProcess, others through
+    // the pidfd; without one the exit is only checked when the timer fires
+    if (termination->process) {
+        connect(termination->process, QOverload<int, QProcess::ExitStatus>::of(&QProcess::finished),
+                this, [this, termination]() {
+            finishTermination(termination);
+        });
+        if (termination->process->state() == QProcess::NotRunning) {
+            finishTermination(termination);
+        }
+    } else if (termination->pidfd >= 0) {
+        termination->exitNotifier = new QSocketNotifier(termination->pidfd, QSocketNotifier::Read, this);
+        connect(termination->exitNotifier, &QSocketNotifier::activated, this, [this, termination]() {
+            finishTermination(termination);
+        });
+    }
+}
+
+void RendererProcessManager::onTerminationTimeout(Termination* termination)
+{
+    // Without a pidfd the pid is only signalled while it still names the orphan
+    quint64 startTime = 0;
+    bool running = termination->process ? termination->process->state() != QProcess::NotRunning
+        : termination->pidfd >= 0 ? !waitForExit(termination->pid, termination->pidfd, 0)
+        : readProcessStartTime(termination->pid, startTime) && startTime == termination->startTime;
+    
+    if (running && !termination->killed) {
+        qCWarning(rendererProcesses) << m_rendererName << "pid" << termination->pid
+                                     << "ignored SIGTERM, killing it";
+        Renderer renderer;
+        renderer.process = termination->process;
+        renderer.pid = termination->pid;
+        renderer.pidfd = termination->pidfd;
+        signalRenderer(renderer, SIGKILL);
+        termination->killed = true;
+        
+        if (termination->process || termination->pidfd >= 0) {
+            termination->timer->start(3000);
+            return;
+        }
+    } else if (running) {
+        qCWarning(rendererProcesses) << m_rendererName << "pid" << termination->pid
+                                     << "did not exit after SIGKILL";
+    }
+    finishTermination(termination);
+}
+
+void RendererProcessManager::finishTermination(Termination* termination)
+{
+    if (!m_terminations.removeOne(termination)) {
+        return;
+    }
+    
+    if (termination->exitNotifier) {
+        termination->exitNotifier->setEnabled(false);
+        termination->exitNotifier->deleteLater();
+    }
+    termination->timer->stop();
+    termination->timer->deleteLater();
+    if (termination->process) {
+        termination->process->disconnect(this);
+        termination->process->deleteLater();
+    }
+    if (termination->pidfd >= 0) {
+        ::close(termination->pidfd);
+    }
+    
+    qCDebug(rendererProcesses) << m_rendererName << "pid" << termination->pid << "is gone";
+    delete termination;
+}
+
+QString RendererProcessManager::pidFilePath() const
+{
+    QString cachePath = QStandardPaths::writableLocation(QStandardPaths::CacheLocation);
+    if (cachePath.isEmpty()) {
+        cachePath = QStandardPaths::writableLocation(QStandardPaths::GenericCacheLocation);
+    }
+    
+    if (cachePath.isEmpty()) {
+        cachePath = QStandardPaths::writableLocation(QStandardPaths::HomeLocation) +
+                  "/.cache/wallpaperengine-gui";
+    } else {
+        cachePath += "/wallpaperengine-gui";
+    }
+    
+    return cachePath + "/renderers/" + m_rendererName + ".json";
+}
+
+void RendererProcessManager::connectProcess(const QString& screenRoot, QProcess* process)
+{
+    connect(process, QOverload<int, QProcess::ExitStatus>::of(&QProcess::finished),
+            this, [this, screenRoot, process](int exitCode, QProcess::ExitStatus exitStatus) {
+        auto it = m_renderers.find(screenRoot);
+        if (it == m_renderers.end() || it->process != process) {
+            return;
+        }
+
+        QString wallpaperId = it->wallpaperId;
+        closeOutputFiles(screenRoot);
+        m_renderers.erase(it);
+        process->deleteLater();
+        writePidFile();
+
+        emit processFinished(screenRoot, wallpaperId, exitCode, exitStatus);
+        emit rendererStopped(screenRoot, wallpaperId);
+    });
+
+    connect(process, &QProcess::errorOccurred, this, [this, screenRoot, process](QProcess::ProcessError error) {
+        if (m_renderers.value(screenRoot).process != process) {
+            return;
+        }
+        emit processError(screenRoot, m_renderers.value(screenRoot).wallpaperId, error);
+    });
+}
+
+bool RendererProcessManager::adoptOrphan(const QString& screenRoot, const QString& wallpaperId, const QString& fingerprint)
+{
+    auto it = m_orphans.find(screenRoot);
+    if (it == m_orphans.end() || it->wallpaperId != wallpaperId || it->fingerprint != fingerprint) {
+        return false;
+    }
+    
+    Orphan orphan = it.value();
+    
+    // The pidfd keeps referring to this exact process even if the pid is reused later;
+    // re-check the start time after opening it to close the window before that
+    int pidfd = openPidfd(orphan.pid);
+    quint64 startTime = 0;
+    if (pidfd < 0 || !readProcessStartTime(orphan.pid, startTime) || startTime != orphan.startTime) {
+        qCDebug(rendererProcesses) << "Cannot adopt" << m_rendererName << "pid" << orphan.pid
+                                   << (pidfd < 0 ? "(pidfd unavailable)" : "(process changed)");
+        if (pidfd >= 0) {
+            ::close(pidfd);
+        }
+        return false;
+    }
+    
+    m_orphans.erase(it);
+    stop(screenRoot);
+    
+    Renderer renderer;
+    renderer.wallpaperId = wallpaperId;
+    renderer.pid = orphan.pid;
+    renderer.startTime = orphan.startTime;
+    renderer.fingerprint = fingerprint;
+    renderer.pidfd = pidfd;
+    renderer.exitNotifier = new QSocketNotifier(pidfd, QSocketNotifier::Read, this);
+    connect(renderer.exitNotifier, &QSocketNotifier::activated, this, [this, screenRoot]() {
+        onAdoptedRendererExited(screenRoot);
+    });
+    
+    // Output the previous session already showed, or missed while it was gone, is skipped
+    openOutputFiles(screenRoot, true);
+    m_renderers.insert(screenRoot, renderer);
+    writePidFile();
+    
+    // A stopped renderer may have been left behind by the battery profile
+    signalRenderer(renderer, SIGCONT);
+    
+    m_lastError.clear();
+    qCInfo(rendererProcesses) << "Adopted running" << m_rendererName << "on" << displayName(screenRoot)
+                              << "pid" << orphan.pid << "wallpaper" << wallpaperId;
+    emit rendererStarted(screenRoot, wallpaperId);
+    return true;
+}
+
+void RendererProcessManager::onAdoptedRendererExited(const QString& screenRoot)
+{
+    auto it = m_renderers.find(screenRoot);
+    if (it == m_renderers.end() || it->process) {
+        return;
+    }
+    
+    Renderer renderer = it.value();
+    m_renderers.erase(it);
+    releaseRenderer(renderer);
+    closeOutputFiles(screenRoot);
+    writePidFile();
+    
+    // The exit status of a process we did not spawn cannot be collected
+    qCInfo(rendererProcesses) << "Adopted" << m_rendererName << "on" << displayName(screenRoot) << "exited";
+    emit processFinished(screenRoot, renderer.wallpaperId, 0, QProcess::NormalExit);
+    emit rendererStopped(screenRoot, renderer.wallpaperId);
+}
+
+void RendererProcessManager::releaseRenderer(Renderer& renderer)
+{
+    if (renderer.exitNotifier) {
+        renderer.exitNotifier->setEnabled(false);
+        renderer.exitNotifier->deleteLater();
+        renderer.exitNotifier = nullptr;
+    }
+    if (renderer.pidfd >= 0) {
+        ::close(renderer.pidfd);
+        renderer.pidfd = -1;
+    }
+}
+
+QString RendererProcessManager::outputFilePath(const QString& screenRoot, const QString& channel) const
+{
+    // Screen roots are output names or X root ids, not necessarily file name safe
+    QByteArray screenKey = QCryptographicHash::hash(screenRoot.toUtf8(), QCryptographicHash::Sha1).toHex().left(12);
+    return QFileInfo(pidFilePath()).absolutePath() + "/" + m_rendererName + "-" +
+           QString::fromLatin1(screenKey) + "." + channel + ".log";
+}
+
+void RendererProcessManager::removeOutputFiles(const QString& screenRoot) const
+{
+    QFile::remove(outputFilePath(screenRoot, "stdout"));
+    QFile::remove(outputFilePath(screenRoot, "stderr"));
+}
+
+void RendererProcessManager::openOutputFiles(const QString& screenRoot, bool skipExisting)
+{
+    // The capture mode an adopted renderer was started with is unknown, so
+    // both of its files are tailed; one it does not write just stays empty
+    bool tailOutput = skipExisting || m_captureMode == RendererOutputWorker::CaptureMode::Full;
+    QMetaObject::invokeMethod(m_outputWorker, "startTailing", Qt::QueuedConnection,
+                              Q_ARG(QString, screenRoot),
+                              Q_ARG(QString, tailOutput ? outputFilePath(screenRoot, "stdout") : QString()),
+                              Q_ARG(QString, outputFilePath(screenRoot, "stderr")),
+                              Q_ARG(bool, skipExisting));
+}
+
+void RendererProcessManager::closeOutputFiles(const QString& screenRoot)
+{
+    // The worker still reads the last lines through its open handles, and a
+    // renderer started on this output next writes to fresh files
+    QMetaObject::invokeMethod(m_outputWorker, "stopTailing", Qt::QueuedConnection, Q_ARG(QString, screenRoot));
+    removeOutputFiles(screenRoot);
+}
+
+bool RendererProcessManager::signalRenderer(const Renderer& renderer, int signal) const
+{
+#ifdef SYS_pidfd_send_signal
+    if (renderer.pidfd >= 0) {
+        return ::syscall(SYS_pidfd_send_signal, renderer.pidfd, signal, nullptr, 0) == 0;
+    }
+#endif
+    qint64 pid = renderer.process ? renderer.process->processId() : renderer.pid;
+    if (pid <= 0) {
+        return false;
+    }
+    return ::kill(static_cast<pid_t>(pid), signal) == 0;
+}
+
+bool RendererProcessManager::waitForExit(qint64 pid, int pidfd, int timeoutMs)
+{
+    if (pidfd >= 0) {
+        // A pidfd becomes readable once the process has exited
+        pollfd descriptor = { pidfd, POLLIN, 0 };
+        int result;
+        do {
+            result = ::poll(&descriptor, 1, timeoutMs);
+        } while (result < 0 && errno == EINTR);
+        return result > 0;
+    }
+    
+    // No pidfd: poll for the pid to disappear (orphans are reaped by init, not by us)
+    QElapsedTimer timer;
+    timer.start();
+    while (::kill(static_cast<pid_t>(pid), 0) == 0 || errno != ESRCH) {
+        if (timer.elapsed() >= timeoutMs) {
+            return false;
+        }
+        QThread::msleep(50);
+    }
+    return true;
+}
+
+bool RendererProcessManager::readProcessStartTime(qint64 pid, quint64& startTime)
+{
+    QFile statFile(QString("/proc/%1/stat").arg(pid));
+    if (!statFile.open(QIODevice::ReadOnly)) {
+        return false;
+    }
+    
+    // Fields after the command name start at "state" (field 3); starttime is field 22
+    QByteArray data = statFile.readAll();
+    int closeParen = data.lastIndexOf(')');
+    if (closeParen < 0) {
+        return false;
+    }
+    
+    QList<QByteArray> fields = data.mid(closeParen + 2).split(' ');
+    if (fields.size() < 20) {
+        return false;
+    }
+    
+    startTime = fields[19].toULongLong();
+    return true;
+}
+
+QString RendererProcessManager::readProcessFingerprint(qint64 pid)
+{
+    QFile cmdlineFile(QString("/proc/%1/cmdline").arg(pid));
+    if (!cmdlineFile.open(QIODevice::ReadOnly)) {
+        return QString();
+    }
+    
+    QList<QByteArray> argv = cmdlineFile.readAll().split('\0');
+    if (!argv.isEmpty() && argv.last().isEmpty()) {
+        argv.removeLast();
+    }
+    if (argv.isEmpty()) {
+        return QString();
+    }
+    
+    QStringList args;
+    for (int i = 1; i < argv.size(); ++i) {
+        args << QString::fromUtf8(argv[i]);
+    }
+    return fingerprint(QString::fromUtf8(argv.first()), args);
+}
+
+int RendererProcessManager::openPidfd(qint64 pid)
+{
+#ifdef SYS_pidfd_open
+    return static_cast<int>(::syscall(SYS_pidfd_open, static_cast<pid_t>(pid), 0));
+#else
+    Q_UNUSED(pid)
+    errno = ENOSYS;
+    return -1;
+#endif
+}
+
+void RendererProcessManager::recoverOrphans()
+{
+    QFile pidFile(pidFilePath());
+    if (!pidFile.open(QIODevice::ReadOnly)) {
+        return;
+    }
+    
+    QJsonArray entries = QJsonDocument::fromJson(pidFile.readAll()).object().value("renderers").toArray();
+    pidFile.close();
+    
+    for (const QJsonValue& value : entries) {
+        QJsonObject entry = value.toObject();
+        Orphan orphan;
+        QString screenRoot = entry.value("screen").toString();
+        orphan.wallpaperId = entry.value("wallpaper_id").toString();
+        orphan.pid = static_cast<qint64>(entry.value("pid").toDouble());
+        orphan.startTime = entry.value("start_time").toString().toULongLong();
+        orphan.fingerprint = entry.value("fingerprint").toString();
+        
+        // Gone, or the pid now belongs to something else: only its output files are left
+        quint64 startTime = 0;
+        if (orphan.pid <= 0 || !readProcessStartTime(orphan.pid, startTime) || startTime != orphan.startTime) {
+            removeOutputFiles(screenRoot);
+            continue;
+        }
+        
+        // Same process but no longer running the recorded command line: leave it alone
+        if (readProcessFingerprint(orphan.pid) != orphan.fingerprint) {
+            qCDebug(rendererProcesses) << "Pid" << orphan.pid << "no longer matches its recorded" << m_rendererName << "launch";
+            removeOutputFiles(screenRoot);
+            continue;
+        }
+        
+        qCInfo(rendererProcesses) << "Found" << m_rendererName << "from a previous session on" << displayName(screenRoot)
+                                  << "pid" << orphan.pid << "wallpaper" << orphan.wallpaperId;
+        m_orphans.insert(screenRoot, orphan);
+    }
+    
+    if (!m_orphans.isEmpty()) {
+        m_orphanGraceTimer->start();
+    }
+    
+    // Orphans stay in the pidfile until they are adopted or terminated
+    writePidFile();
+}
+
+void RendererProcessManager::writePidFile() const
+{
+    QJsonArray entries;
+    for (auto it = m_renderers.constBegin(); it != m_renderers.constEnd(); ++it) {
+        if (it->pid <= 0) {
+            continue;
+        }
+        QJsonObject entry;
+        entry["screen"] = it.key();
+        entry["wallpaper_id"] = it->wallpaperId;
+        entry["pid"] = it->pid;
+        entry["start_time"] = QString::number(it->startTime);
+        entry["fingerprint"] = it->fingerprint;
+        entries.append(entry);
+    }
+    for (auto it = m_orphans.constBegin(); it != m_orphans.constEnd(); ++it) {
+        QJsonObject entry;
+        entry["screen"] = it.key();
+        entry["wallpaper_id"] = it->wallpaperId;
+        entry["pid"] = it->pid;
+        entry["start_time"] = QString::number(it->startTime);
+        entry["fingerprint"] = it->fingerprint;
+        entries.append(entry);
+    }
+    
+    QString filePath = pidFilePath();
+    if (entries.isEmpty()) {
+        QFile::remove(filePath);
+        return;
+    }
+    
+    QDir().mkpath(QFileInfo(filePath).absolutePath());
+    
+    QJsonObject root;
+    root["renderers"] = entries;
+    
+    QSaveFile file(filePath);
+    if (!file.open(QIODevice::WriteOnly)) {
+        qCWarning(rendererProcesses) << "Failed to write pidfile" << filePath << file.errorString();
+        return;
+    }
+    file.write(QJsonDocument(root).toJson(QJsonDocument::Indented));
+    file.commit();
+}
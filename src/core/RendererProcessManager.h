@@ -0,0 +1,159 @@
+#ifndef RENDERERPROCESSMANAGER_H
+#define RENDERERPROCESSMANAGER_H
+
+#include <QObject>
+#include <QProcess>
+#include <QProcessEnvironment>
+#include <QString>
+#include <QStringList>
+#include <QMap>
+#include <QTimer>
+#include <QThread>
+#include "RendererOutputWorker.h"
+
+class QSocketNotifier;
+
+// Owns the renderer processes of one backend, one process per output.
+// Outputs are keyed by screen root; an empty key stands for the renderer's
+// default output (no --screen-root / --output given).
+//
+// Running renderers are recorded in a pidfile together with a fingerprint of
+// their command line. If the GUI dies without stopping them, the next instance
+// adopts a renderer whose output, wallpaper and fingerprint match the launch it
+// is about to make instead of starting a second one; leftovers that are not
+// claimed within a grace period are terminated. Renderer output is written to
+// files next to the pidfile and tailed from there by the output worker: a
+// renderer writing to a pipe would die of SIGPIPE with the GUI and leave
+// nothing to adopt. Stopping never waits for a renderer to exit; it gets
+// SIGTERM, and SIGKILL if it is still there when the timeout runs out.
+class RendererProcessManager : public QObject
+{
+    Q_OBJECT
+
+public:
+    explicit RendererProcessManager(const QString& rendererName, QObject* parent = nullptr);
+    ~RendererProcessManager();
+
+    // Extract the output a command line targets (last --screen-root or --output)
+    static QString screenFromArgs(const QStringList& args);
+    static QString displayName(const QString& screenRoot);
+    static QString fingerprint(const QString& program, const QStringList& args);
+
+    // Process control per output
+    bool start(const QString& screenRoot, const QString& wallpaperId,
+               const QString& program, const QStringList& args,
+               const QString& workingDirectory, const QProcessEnvironment& environment,
+               int startTimeoutMs = 5000);
+    bool stop(const QString& screenRoot, int terminateTimeoutMs = 5000);
+    void stopAll(int terminateTimeoutMs = 5000);
+
+    // Suspend/continue a renderer without tearing it down (SIGSTOP/SIGCONT)
+    bool pause(const QString& screenRoot);
+    bool resume(const QString& screenRoot);
+    void pauseAll();
+    void resumeAll();
+    bool isPaused(const QString& screenRoot) const;
+    
+    // How much renderer output is captured. The /dev/null redirection of the
+    // off and errors-only modes takes effect on the next start of a renderer.
+    void setCaptureMode(RendererOutputWorker::CaptureMode mode);
+    RendererOutputWorker::CaptureMode captureMode() const { return m_captureMode; }
+    
+    // Repeat collapsing and per-second line budget of the output worker
+    void setOutputLimits(bool collapseRepeats, int lineBudget);
+    quint64 collapsedOutputLines() const { return m_outputWorker->collapsedLines(); }
+    quint64 droppedOutputLines() const { return m_outputWorker->droppedLines(); }
+    
+    // State queries
+    bool isRunning(const QString& screenRoot) const;
+    bool isAnyRunning() const;
+    QStringList screens() const;
+    QString wallpaperOn(const QString& screenRoot) const;
+    QStringList screensShowing(const QString& wallpaperId) const;
+    bool hasRenderer(const QString& screenRoot) const;
+    bool isAdopted(const QString& screenRoot) const;
+    QProcess* process(const QString& screenRoot) const;
+    qint64 processId(const QString& screenRoot) const;
+    QString lastError() const { return m_lastError; }
+
+    // Renderers left behind by a previous session that have not been claimed yet.
+    // Like stop, neither waits for the renderers to exit
+    QStringList orphanScreens() const;
+    bool terminateOrphan(const QString& screenRoot, int terminateTimeoutMs = 5000);
+    void terminateOrphans(int terminateTimeoutMs = 5000);
+    QString pidFilePath() const;
+
+signals:
+    // Decoded on the output worker thread, delivered on the owner's thread
+    void outputReady(const QString& screenRoot, const RendererOutput& output);
+    void firstOutput(const QString& screenRoot);
+    void processFinished(const QString& screenRoot, const QString& wallpaperId, int exitCode, QProcess::ExitStatus exitStatus);
+    void processError(const QString& screenRoot, const QString& wallpaperId, QProcess::ProcessError error);
+    void rendererStarted(const QString& screenRoot, const QString& wallpaperId);
+    void rendererStopped(const QString& screenRoot, const QString& wallpaperId);
+
+private:
+    struct Renderer {
+        QProcess* process = nullptr;     // null for adopted renderers
+        QString wallpaperId;
+        bool paused = false;
+        qint64 pid = 0;
+        quint64 startTime = 0;           // /proc/<pid>/stat starttime, guards against pid reuse
+        QString fingerprint;
+        int pidfd = -1;                  // adopted renderers only
+        QSocketNotifier* exitNotifier = nullptr;
+    };
+    
+    struct Orphan {
+        QString wallpaperId;
+        qint64 pid = 0;
+        quint64 startTime = 0;
+        QString fingerprint;
+    };
+    
+    // A renderer being terminated without blocking: SIGTERM, then SIGKILL
+    // if it has not exited when the timer fires
+    struct Termination {
+        QProcess* process = nullptr;     // our own renderer; adopted ones and orphans go by pid
+        qint64 pid = 0;
+        quint64 startTime = 0;
+        int pidfd = -1;
+        QSocketNotifier* exitNotifier = nullptr;
+        QTimer* timer = nullptr;
+        bool killed = false;
+    };
+
+    void connectProcess(const QString& screenRoot, QProcess* process);
+    bool adoptOrphan(const QString& screenRoot, const QString& wallpaperId, const QString& fingerprint);
+    void onAdoptedRendererExited(const QString& screenRoot);
+    void releaseRenderer(Renderer& renderer);
+    bool takeOrphan(const QString& screenRoot, Orphan& orphan, int& pidfd);
+    void beginTermination(Termination* termination, int terminateTimeoutMs);
+    void onTerminationTimeout(Termination* termination);
+    void finishTermination(Termination* termination);
+    
+    QString outputFilePath(const QString& screenRoot, const QString& channel) const;
+    void removeOutputFiles(const QString& screenRoot) const;
+    void openOutputFiles(const QString& screenRoot, bool skipExisting);
+    void closeOutputFiles(const QString& screenRoot);
+    bool signalRenderer(const Renderer& renderer, int signal) const;
+    void recoverOrphans();
+    void writePidFile() const;
+    
+    static bool waitForExit(qint64 pid, int pidfd, int timeoutMs);
+    static bool readProcessStartTime(qint64 pid, quint64& startTime);
+    static QString readProcessFingerprint(qint64 pid);
+    static int openPidfd(qint64 pid);
+
+    QString m_rendererName;
+    QMap<QString, Renderer> m_renderers;
+    QMap<QString, Orphan> m_orphans;
+    QTimer* m_orphanGraceTimer;
+    QList<Termination*> m_terminations;
+    QThread* m_outputThread;
+    RendererOutputWorker* m_outputWorker;
+    RendererOutputWorker::CaptureMode m_captureMode;
+    QString m_lastError;
+};
+
+#endif // RENDERERPROCESSMANAGER_H
@@ -0,0 +1,204 @@
+#include "RotatingLogFile.h"
+#include <QDir>
+#include <QFileInfo>
+#include <QStandardPaths>
+#include <QLoggingCategory>
+
+Q_LOGGING_CATEGORY(rotatingLog, "app.rotatingLog")
+
+namespace {
+// Batching window for writes; at most this much output is lost if the GUI crashes
+constexpr int WRITE_DELAY_MS = 200;
+}
+
+RotatingLogFileWorker::RotatingLogFileWorker(QObject* parent)
+    : QObject(parent)
+    , m_maxBytes(5 * 1024 * 1024)
+    , m_maxFiles(5)
+    , m_compressRotated(false)
+    , m_writeTimer(new QTimer(this))
+{
+    m_writeTimer->setSingleShot(true);
+    m_writeTimer->setInterval(WRITE_DELAY_MS);
+    connect(m_writeTimer, &QTimer::timeout, this, &RotatingLogFileWorker::writePending);
+}
+
+RotatingLogFileWorker::~RotatingLogFileWorker()
+{
+    close();
+}
+
+void RotatingLogFileWorker::configure(const QString& filePath, qint64 maxBytes, int maxFiles, bool compressRotated)
+{
+    if (filePath != m_filePath) {
+        close();
+        m_filePath = filePath;
+    }
+    m_maxBytes = qMax<qint64>(64 * 1024, maxBytes);
+    m_maxFiles = qMax(1, maxFiles);
+    m_compressRotated = compressRotated;
+}
+
+void RotatingLogFileWorker::appendLines(const QStringList& lines)
+{
+    m_pending << lines;
+    if (!m_writeTimer->isActive()) {
+        m_writeTimer->start();
+    }
+}
+
+void RotatingLogFileWorker::writePending()
+{
+    if (m_pending.isEmpty() || m_filePath.isEmpty()) {
+        return;
+    }
+    
+    QByteArray data = (m_pending.join('\n') + '\n').toUtf8();
+    m_pending.clear();
+    
+    if (!m_file.isOpen() && !openFile()) {
+        return;
+    }
+    
+    if (m_file.size() > 0 && m_file.size() + data.size() > m_maxBytes) {
+        rotate();
+        if (!openFile()) {
+            return;
+        }
+    }
+    
+    m_file.write(data);
+    m_file.flush();
+}
+
+void RotatingLogFileWorker::close()
+{
+    writePending();
+    m_writeTimer->stop();
+    if (m_file.isOpen()) {
+        m_file.close();
+    }
+}
+
+bool RotatingLogFileWorker::openFile()
+{
+    QDir().mkpath(QFileInfo(m_filePath).absolutePath());
+    
+    m_file.setFileName(m_filePath);
+    if (!m_file.open(QIODevice::WriteOnly | QIODevice::Append)) {
+        qCWarning(rotatingLog) << "Failed to open log file" << m_filePath << m_file.errorString();
+        return false;
+    }
+    return true;
+}
+
+QString RotatingLogFileWorker::segmentPath(int index, bool compressed) const
+{
+    return QString("%1.%2%3").arg(m_filePath).arg(index).arg(compressed ? ".qz" : "");
+}
+
+void RotatingLogFileWorker::rotate()
+{
+    m_file.close();
+    
+    // Drop the oldest segment, then shift the rest up by one
+    QFile::remove(segmentPath(m_maxFiles, false));
+    QFile::remove(segmentPath(m_maxFiles, true));
+    for (int index = m_maxFiles - 1; index >= 1; --index) {
+        for (bool compressed : { false, true }) {
+            if (QFile::exists(segmentPath(index, compressed))) {
+                QFile::rename(segmentPath(index, compressed), segmentPath(index + 1, compressed));
+            }
+        }
+    }
+    
+    QString rotatedPath = segmentPath(1, false);
+    if (!QFile::rename(m_filePath, rotatedPath)) {
+        qCWarning(rotatingLog) << "Failed to rotate log file" << m_filePath;
+        return;
+    }
+    
+    if (!m_compressRotated) {
+        return;
+    }
+    
+    // qCompress output: zlib stream with a 4 byte big-endian length header
+    QFile rotated(rotatedPath);
+    if (!rotated.open(QIODevice::ReadOnly)) {
+        return;
+    }
+    QByteArray compressed = qCompress(rotated.readAll(), 9);
+    rotated.close();
+    
+    QFile compressedFile(segmentPath(1, true));
+    if (compressedFile.open(QIODevice::WriteOnly | QIODevice::Truncate) &&
+        compressedFile.write(compressed) == compressed.size()) {
+        compressedFile.close();
+        QFile::remove(rotatedPath);
+    } else {
+        qCWarning(rotatingLog) << "Failed to compress rotated log" << rotatedPath;
+        compressedFile.remove();
+    }
+}
+
+RotatingLogFile::RotatingLogFile(QObject* parent)
+    : QObject(parent)
+    , m_thread(new QThread(this))
+    , m_worker(new RotatingLogFileWorker)
+    , m_enabled(false)
+{
+    m_thread->setObjectName("log-writer");
+    m_worker->moveToThread(m_thread);
+    connect(m_thread, &QThread::finished, m_worker, &QObject::deleteLater);
+    m_thread->start(QThread::LowPriority);
+}
+
+RotatingLogFile::~RotatingLogFile()
+{
+    // The worker writes what is still pending when it is destroyed
+    m_thread->quit();
+    m_thread->wait();
+}
+
+QString RotatingLogFile::defaultDirectory()
+{
+    QString cachePath = QStandardPaths::writableLocation(QStandardPaths::CacheLocation);
+    if (cachePath.isEmpty()) {
+        cachePath = QStandardPaths::writableLocation(QStandardPaths::GenericCacheLocation);
+    }
+    
+    if (cachePath.isEmpty()) {
+        cachePath = QStandardPaths::writableLocation(QStandardPaths::HomeLocation) +
+                  "/.cache/wallpaperengine-gui";
+    } else {
+        cachePath += "/wallpaperengine-gui";
+    }
+    
+    return cachePath + "/logs";
+}
+
+void RotatingLogFile::configure(bool enabled, const QString& directory, qint64 maxBytes, int maxFiles, bool compressRotated)
+{
+    m_enabled = enabled;
+    m_filePath = QDir(directory.isEmpty() ? defaultDirectory() : directory).filePath("output.log");
+    
+    if (!enabled) {
+        QMetaObject::invokeMethod(m_worker, "close", Qt::QueuedConnection);
+        return;
+    }
+    
+    QMetaObject::invokeMethod(m_worker, "configure", Qt::QueuedConnection,
+                              Q_ARG(QString, m_filePath),
+                              Q_ARG(qint64, maxBytes),
+                              Q_ARG(int, maxFiles),
+                              Q_ARG(bool, compressRotated));
+    qCDebug(rotatingLog) << "Logging output to" << m_filePath;
+}
+
+void RotatingLogFile::append(const QStringList& lines)
+{
+    if (!m_enabled || lines.isEmpty()) {
+        return;
+    }
+    QMetaObject::invokeMethod(m_worker, "appendLines", Qt::QueuedConnection, Q_ARG(QStringList, lines));
+}
@@ -0,0 +1,68 @@
+#ifndef ROTATINGLOGFILE_H
+#define ROTATINGLOGFILE_H
+
+#include <QObject>
+#include <QString>
+#include <QStringList>
+#include <QFile>
+#include <QTimer>
+#include <QThread>
+
+// Appends lines to a size rotated log file on a writer thread. The active
+// file is <directory>/output.log; full files are shifted to output.log.1,
+// output.log.2, ... (optionally qCompress'ed to output.log.N.qz) and the
+// oldest one beyond the configured count is deleted.
+class RotatingLogFileWorker : public QObject
+{
+    Q_OBJECT
+
+public:
+    explicit RotatingLogFileWorker(QObject* parent = nullptr);
+    ~RotatingLogFileWorker();
+
+public slots:
+    void configure(const QString& filePath, qint64 maxBytes, int maxFiles, bool compressRotated);
+    void appendLines(const QStringList& lines);
+    void writePending();
+    void close();
+
+private:
+    bool openFile();
+    void rotate();
+    QString segmentPath(int index, bool compressed) const;
+    
+    QFile m_file;
+    QString m_filePath;
+    qint64 m_maxBytes;
+    int m_maxFiles;
+    bool m_compressRotated;
+    QStringList m_pending;
+    QTimer* m_writeTimer;
+};
+
+class RotatingLogFile : public QObject
+{
+    Q_OBJECT
+
+public:
+    explicit RotatingLogFile(QObject* parent = nullptr);
+    ~RotatingLogFile();
+    
+    static QString defaultDirectory();
+    
+    // Reconfigures the writer; disabling closes the file
+    void configure(bool enabled, const QString& directory, qint64 maxBytes, int maxFiles, bool compressRotated);
+    bool isEnabled() const { return m_enabled; }
+    QString filePath() const { return m_filePath; }
+    
+    // Never blocks on I/O: lines are queued to the writer thread
+    void append(const QStringList& lines);
+
+private:
+    QThread* m_thread;
+    RotatingLogFileWorker* m_worker;
+    bool m_enabled;
+    QString m_filePath;
+};
+
+#endif // ROTATINGLOGFILE_H
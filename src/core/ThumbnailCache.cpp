@@ -0,0 +1,287 @@
+#include "ThumbnailCache.h"
+#include "ConfigManager.h"
+#include <QDir>
+#include <QFileInfo>
+#include <QDateTime>
+#include <QSaveFile>
+#include <QImageReader>
+#include <QCryptographicHash>
+#include <QStandardPaths>
+#include <QLoggingCategory>
+#include <QThreadPool>
+#include <algorithm>
+
+Q_LOGGING_CATEGORY(thumbnailCache, "app.thumbnailCache")
+
+namespace {
+// Thumbnails are photos for the most part; JPEG keeps an entry at a few KB
+constexpr int JPEG_QUALITY = 88;
+}
+
+ThumbnailCache::ThumbnailCache()
+    : m_directory(defaultDirectory())
+    , m_enabled(true)
+    , m_maxBytes(256LL * 1024 * 1024)
+    , m_bytesSincePrune(0)
+    , m_hits(0)
+    , m_misses(0)
+{
+    ConfigManager& config = ConfigManager::instance();
+    m_enabled = config.thumbnailCacheEnabled();
+    m_maxBytes = qMax(1, config.thumbnailCacheSizeMb()) * 1024LL * 1024;
+    
+    QDir().mkpath(m_directory);
+    
+    // Trim what earlier sessions left behind without holding up startup
+    QThreadPool::globalInstance()->start([this]() { prune(); });
+}
+
+ThumbnailCache& ThumbnailCache::instance()
+{
+    static ThumbnailCache instance;
+    return instance;
+}
+
+QString ThumbnailCache::defaultDirectory()
+{
+    QString cachePath = QStandardPaths::writableLocation(QStandardPaths::CacheLocation);
+    if (cachePath.isEmpty()) {
+        cachePath = QStandardPaths::writableLocation(QStandardPaths::GenericCacheLocation);
+    }
+    
+    if (cachePath.isEmpty()) {
+        cachePath = QStandardPaths::writableLocation(QStandardPaths::HomeLocation) +
+                  "/.cache/wallpaperengine-gui";
+    } else {
+        cachePath += "/wallpaperengine-gui";
+    }
+    
+    return cachePath + "/thumbnails";
+}
+
+QString ThumbnailCache::cacheKey(const QString& sourcePath, const QSize& targetSize)
+{
+    QFileInfo info(sourcePath);
+    if (!info.exists()) {
+        return QString();
+    }
+    
+    QString identity = QString("%1\n%2\n%3\n%4x%5")
+                           .arg(info.absoluteFilePath())
+                           .arg(info.lastModified().toMSecsSinceEpoch())
+                           .arg(info.size())
+                           .arg(targetSize.width())
+                           .arg(targetSize.height());
+    return QString::fromLatin1(QCryptographicHash::hash(identity.toUtf8(), QCryptographicHash::Sha1).toHex());
+}
+
+QString ThumbnailCache::entryPath(const QString& key, bool alpha) const
+{
+    return QDir(m_directory).filePath(key + (alpha ? ".png" : ".jpg"));
+}
+
+QImage ThumbnailCache::lookup(const QString& sourcePath, const QSize& targetSize)
+{
+    if (!isEnabled()) {
+        return QImage();
+    }
+    
+    QString key = cacheKey(sourcePath, targetSize);
+    if (key.isEmpty()) {
+        return QImage();
+    }
+    
+    for (bool alpha : { false, true }) {
+        QString path = entryPath(key, alpha);
+        if (!QFileInfo::exists(path)) {
+            continue;
+        }
+        
+        QImageReader reader(path);
+        QImage image = reader.read();
+        if (!image.isNull()) {
+            m_hits.fetch_add(1, std::memory_order_relaxed);
+            touch(path);
+            return image;
+        }
+        
+        // Truncated or otherwise unreadable entry; drop it and decode again
+        qCWarning(thumbnailCache) << "Removing unreadable thumbnail" << path << reader.errorString();
+        QFile::remove(path);
+    }
+    
+    m_misses.fetch_add(1, std::memory_order_relaxed);
+    return QImage();
+}
+
+bool ThumbnailCache::store(const QString& sourcePath, const QSize& targetSize, const QImage& image)
+{
+    if (!isEnabled() || image.isNull()) {
+        return false;
+    }
+    
+    QString key = cacheKey(sourcePath, targetSize);
+    if (key.isEmpty()) {
+        return false;
+    }
+    
+    bool alpha = image.hasAlphaChannel();
+    QSaveFile file(entryPath(key, alpha));
+    if (!file.open(QIODevice::WriteOnly) ||
+        !image.save(&file, alpha ? "PNG" : "JPG", alpha ? -1 : JPEG_QUALITY) ||
+        !file.commit()) {
+        qCWarning(thumbnailCache) << "Failed to write thumbnail for" << sourcePath << file.errorString();
+        return false;
+    }
+    
+    entryWritten(QFileInfo(file.fileName()).size());
+    return true;
+}
+
+void ThumbnailCache::touch(const QString& entryPath)
+{
+    // prune() goes by mtime, so this is what makes eviction least recently used
+    QFile file(entryPath);
+    if (file.open(QIODevice::ReadOnly)) {
+        file.setFileTime(QDateTime::currentDateTimeUtc(), QFileDevice::FileModificationTime);
+    }
+}
+
+void ThumbnailCache::entryWritten(qint64 bytes)
+{
+    // Check the size limit again once roughly an eighth of it has been written
+    qint64 written = m_bytesSincePrune.fetch_add(bytes);
+    if (written > maxBytes() / 8) {
+        prune();
+    }
+}
+
+QImage ThumbnailCache::thumbnail(const QString& sourcePath, const QSize& targetSize)
+{
+    QImage cached = lookup(sourcePath, targetSize);
+    if (!cached.isNull()) {
+        return cached;
+    }
+    
+    QImage image = decodeScaled(sourcePath, targetSize);
+    if (!image.isNull()) {
+        store(sourcePath, targetSize, image);
+    }
+    return image;
+}
+
+QImage ThumbnailCache::decodeScaled(const QString& sourcePath, const QSize& targetSize)
+{
+    QImageReader reader(sourcePath);
+    reader.setAutoTransform(true);
+    
+    // The header is enough to know the size; never decode more pixels than shown
+    QSize sourceSize = reader.size();
+    if (sourceSize.isValid() && targetSize.isValid() &&
+        (sourceSize.width() > targetSize.width() || sourceSize.height() > targetSize.height())) {
+        reader.setScaledSize(sourceSize.scaled(targetSize, Qt::KeepAspectRatio));
+    }
+    
+    QImage image = reader.read();
+    if (image.isNull()) {
+        qCDebug(thumbnailCache) << "Failed to decode preview" << sourcePath << reader.errorString();
+        return QImage();
+    }
+    
+    // An EXIF rotation swaps the axes after scaling
+    if (image.width() > targetSize.width() || image.height() > targetSize.height()) {
+        image = image.scaled(targetSize, Qt::KeepAspectRatio, Qt::SmoothTransformation);
+    }
+    return image;
+}
+
+void ThumbnailCache::setEnabled(bool enabled)
+{
+    m_enabled = enabled;
+}
+
+void ThumbnailCache::setMaxBytes(qint64 maxBytes)
+{
+    m_maxBytes = qMax<qint64>(1024 * 1024, maxBytes);
+    prune();
+}
+
+void ThumbnailCache::prune()
+{
+    // One pass at a time is enough; a concurrent caller would delete the same files
+    if (!m_pruneMutex.tryLock()) {
+        return;
+    }
+    m_bytesSincePrune = 0;
+    
+    QFileInfoList entries = QDir(m_directory).entryInfoList(QDir::Files, QDir::Time | QDir::Reversed);
+    qint64 total = 0;
+    for (const QFileInfo& entry : entries) {
+        total += entry.size();
+    }
+    
+    // Thumbnails are cheap to decode again; generated previews need ffmpeg
+    std::stable_partition(entries.begin(), entries.end(), [](const QFileInfo& entry) {
+        return !isGeneratedPreview(entry.fileName());
+    });
+    
+    qint64 limit = maxBytes();
+    int removed = 0;
+    for (const QFileInfo& entry : entries) {
+        if (total <= limit) {
+            break;
+        }
+        if (QFile::remove(entry.absoluteFilePath())) {
+            total -= entry.size();
+            ++removed;
+        }
+    }
+    
+    if (removed > 0) {
+        qCDebug(thumbnailCache) << "Pruned" << removed << "thumbnails, cache now" << total / 1024 << "KB";
+    }
+    m_pruneMutex.unlock();
+}
+
+void ThumbnailCache::clear()
+{
+    QMutexLocker locker(&m_pruneMutex);
+    QDir directory(m_directory);
+    for (const QString& name : directory.entryList(QDir::Files)) {
+        directory.remove(name);
+    }
+    m_bytesSincePrune = 0;
+    qCInfo(thumbnailCache) << "Cleared thumbnail cache" << m_directory;
+}
+
+bool ThumbnailCache::isGeneratedPreview(const QString& fileName)
+{
+    // Also matches the partial file of a frame still being written
+    return fileName.contains(QLatin1String(GENERATED_PREVIEW_SUFFIX));
+}
+
+void ThumbnailCache::removeUnusedPreviews(const QSet<QString>& used)
+{
+    QMutexLocker locker(&m_pruneMutex);
+    QDir directory(m_directory);
+    int removed = 0;
+    for (const QString& name : directory.entryList({ QString("*") + GENERATED_PREVIEW_SUFFIX }, QDir::Files)) {
+        QString path = directory.filePath(name);
+        if (!used.contains(path) && QFile::remove(path)) {
+            ++removed;
+        }
+    }
+    
+    if (removed > 0) {
+        qCDebug(thumbnailCache) << "Removed" << removed << "generated previews no wallpaper uses";
+    }
+}
+
+qint64 ThumbnailCache::diskUsage() const
+{
+    qint64 total = 0;
+    for (const QFileInfo& entry : QDir(m_directory).entryInfoList(QDir::Files)) {
+        total += entry.size();
+    }
+    return total;
+}
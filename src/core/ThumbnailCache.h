@@ -0,0 +1,80 @@
+#ifndef THUMBNAILCACHE_H
+#define THUMBNAILCACHE_H
+
+#include <QString>
+#include <QSize>
+#include <QImage>
+#include <QMutex>
+#include <QSet>
+#include <atomic>
+
+// On-disk cache of pre-scaled preview thumbnails. Entries are keyed by the
+// source path, its mtime and size and the target size, so an edited preview
+// simply misses and gets a new entry. A hit moves the entry's mtime forward,
+// so once the cache grows past its size limit the least recently used
+// entries go first. Safe to call from any thread.
+class ThumbnailCache
+{
+public:
+    static ThumbnailCache& instance();
+    
+    static QString defaultDirectory();
+    QString directory() const { return m_directory; }
+    
+    // Thumbnail of sourcePath fitting targetSize; decodes and stores it on a miss
+    QImage thumbnail(const QString& sourcePath, const QSize& targetSize);
+    
+    // Cache only: a null image on a miss
+    QImage lookup(const QString& sourcePath, const QSize& targetSize);
+    bool store(const QString& sourcePath, const QSize& targetSize, const QImage& image);
+    // Marks an entry in directory() as used now; called on every hit
+    void touch(const QString& entryPath);
+    
+    static QString cacheKey(const QString& sourcePath, const QSize& targetSize);
+    
+    // Decodes sourcePath to fit targetSize, letting the image plugin scale while
+    // decoding where it can (JPEG does so in the DCT); no caching
+    static QImage decodeScaled(const QString& sourcePath, const QSize& targetSize);
+    
+    bool isEnabled() const { return m_enabled.load(std::memory_order_relaxed); }
+    void setEnabled(bool enabled);
+    qint64 maxBytes() const { return m_maxBytes.load(std::memory_order_relaxed); }
+    void setMaxBytes(qint64 maxBytes);
+    
+    // Deletes the least recently used entries until the cache fits its size limit
+    void prune();
+    // For other entries kept in directory(), so they count towards the limit
+    void entryWritten(qint64 bytes);
+    void clear();
+    
+    // Previews generated for wallpapers that ship none are named with this
+    // suffix. They count towards the limit like any entry, but prune() only
+    // takes them once no thumbnail is left to remove, since catalog entries
+    // point at them and they are costly to make again
+    static constexpr const char* GENERATED_PREVIEW_SUFFIX = "-video.jpg";
+    static bool isGeneratedPreview(const QString& fileName);
+    // Deletes generated previews not in used, e.g. of removed wallpapers
+    void removeUnusedPreviews(const QSet<QString>& used);
+    qint64 diskUsage() const;
+    
+    quint64 hits() const { return m_hits.load(std::memory_order_relaxed); }
+    quint64 misses() const { return m_misses.load(std::memory_order_relaxed); }
+
+private:
+    ThumbnailCache();
+    ~ThumbnailCache() = default;
+    ThumbnailCache(const ThumbnailCache&) = delete;
+    ThumbnailCache& operator=(const ThumbnailCache&) = delete;
+    
+    QString entryPath(const QString& key, bool alpha) const;
+    
+    QString m_directory;
+    std::atomic<bool> m_enabled;
+    std::atomic<qint64> m_maxBytes;
+    std::atomic<qint64> m_bytesSincePrune;
+    std::atomic<quint64> m_hits;
+    std::atomic<quint64> m_misses;
+    QMutex m_pruneMutex;
+};
+
+#endif // THUMBNAILCACHE_H
@@ -0,0 +1,172 @@
+#include "VideoPreviewGenerator.h"
+#include "ThumbnailCache.h"
+#include <QDir>
+#include <QFile>
+#include <QFileInfo>
+#include <QLoggingCategory>
+
+Q_LOGGING_CATEGORY(videoPreviewGenerator, "app.videoPreviewGenerator")
+
+VideoPreviewGenerator::VideoPreviewGenerator()
+    : QObject(nullptr)
+    , m_process(new QProcess(this))
+    , m_timeout(new QTimer(this))
+    , m_ffmpegMissing(false)
+{
+    m_process->setProcessChannelMode(QProcess::MergedChannels);
+    connect(m_process, &QProcess::finished, this, &VideoPreviewGenerator::onFinished);
+    connect(m_process, &QProcess::errorOccurred, this, &VideoPreviewGenerator::onError);
+    
+    m_timeout->setSingleShot(true);
+    m_timeout->setInterval(JOB_TIMEOUT);
+    connect(m_timeout, &QTimer::timeout, this, &VideoPreviewGenerator::onTimeout);
+}
+
+VideoPreviewGenerator::~VideoPreviewGenerator()
+{
+    m_queue.clear();
+    if (m_process->state() != QProcess::NotRunning) {
+        m_process->disconnect(this);
+        m_process->kill();
+        m_process->waitForFinished(1000);
+        QFile::remove(m_current.outputPath + ".part.jpg");
+    }
+}
+
+VideoPreviewGenerator& VideoPreviewGenerator::instance()
+{
+    static VideoPreviewGenerator instance;
+    return instance;
+}
+
+QString VideoPreviewGenerator::outputPath(const QString& videoPath)
+{
+    // Keyed like the thumbnails, so a replaced video gets a new frame
+    QString key = ThumbnailCache::cacheKey(videoPath, QSize(FRAME_WIDTH, 0));
+    if (key.isEmpty()) {
+        return QString();
+    }
+    return QDir(ThumbnailCache::instance().directory()).filePath(key + ThumbnailCache::GENERATED_PREVIEW_SUFFIX);
+}
+
+QString VideoPreviewGenerator::cachedPreview(const QString& videoPath)
+{
+    QString path = outputPath(videoPath);
+    return !path.isEmpty() && QFileInfo::exists(path) ? path : QString();
+}
+
+void VideoPreviewGenerator::request(const QString& wallpaperId, const QString& videoPath)
+{
+    if (m_ffmpegMissing || !ThumbnailCache::instance().isEnabled() ||
+        m_queuedPaths.contains(videoPath) || m_failedPaths.contains(videoPath)) {
+        return;
+    }
+    
+    if (m_queue.size() >= MAX_QUEUED) {
+        qCDebug(videoPreviewGenerator) << "Queue full, skipping" << videoPath;
+        return;
+    }
+    
+    QString output = outputPath(videoPath);
+    if (output.isEmpty()) {
+        return;
+    }
+    
+    m_queue.enqueue(Job{ wallpaperId, videoPath, output });
+    m_queuedPaths.insert(videoPath);
+    
+    if (m_current.videoPath.isEmpty()) {
+        // Let the scan that queued this finish first
+        QTimer::singleShot(0, this, &VideoPreviewGenerator::startNext);
+    }
+}
+
+void VideoPreviewGenerator::startNext()
+{
+    if (!m_current.videoPath.isEmpty() || m_queue.isEmpty()) {
+        return;
+    }
+    
+    m_current = m_queue.dequeue();
+    if (QFileInfo::exists(m_current.outputPath)) {
+        // Made for another wallpaper using the same file
+        finishJob(true);
+        return;
+    }
+    
+    QDir().mkpath(QFileInfo(m_current.outputPath).path());
+    
+    // Scale before picking the frame: the thumbnail filter holds its whole
+    // batch in memory. It chooses the frame closest to the batch average,
+    // which skips black intro frames and fades
+    QStringList args;
+    args << "-v" << "error"
+         << "-nostdin"
+         << "-i" << m_current.videoPath
+         << "-an"
+         << "-vf" << QString("scale='min(%1,iw)':-2,thumbnail=100").arg(FRAME_WIDTH)
+         << "-frames:v" << "1"
+         << "-update" << "1"
+         << "-y" << m_current.outputPath + ".part.jpg";
+    
+    qCDebug(videoPreviewGenerator) << "Generating preview for" << m_current.videoPath;
+    m_process->start("ffmpeg", args);
+    m_timeout->start();
+}
+
+void VideoPreviewGenerator::onFinished(int exitCode, QProcess::ExitStatus exitStatus)
+{
+    m_timeout->stop();
+    
+    QString partPath = m_current.outputPath + ".part.jpg";
+    bool success = exitStatus == QProcess::NormalExit && exitCode == 0 && QFileInfo::exists(partPath);
+    if (success) {
+        QFile::remove(m_current.outputPath);
+        success = QFile::rename(partPath, m_current.outputPath);
+    }
+    
+    if (!success) {
+        qCWarning(videoPreviewGenerator) << "ffmpeg could not extract a frame from" << m_current.videoPath
+                                         << m_process->readAll().trimmed();
+        QFile::remove(partPath);
+    }
+    finishJob(success);
+}
+
+void VideoPreviewGenerator::onError(QProcess::ProcessError error)
+{
+    if (error != QProcess::FailedToStart) {
+        // Crashes and kills still end in finished()
+        return;
+    }
+    
+    m_timeout->stop();
+    qCWarning(videoPreviewGenerator) << "ffmpeg is not available, video wallpapers without a preview stay blank";
+    m_ffmpegMissing = true;
+    m_queue.clear();
+    m_queuedPaths.clear();
+    m_current = Job();
+}
+
+void VideoPreviewGenerator::onTimeout()
+{
+    qCWarning(videoPreviewGenerator) << "Frame extraction timed out for" << m_current.videoPath;
+    m_process->kill();
+}
+
+void VideoPreviewGenerator::finishJob(bool success)
+{
+    Job job = m_current;
+    m_current = Job();
+    m_queuedPaths.remove(job.videoPath);
+    
+    if (success) {
+        emit previewGenerated(job.wallpaperId, job.outputPath);
+    } else {
+        m_failedPaths.insert(job.videoPath);
+    }
+    
+    if (!m_queue.isEmpty()) {
+        QTimer::singleShot(0, this, &VideoPreviewGenerator::startNext);
+    }
+}
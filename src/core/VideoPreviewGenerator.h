@@ -0,0 +1,70 @@
+#ifndef VIDEOPREVIEWGENERATOR_H
+#define VIDEOPREVIEWGENERATOR_H
+
+#include <QObject>
+#include <QProcess>
+#include <QString>
+#include <QSet>
+#include <QQueue>
+#include <QTimer>
+
+// Makes previews for video wallpapers that ship without one. A representative
+// frame is taken from the video with ffmpeg's thumbnail filter and stored in
+// the thumbnail cache directory, so it costs nothing after the first time.
+// Frames no wallpaper uses any more are removed after each library scan.
+// Jobs run one ffmpeg at a time from a bounded queue; requests beyond it are
+// dropped and simply asked for again on the next scan. GUI thread only.
+class VideoPreviewGenerator : public QObject
+{
+    Q_OBJECT
+
+public:
+    static VideoPreviewGenerator& instance();
+    
+    // Generated preview for videoPath, or empty if there is none yet
+    static QString cachedPreview(const QString& videoPath);
+    // Where the preview for videoPath is stored once generated
+    static QString outputPath(const QString& videoPath);
+    
+    // Queues videoPath; previewGenerated() follows once the frame is stored
+    void request(const QString& wallpaperId, const QString& videoPath);
+    
+    int queuedJobs() const { return m_queue.size(); }
+    
+    static constexpr int MAX_QUEUED = 64;
+    static constexpr int FRAME_WIDTH = 640;
+    static constexpr int JOB_TIMEOUT = 20000;
+
+signals:
+    void previewGenerated(const QString& wallpaperId, const QString& previewPath);
+
+private slots:
+    void startNext();
+    void onFinished(int exitCode, QProcess::ExitStatus exitStatus);
+    void onError(QProcess::ProcessError error);
+    void onTimeout();
+
+private:
+    VideoPreviewGenerator();
+    ~VideoPreviewGenerator();
+    VideoPreviewGenerator(const VideoPreviewGenerator&) = delete;
+    VideoPreviewGenerator& operator=(const VideoPreviewGenerator&) = delete;
+    
+    void finishJob(bool success);
+    
+    struct Job {
+        QString wallpaperId;
+        QString videoPath;
+        QString outputPath;
+    };
+    
+    QQueue<Job> m_queue;
+    QSet<QString> m_queuedPaths;
+    QSet<QString> m_failedPaths;    // not retried this session
+    QProcess* m_process;
+    QTimer* m_timeout;
+    Job m_current;
+    bool m_ffmpegMissing;
+};
+
+#endif // VIDEOPREVIEWGENERATOR_H
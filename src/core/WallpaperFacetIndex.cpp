@@ -0,0 +1,68 @@
+#include "WallpaperFacetIndex.h"
+
+void WallpaperFacetIndex::rebuild(const QList<WallpaperInfo>& wallpapers)
+{
+    m_allRows = FacetBitmap::range(wallpapers.size());
+    m_types.clear();
+    m_tags.clear();
+    m_tagIndex.clear();
+    
+    // Rows are visited in order, so every bitmap is built by appending
+    for (int row = 0; row < wallpapers.size(); ++row) {
+        const WallpaperInfo& wallpaper = wallpapers.at(row);
+        if (!wallpaper.type.isEmpty()) {
+            m_types[key(wallpaper.type)].append(row);
+        }
+        
+        for (const QString& tag : wallpaper.tags) {
+            QString tagKey = key(tag);
+            if (tagKey.isEmpty()) {
+                continue;
+            }
+            
+            int index = m_tagIndex.value(tagKey, -1);
+            if (index < 0) {
+                index = m_tags.size();
+                m_tagIndex.insert(tagKey, index);
+                m_tags.append(Facet{ tag.trimmed(), FacetBitmap() });
+            }
+            
+            // The same tag twice on one wallpaper is only counted once
+            FacetBitmap& rows = m_tags[index].rows;
+            if (!rows.contains(row)) {
+                rows.append(row);
+            }
+        }
+    }
+}
+
+const FacetBitmap& WallpaperFacetIndex::typeRows(const QString& type) const
+{
+    auto it = m_types.constFind(key(type));
+    return it != m_types.constEnd() ? it.value() : m_empty;
+}
+
+const FacetBitmap& WallpaperFacetIndex::tagRows(const QString& tag) const
+{
+    int index = m_tagIndex.value(key(tag), -1);
+    return index >= 0 ? m_tags.at(index).rows : m_empty;
+}
+
+QString WallpaperFacetIndex::tagName(const QString& tag) const
+{
+    int index = m_tagIndex.value(key(tag), -1);
+    return index >= 0 ? m_tags.at(index).name : tag;
+}
+
+FacetBitmap WallpaperFacetIndex::tagFilter(const QStringList& tags, bool matchAll) const
+{
+    if (tags.isEmpty()) {
+        return m_allRows;
+    }
+    
+    FacetBitmap rows = tagRows(tags.first());
+    for (int i = 1; i < tags.size(); ++i) {
+        rows = matchAll ? rows & tagRows(tags.at(i)) : rows | tagRows(tags.at(i));
+    }
+    return rows;
+}
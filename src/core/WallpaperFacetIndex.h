@@ -0,0 +1,49 @@
+#ifndef WALLPAPERFACETINDEX_H
+#define WALLPAPERFACETINDEX_H
+
+#include <QString>
+#include <QStringList>
+#include <QVector>
+#include <QHash>
+#include "FacetBitmap.h"
+#include "WallpaperManager.h"
+
+// Which catalog rows carry each wallpaper type and tag. Facets are matched
+// case-insensitively and shown as first spelled. Filtering by several tags
+// and counting how many results each facet would leave are bitmap
+// operations, so both stay cheap however often the search text changes.
+class WallpaperFacetIndex
+{
+public:
+    struct Facet {
+        QString name;
+        FacetBitmap rows;
+    };
+    
+    // Rows are positions in wallpapers
+    void rebuild(const QList<WallpaperInfo>& wallpapers);
+    
+    const FacetBitmap& allRows() const { return m_allRows; }
+    // Empty for an unknown type or tag
+    const FacetBitmap& typeRows(const QString& type) const;
+    const FacetBitmap& tagRows(const QString& tag) const;
+    // As first spelled in the catalog
+    QString tagName(const QString& tag) const;
+    
+    // Rows with every tag (matchAll) or any of them; all rows for no tags
+    FacetBitmap tagFilter(const QStringList& tags, bool matchAll) const;
+    
+    // One per folded tag, in first seen order
+    const QVector<Facet>& tags() const { return m_tags; }
+    
+    static QString key(const QString& facet) { return facet.trimmed().toCaseFolded(); }
+
+private:
+    FacetBitmap m_allRows;
+    QHash<QString, FacetBitmap> m_types;
+    QVector<Facet> m_tags;
+    QHash<QString, int> m_tagIndex;     // folded tag to m_tags position
+    FacetBitmap m_empty;
+};
+
+#endif // WALLPAPERFACETINDEX_H
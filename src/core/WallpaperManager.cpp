@@ -1,6 +1,12 @@
 #include "WallpaperManager.h"
 #include "ConfigManager.h"
+#include "LaunchTimings.h"
+#include "RendererProcessManager.h"
+#include "PreviewPlaceholder.h"
+#include "ThumbnailCache.h"
+#include "VideoPreviewGenerator.h"
 #include <QDir>
+#include <QDirIterator>
 #include <QFileInfo>
 #include <QJsonDocument>
 #include <QJsonObject>
@@ -10,18 +16,58 @@
 #include <QLoggingCategory>
 #include <QProcessEnvironment>
 #include <QTimer>
+#include <QElapsedTimer>
+#include <QPointer>
+#include <QThreadPool>
+#include <QThread>
 
 Q_LOGGING_CATEGORY(wallpaperManager, "app.wallpaperManager")
 
 WallpaperManager::WallpaperManager(QObject* parent)
     : QObject(parent)
-    , m_wallpaperProcess(nullptr)
+    , m_renderers(new RendererProcessManager("linux-wallpaperengine", this))
     , m_refreshing(false)
+    , m_stopping(false)
 {
+    m_sizePool.setMaxThreadCount(1);
+
+    connect(m_renderers, &RendererProcessManager::processFinished,
+            this, &WallpaperManager::onProcessFinished);
+    connect(m_renderers, &RendererProcessManager::processError,
+            this, &WallpaperManager::onProcessError);
+    connect(m_renderers, &RendererProcessManager::outputReady,
+            this, &WallpaperManager::onProcessOutput);
+    connect(m_renderers, &RendererProcessManager::firstOutput, this, [this](const QString& screenRoot) {
+        LaunchTimings::instance().markPhase(m_renderers->wallpaperOn(screenRoot), LaunchTimings::Phase::FirstOutput);
+    });
+    connect(&VideoPreviewGenerator::instance(), &VideoPreviewGenerator::previewGenerated,
+            this, &WallpaperManager::onVideoPreviewGenerated);
+    
+    ConfigManager& config = ConfigManager::instance();
+    m_renderers->setCaptureMode(RendererOutputWorker::captureModeFromString(config.outputCaptureMode()));
+    m_renderers->setOutputLimits(config.outputCollapseRepeats(), config.outputLineBudget());
+    
+    QVariantMap lastUsed = config.value("ui/wallpaperLastUsed", QVariantMap()).toMap();
+    for (auto it = lastUsed.constBegin(); it != lastUsed.constEnd(); ++it) {
+        m_lastUsed.insert(it.key(), it.value().toLongLong());
+    }
+    
+    QVariantMap sizes = config.value("cache/wallpaperSizes", QVariantMap()).toMap();
+    for (auto it = sizes.constBegin(); it != sizes.constEnd(); ++it) {
+        QVariantList entry = it.value().toList();
+        if (entry.size() == 2) {
+            m_directorySizes.insert(it.key(), { entry.at(0).toLongLong(), entry.at(1).toLongLong() });
+        }
+    }
 }
 
 WallpaperManager::~WallpaperManager()
 {
+    // A measurement still running stops at the next directory
+    m_stopping = true;
+    m_sizePool.clear();
+    m_sizePool.waitForDone();
+    
     stopWallpaper();
 }
 
@@ -34,10 +80,25 @@ void WallpaperManager::refreshWallpapers()
     
     m_refreshing = true;
     m_wallpapers.clear();
+    m_generatedPreviews.clear();
+    m_unmeasured.clear();
     
     qCDebug(wallpaperManager) << "Starting wallpaper refresh";
     scanWorkshopDirectories();
     
+    // Placeholders made while browsing since the last scan
+    PreviewPlaceholder::instance().save();
+    
+    measureDirectorySizes();
+    
+    // Frames of removed or replaced videos; a failed scan finds none in use
+    if (!m_wallpapers.isEmpty()) {
+        QSet<QString> used = m_generatedPreviews;
+        QThreadPool::globalInstance()->start([used]() {
+            ThumbnailCache::instance().removeUnusedPreviews(used);
+        });
+    }
+    
     m_refreshing = false;
     emit refreshFinished();
     emit wallpapersChanged();
@@ -106,6 +167,34 @@ void WallpaperManager::processWallpaperDirectory(const QString& dirPath)
         wallpaper.path = dirPath;
         wallpaper.projectPath = projectPath;
         wallpaper.previewPath = findPreviewImage(dirPath);
+        
+        // Walking every file is left to the size pool; known sizes apply now
+        auto size = m_directorySizes.constFind(dirPath);
+        if (size != m_directorySizes.constEnd() && size->first == sizeStamp(dirPath)) {
+            wallpaper.fileSize = size->second;
+        } else {
+            m_unmeasured.append(dirPath);
+        }
+        
+        auto details = m_workshopDetails.constFind(wallpaper.id);
+        if (details != m_workshopDetails.constEnd()) {
+            mergeWorkshopDetails(wallpaper, details.value());
+        }
+        
+        // Video wallpapers without a preview get a frame of their video,
+        // made in the background the first time they are seen
+        if (wallpaper.previewPath.isEmpty() && wallpaper.type.compare("video", Qt::CaseInsensitive) == 0) {
+            QString videoPath = findVideoFile(dirPath);
+            if (!videoPath.isEmpty()) {
+                wallpaper.previewPath = VideoPreviewGenerator::cachedPreview(videoPath);
+                if (wallpaper.previewPath.isEmpty()) {
+                    VideoPreviewGenerator::instance().request(wallpaper.id, videoPath);
+                }
+                m_generatedPreviews.insert(VideoPreviewGenerator::outputPath(videoPath));
+            }
+        }
+        
+        wallpaper.previewPlaceholder = PreviewPlaceholder::instance().lookup(wallpaper.previewPath);
         m_wallpapers.append(wallpaper);
     }
 }
@@ -137,10 +226,6 @@ WallpaperInfo WallpaperManager::parseProjectJson(const QString& projectPath)
     wallpaper.description = root.value("description").toString();
     wallpaper.type = root.value("type").toString();
     
-    // Extract file size
-    QFileInfo dirInfo(QFileInfo(projectPath).dir().path());
-    wallpaper.fileSize = dirInfo.size();
-    
     // Extract tags
     QJsonArray tagsArray = root.value("tags").toArray();
     QStringList tags;
@@ -213,6 +298,158 @@ QString WallpaperManager::findPreviewImage(const QString& wallpaperDir)
     return QString();
 }
 
+QString WallpaperManager::findVideoFile(const QString& wallpaperDir)
+{
+    QDir dir(wallpaperDir);
+    QStringList videoFilters = {"*.mp4", "*.webm", "*.mkv", "*.mov", "*.avi", "*.m4v"};
+    
+    // The largest video is the wallpaper itself rather than a sound or intro clip
+    QFileInfoList videos = dir.entryInfoList(videoFilters, QDir::Files, QDir::Size);
+    return videos.isEmpty() ? QString() : videos.first().absoluteFilePath();
+}
+
+qint64 WallpaperManager::directorySize(const QString& dirPath)
+{
+    // Everything the wallpaper keeps on disk, scenes' assets included
+    qint64 size = 0;
+    QDirIterator it(dirPath, QDir::Files | QDir::Hidden | QDir::NoSymLinks, QDirIterator::Subdirectories);
+    while (it.hasNext()) {
+        it.next();
+        size += it.fileInfo().size();
+    }
+    return size;
+}
+
+qint64 WallpaperManager::sizeStamp(const QString& dirPath)
+{
+    // Workshop updates replace project.json, which also touches the directory
+    QDateTime directory = QFileInfo(dirPath).lastModified();
+    QDateTime project = QFileInfo(QDir(dirPath).filePath("project.json")).lastModified();
+    return qMax(directory.isValid() ? directory.toMSecsSinceEpoch() : 0,
+                project.isValid() ? project.toMSecsSinceEpoch() : 0);
+}
+
+void WallpaperManager::measureDirectorySizes()
+{
+    // Sizes of wallpapers that are gone are forgotten
+    QSet<QString> scanned;
+    for (const WallpaperInfo& wallpaper : m_wallpapers) {
+        scanned.insert(wallpaper.path);
+    }
+    bool forgotten = false;
+    for (auto it = m_directorySizes.begin(); it != m_directorySizes.end();) {
+        if (!scanned.contains(it.key())) {
+            it = m_directorySizes.erase(it);
+            forgotten = true;
+        } else {
+            ++it;
+        }
+    }
+    
+    if (m_unmeasured.isEmpty()) {
+        if (forgotten) {
+            saveDirectorySizes();
+        }
+        return;
+    }
+    
+    QStringList dirPaths = m_unmeasured;
+    m_unmeasured.clear();
+    m_sizePool.start([this, dirPaths]() {
+        QThread::currentThread()->setPriority(QThread::LowPriority);
+        
+        // Stamped before the walk, so a change during it is measured again
+        QHash<QString, QPair<qint64, qint64>> sizes;
+        for (const QString& dirPath : dirPaths) {
+            if (m_stopping) {
+                return;
+            }
+            qint64 stamp = sizeStamp(dirPath);
+            sizes.insert(dirPath, { stamp, directorySize(dirPath) });
+        }
+        
+        QMetaObject::invokeMethod(this, [this, sizes]() {
+            applyDirectorySizes(sizes);
+        }, Qt::QueuedConnection);
+    });
+}
+
+void WallpaperManager::applyDirectorySizes(const QHash<QString, QPair<qint64, qint64>>& sizes)
+{
+    for (auto it = sizes.constBegin(); it != sizes.constEnd(); ++it) {
+        m_directorySizes.insert(it.key(), it.value());
+    }
+    
+    for (WallpaperInfo& wallpaper : m_wallpapers) {
+        auto size = sizes.constFind(wallpaper.path);
+        if (size != sizes.constEnd()) {
+            wallpaper.fileSize = size->second;
+            emit wallpaperDetailsChanged(wallpaper);
+        }
+    }
+    
+    saveDirectorySizes();
+}
+
+void WallpaperManager::saveDirectorySizes()
+{
+    QVariantMap sizes;
+    for (auto it = m_directorySizes.constBegin(); it != m_directorySizes.constEnd(); ++it) {
+        sizes.insert(it.key(), QVariantList{ it.value().first, it.value().second });
+    }
+    ConfigManager::instance().setValue("cache/wallpaperSizes", sizes);
+}
+
+void WallpaperManager::mergeWorkshopDetails(WallpaperInfo& wallpaper, const WallpaperInfo& details)
+{
+    // Only what the workshop actually had; the size stays the one on disk
+    if (!details.name.isEmpty()) {
+        wallpaper.name = details.name;
+    }
+    if (!details.author.isEmpty()) {
+        wallpaper.author = details.author;
+    }
+    if (!details.description.isEmpty()) {
+        wallpaper.description = details.description;
+    }
+    if (!details.tags.isEmpty()) {
+        wallpaper.tags = details.tags;
+    }
+    if (!details.type.isEmpty()) {
+        wallpaper.type = details.type;
+    }
+    if (details.created.isValid()) {
+        wallpaper.created = details.created;
+    }
+    if (details.updated.isValid()) {
+        wallpaper.updated = details.updated;
+    }
+}
+
+void WallpaperManager::applyWorkshopDetails(const WallpaperInfo& details)
+{
+    m_workshopDetails.insert(details.id, details);
+    
+    for (WallpaperInfo& wallpaper : m_wallpapers) {
+        if (wallpaper.id == details.id) {
+            mergeWorkshopDetails(wallpaper, details);
+            emit wallpaperDetailsChanged(wallpaper);
+            return;
+        }
+    }
+}
+
+void WallpaperManager::onVideoPreviewGenerated(const QString& wallpaperId, const QString& previewPath)
+{
+    for (WallpaperInfo& wallpaper : m_wallpapers) {
+        if (wallpaper.id == wallpaperId) {
+            wallpaper.previewPath = previewPath;
+            emit wallpaperPreviewChanged(wallpaperId, previewPath);
+            return;
+        }
+    }
+}
+
 QString WallpaperManager::extractWorkshopId(const QString& dirPath)
 {
     QFileInfo pathInfo(dirPath);
@@ -275,28 +512,23 @@ bool WallpaperManager::launchWallpaper(const QString& wallpaperId, const QString
         return false;
     }
     
-    // Stop current wallpaper if running
-    stopWallpaper();
-    
-    // Create new process
-    m_wallpaperProcess = new QProcess(this);
-    connect(m_wallpaperProcess, QOverload<int, QProcess::ExitStatus>::of(&QProcess::finished),
-            this, &WallpaperManager::onProcessFinished);
-    connect(m_wallpaperProcess, &QProcess::errorOccurred,
-            this, &WallpaperManager::onProcessError);
-    connect(m_wallpaperProcess, &QProcess::readyReadStandardOutput,
-            this, &WallpaperManager::onProcessOutput);
-    connect(m_wallpaperProcess, &QProcess::readyReadStandardError,
-            this, &WallpaperManager::onProcessOutput);
+    // Only the renderer on the target output is replaced, other outputs keep running.
+    // Launch timings are measured from the stop request.
+    QString screenRoot = resolveScreenRoot(wallpaperId, additionalArgs);
+    LaunchTimings& timings = LaunchTimings::instance();
+    QElapsedTimer launchTimer;
+    launchTimer.start();
+    stopWallpaperOnScreen(screenRoot);
+    timings.beginLaunch(wallpaperId, "linux-wallpaperengine", launchTimer);
+    timings.markPhase(wallpaperId, LaunchTimings::Phase::OldProcessExited);
     
     // Build command line arguments
     QStringList args;
     
     // Add wallpaper-specific settings from ConfigManager
     
-    // Add screen-root if configured for this wallpaper
-    QString screenRoot = config.getWallpaperScreenRoot(wallpaperId);
-    if (!screenRoot.isEmpty()) {
+    // Add screen-root unless the UI already passed the output
+    if (!screenRoot.isEmpty() && RendererProcessManager::screenFromArgs(additionalArgs).isEmpty()) {
         args << "--screen-root" << screenRoot;
     }
     
@@ -357,56 +589,94 @@ bool WallpaperManager::launchWallpaper(const QString& wallpaperId, const QString
         }
     }
     
+    timings.markPhase(wallpaperId, LaunchTimings::Phase::ArgvBuilt);
+    
     emit outputReceived(QString("Launching wallpaper: %1").arg(wallpaper.name));
     emit outputReceived(QString("Command: %1 %2").arg(binaryPath, args.join(" ")));
     
     // Set working directory to the directory containing the binary
     QFileInfo binaryInfo(binaryPath);
     QString workingDir = binaryInfo.absolutePath();
-    m_wallpaperProcess->setWorkingDirectory(workingDir);
     
     // Preserve the current environment and add NVIDIA specific variables
     QProcessEnvironment env = QProcessEnvironment::systemEnvironment();
     env.insert("__NV_PRIME_RENDER_OFFLOAD", "1");
     env.insert("__GLX_VENDOR_LIBRARY_NAME", "nvidia");
-    m_wallpaperProcess->setProcessEnvironment(env);
     
-    // Start process
-    m_wallpaperProcess->start(binaryPath, args);
-    
-    if (!m_wallpaperProcess->waitForStarted(5000)) {
+    // Start the renderer for this output
+    if (!m_renderers->start(screenRoot, wallpaperId, binaryPath, args, workingDir, env)) {
+        timings.abortLaunch(wallpaperId);
         emit errorOccurred("Failed to start wallpaper process");
-        delete m_wallpaperProcess;
-        m_wallpaperProcess = nullptr;
         return false;
     }
     
+    if (m_renderers->isAdopted(screenRoot)) {
+        // Already running since the previous session, so there is no launch to time
+        timings.abortLaunch(wallpaperId);
+        emit outputReceived(QString("Adopted running wallpaper process %1 on %2")
+                           .arg(m_renderers->processId(screenRoot))
+                           .arg(RendererProcessManager::displayName(screenRoot)));
+    } else {
+        timings.markPhase(wallpaperId, LaunchTimings::Phase::Spawned);
+        timings.watchSteadyState(wallpaperId, m_renderers->processId(screenRoot));
+    }
+    
     m_currentWallpaperId = wallpaperId;
+    
+    // Kept for the library's "last used" sort order
+    m_lastUsed.insert(wallpaperId, QDateTime::currentMSecsSinceEpoch());
+    QVariantMap lastUsed;
+    for (auto it = m_lastUsed.constBegin(); it != m_lastUsed.constEnd(); ++it) {
+        lastUsed.insert(it.key(), it.value());
+    }
+    ConfigManager::instance().setValue("ui/wallpaperLastUsed", lastUsed);
+    
+    emit screenWallpaperChanged(screenRoot, wallpaperId);
     emit wallpaperLaunched(wallpaperId);
     return true;
 }
 
 void WallpaperManager::stopWallpaper()
 {
-    if (m_wallpaperProcess) {
-        emit outputReceived("Stopping wallpaper...");
-        m_wallpaperProcess->terminate();
-        
-        if (!m_wallpaperProcess->waitForFinished(5000)) {
-            m_wallpaperProcess->kill();
-            m_wallpaperProcess->waitForFinished(3000);
-        }
-        
-        delete m_wallpaperProcess;
-        m_wallpaperProcess = nullptr;
+    // Stop the renderers on every output
+    const QStringList screens = m_renderers->screens();
+    for (const QString& screenRoot : screens) {
+        stopWallpaperOnScreen(screenRoot);
+    }
+}
+
+bool WallpaperManager::stopWallpaperOnScreen(const QString& screenRoot)
+{
+    if (!m_renderers->hasRenderer(screenRoot)) {
+        return false;
+    }
+    
+    QString wallpaperId = m_renderers->wallpaperOn(screenRoot);
+    emit outputReceived(QString("Stopping wallpaper on %1...").arg(RendererProcessManager::displayName(screenRoot)));
+    m_renderers->stop(screenRoot);
+    
+    LaunchTimings::instance().abortLaunch(wallpaperId);
+    if (m_currentWallpaperId == wallpaperId && !isWallpaperActive(wallpaperId)) {
         m_currentWallpaperId.clear();
-        emit wallpaperStopped();
     }
+    emit screenWallpaperChanged(screenRoot, QString());
+    emit wallpaperStopped();
+    return true;
 }
 
 bool WallpaperManager::isWallpaperRunning() const
 {
-    return m_wallpaperProcess && m_wallpaperProcess->state() == QProcess::Running;
+    return m_renderers->isAnyRunning();
+}
+
+bool WallpaperManager::isWallpaperRunningOnScreen(const QString& screenRoot) const
+{
+    return m_renderers->isRunning(screenRoot);
+}
+
+bool WallpaperManager::isWallpaperActive(const QString& wallpaperId) const
+{
+    return !m_renderers->screensShowing(wallpaperId).isEmpty();
 }
 
 QString WallpaperManager::getCurrentWallpaper() const
@@ -414,26 +684,49 @@ QString WallpaperManager::getCurrentWallpaper() const
     return m_currentWallpaperId;
 }
 
-void WallpaperManager::onProcessFinished(int exitCode, QProcess::ExitStatus exitStatus)
+QString WallpaperManager::getWallpaperOnScreen(const QString& screenRoot) const
 {
-    emit outputReceived(QString("Wallpaper process finished (exit code: %1, status: %2)")
+    return m_renderers->wallpaperOn(screenRoot);
+}
+
+QStringList WallpaperManager::activeScreens() const
+{
+    return m_renderers->screens();
+}
+
+QString WallpaperManager::resolveScreenRoot(const QString& wallpaperId, const QStringList& additionalArgs)
+{
+    // The UI passes the effective output explicitly; fall back to the stored setting
+    QString screenRoot = RendererProcessManager::screenFromArgs(additionalArgs);
+    if (screenRoot.isEmpty()) {
+        screenRoot = ConfigManager::instance().getWallpaperScreenRoot(wallpaperId);
+    }
+    return screenRoot;
+}
+
+void WallpaperManager::onProcessFinished(const QString& screenRoot, const QString& wallpaperId, int exitCode, QProcess::ExitStatus exitStatus)
+{
+    emit outputReceived(QString("Wallpaper process on %1 finished (exit code: %2, status: %3)")
+                       .arg(RendererProcessManager::displayName(screenRoot))
                        .arg(exitCode)
                        .arg(exitStatus == QProcess::NormalExit ? "Normal" : "Crashed"));
     
-    m_currentWallpaperId.clear();
-    
-    if (m_wallpaperProcess) {
-        m_wallpaperProcess->deleteLater();
-        m_wallpaperProcess = nullptr;
+    LaunchTimings::instance().abortLaunch(wallpaperId);
+    if (m_currentWallpaperId == wallpaperId && !isWallpaperActive(wallpaperId)) {
+        m_currentWallpaperId.clear();
     }
     
+    emit screenWallpaperChanged(screenRoot, QString());
     emit wallpaperStopped();
 }
 
-void WallpaperManager::onProcessError(QProcess::ProcessError error)
+void WallpaperManager::onProcessError(const QString& screenRoot, const QString& wallpaperId, QProcess::ProcessError error)
 {
+    Q_UNUSED(wallpaperId)
+    
     // Only report actual errors, not normal operation
-    if (!m_wallpaperProcess) {
+    QPointer<QProcess> process = m_renderers->process(screenRoot);
+    if (!process) {
         return;
     }
     
@@ -441,14 +734,14 @@ void WallpaperManager::onProcessError(QProcess::ProcessError error)
     if (error == QProcess::Crashed) {
         // Use a single-shot timer to check the process state after a brief delay
         // This prevents false crash reports during process initialization
-        QTimer::singleShot(100, this, [this, error]() {
-            if (!m_wallpaperProcess) {
+        QTimer::singleShot(100, this, [this, process]() {
+            if (!process) {
                 return; // Process was cleaned up already
             }
             
             // Only report crash if process actually exited abnormally
-            if (m_wallpaperProcess->state() == QProcess::NotRunning && 
-                m_wallpaperProcess->exitStatus() == QProcess::CrashExit) {
+            if (process->state() == QProcess::NotRunning && 
+                process->exitStatus() == QProcess::CrashExit) {
                 emit outputReceived("ERROR: Wallpaper process crashed");
                 emit errorOccurred("Wallpaper process crashed");
             }
@@ -458,7 +751,7 @@ void WallpaperManager::onProcessError(QProcess::ProcessError error)
     }
     
     // For other errors, check immediately but still verify process state
-    if (m_wallpaperProcess->state() == QProcess::Running) {
+    if (process->state() == QProcess::Running) {
         // Process is still running, this might be a false alarm
         return;
     }
@@ -482,36 +775,39 @@ void WallpaperManager::onProcessError(QProcess::ProcessError error)
         break;
     }
     
-    emit outputReceived("ERROR: " + errorString);
+    emit outputReceived("ERROR: " + errorString, RendererLogClassifier::Severity::Error);
     emit errorOccurred(errorString);
 }
 
-void WallpaperManager::onProcessOutput()
+void WallpaperManager::onProcessOutput(const QString& screenRoot, const RendererOutput& output)
 {
-    if (m_wallpaperProcess) {
-        QByteArray data = m_wallpaperProcess->readAllStandardOutput();
-        if (!data.isEmpty()) {
-            emit outputReceived(QString::fromUtf8(data).trimmed());
+    Q_UNUSED(screenRoot)
+    
+    // Lines arrive decoded and classified by the renderer output worker, in
+    // order; each run of one channel goes out as a block with its prefix
+    using Channel = RendererOutput::Channel;
+    const QVector<RendererOutput::Entry>& entries = output.entries;
+    for (int first = 0; first < entries.size();) {
+        Channel channel = entries.at(first).channel;
+        QStringList lines;
+        int end = first;
+        while (end < entries.size() && entries.at(end).channel == channel) {
+            lines << entries.at(end).displayText();
+            ++end;
         }
+        first = end;
         
-        data = m_wallpaperProcess->readAllStandardError();
-        if (!data.isEmpty()) {
-            QString stderrOutput = QString::fromUtf8(data).trimmed();
-            
-            // Filter out normal mpv/wallpaper engine operational messages
-            // Only treat as errors if they contain actual error indicators
-            if (stderrOutput.contains("ERROR", Qt::CaseInsensitive) ||
-                stderrOutput.contains("FATAL", Qt::CaseInsensitive) ||
-                stderrOutput.contains("CRITICAL", Qt::CaseInsensitive) ||
-                (stderrOutput.contains("failed", Qt::CaseInsensitive) && 
-                 !stderrOutput.contains("Fullscreen detection not supported") &&
-                 !stderrOutput.contains("Failed to initialize GLEW"))) {
-                // This looks like an actual error
-                emit outputReceived("ERROR: " + stderrOutput);
-            } else {
-                // This is likely normal operational output (mpv logging, etc.)
-                emit outputReceived("LOG: " + stderrOutput);
-            }
+        switch (channel) {
+        case Channel::StandardOutput:
+            emit outputReceived(lines.join("\n"));
+            break;
+        case Channel::Errors:
+            emit outputReceived("ERROR: " + lines.join("\n"), output.severity);
+            break;
+        case Channel::Log:
+            // This is likely normal operational output (mpv logging, etc.)
+            emit outputReceived("LOG: " + lines.join("\n"), qMin(output.severity, RendererLogClassifier::Severity::Warning));
+            break;
         }
     }
 }
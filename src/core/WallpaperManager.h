@@ -8,7 +8,13 @@
 #include <QJsonArray>
 #include <QDateTime>
 #include <QFileSystemWatcher>
+#include <QSet>
+#include <QThreadPool>
+#include <atomic>
 #include <optional>
+#include "RendererOutputWorker.h"
+
+class RendererProcessManager;
 
 struct WallpaperInfo {
     QString id;
@@ -25,6 +31,7 @@ struct WallpaperInfo {
     qint64 fileSize = 0;
     QStringList tags;
     QJsonObject properties;  // Properties from project.json
+    QByteArray previewPlaceholder;  // Blurred stand-in for the preview, see PreviewPlaceholder
     
     WallpaperInfo() = default;
     
@@ -45,25 +52,47 @@ public:
     QList<WallpaperInfo> getAllWallpapers() const;
     WallpaperInfo getWallpaperById(const QString& id) const;
     std::optional<WallpaperInfo> getWallpaperInfo(const QString& id) const;
+    // When each wallpaper was last launched, in ms since epoch
+    QHash<QString, qint64> lastUsedTimes() const { return m_lastUsed; }
+    // Title, author, description, tags, type and dates fetched from the
+    // workshop; kept for the session, so a rescan doesn't lose them
+    void applyWorkshopDetails(const WallpaperInfo& details);
 
     bool launchWallpaper(const QString& wallpaperId, const QStringList& additionalArgs = QStringList());
+    // The output a launch with these arguments targets, also used by the WNEL addon
+    static QString resolveScreenRoot(const QString& wallpaperId, const QStringList& additionalArgs);
     void stopWallpaper();
     bool isWallpaperRunning() const;
     QString getCurrentWallpaper() const;
+    
+    // Per-output renderers, keyed by screen root
+    bool stopWallpaperOnScreen(const QString& screenRoot);
+    bool isWallpaperRunningOnScreen(const QString& screenRoot) const;
+    bool isWallpaperActive(const QString& wallpaperId) const;
+    QString getWallpaperOnScreen(const QString& screenRoot) const;
+    QStringList activeScreens() const;
+    RendererProcessManager* renderers() const { return m_renderers; }
 
 signals:
     void refreshProgress(int current, int total);
     void refreshFinished();
     void wallpapersChanged();
-    void outputReceived(const QString& output);
+    void outputReceived(const QString& output,
+                        RendererLogClassifier::Severity severity = RendererLogClassifier::Severity::Info);
     void errorOccurred(const QString& error);
     void wallpaperLaunched(const QString& wallpaperId);
     void wallpaperStopped();
+    void screenWallpaperChanged(const QString& screenRoot, const QString& wallpaperId);
+    // A preview was generated for a wallpaper that came without one
+    void wallpaperPreviewChanged(const QString& wallpaperId, const QString& previewPath);
+    // Workshop details were merged into a wallpaper of the catalog
+    void wallpaperDetailsChanged(const WallpaperInfo& wallpaper);
 
 private slots:
-    void onProcessFinished(int exitCode, QProcess::ExitStatus exitStatus);
-    void onProcessError(QProcess::ProcessError error);
-    void onProcessOutput();
+    void onProcessFinished(const QString& screenRoot, const QString& wallpaperId, int exitCode, QProcess::ExitStatus exitStatus);
+    void onProcessError(const QString& screenRoot, const QString& wallpaperId, QProcess::ProcessError error);
+    void onProcessOutput(const QString& screenRoot, const RendererOutput& output);
+    void onVideoPreviewGenerated(const QString& wallpaperId, const QString& previewPath);
 
 private:
     void scanWorkshopDirectories();
@@ -71,12 +100,28 @@ private:
     WallpaperInfo parseProjectJson(const QString& projectPath);
     QJsonObject extractProperties(const QJsonObject& projectJson);
     QString findPreviewImage(const QString& wallpaperDir);
+    QString findVideoFile(const QString& wallpaperDir);
     QString extractWorkshopId(const QString& dirPath);
     QStringList generatePropertyArguments(const QString& projectJsonPath);
+    // Wallpaper sizes on disk are measured on m_sizePool and kept, also
+    // across sessions, until the directory or its project.json changes
+    static qint64 directorySize(const QString& dirPath);
+    static qint64 sizeStamp(const QString& dirPath);
+    void measureDirectorySizes();
+    void applyDirectorySizes(const QHash<QString, QPair<qint64, qint64>>& sizes);
+    void saveDirectorySizes();
+    static void mergeWorkshopDetails(WallpaperInfo& wallpaper, const WallpaperInfo& details);
     
     QList<WallpaperInfo> m_wallpapers;
-    QProcess* m_wallpaperProcess;
-    QString m_currentWallpaperId;
+    QHash<QString, WallpaperInfo> m_workshopDetails;   // by wallpaper id
+    QSet<QString> m_generatedPreviews;  // made or requested during the last scan
+    QHash<QString, QPair<qint64, qint64>> m_directorySizes;     // path -> stamp, size
+    QStringList m_unmeasured;           // directories of the last scan without a size
+    QThreadPool m_sizePool;
+    std::atomic<bool> m_stopping;
+    RendererProcessManager* m_renderers;
+    QString m_currentWallpaperId;  // most recently launched wallpaper
+    QHash<QString, qint64> m_lastUsed;
     bool m_refreshing;
 };
 
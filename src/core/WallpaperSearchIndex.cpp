@@ -0,0 +1,522 @@
+#include "WallpaperSearchIndex.h"
+#include <QSet>
+#include <QFileInfo>
+#include <QDateTime>
+#include <algorithm>
+#include <iterator>
+#include <cmath>
+
+namespace {
+// Rebuild once this share of documents is removed ones
+constexpr int REBUILD_PERCENT = 50;
+constexpr int REBUILD_MIN_REMOVED = 256;
+
+// Ranking: per word, field weight times how well it hit
+constexpr float FIELD_WEIGHTS[] = { 4.0f, 2.0f, 1.5f, 1.0f };
+constexpr float WORD_START_QUALITY = 1.0f;
+constexpr float MID_WORD_QUALITY = 0.7f;
+constexpr float FUZZY_QUALITY = 0.5f;       // divided by the edit distance
+constexpr float TITLE_PREFIX_BONUS = 2.0f;  // the whole query starts the title
+// Recently updated wallpapers get up to this much, halving every half life
+constexpr float RECENCY_WEIGHT = 1.0f;
+constexpr double RECENCY_HALF_LIFE_DAYS = 180.0;
+constexpr qint64 MS_PER_DAY = 24LL * 60 * 60 * 1000;
+}
+
+WallpaperSearchIndex::WallpaperSearchIndex()
+    : m_removed(0)
+    , m_lastValid(false)
+{
+}
+
+QString WallpaperSearchIndex::fold(const QString& text)
+{
+    return text.toCaseFolded();
+}
+
+int WallpaperSearchIndex::typoBudget(int length)
+{
+    if (length < 4 || length > MAX_FUZZY_LENGTH) {
+        return 0;
+    }
+    return length < 8 ? 1 : 2;
+}
+
+QString WallpaperSearchIndex::searchText(const WallpaperInfo& wallpaper)
+{
+    // One field per line, in Field order; queries come from a line edit, so
+    // no match spans two
+    return QStringList{ wallpaper.name, wallpaper.tags.join(' '),
+                        wallpaper.author, wallpaper.description }.join('\n');
+}
+
+qint64 WallpaperSearchIndex::timestamp(const WallpaperInfo& wallpaper)
+{
+    if (wallpaper.updated.isValid()) {
+        return wallpaper.updated.toMSecsSinceEpoch();
+    }
+    if (wallpaper.created.isValid()) {
+        return wallpaper.created.toMSecsSinceEpoch();
+    }
+    // Without workshop dates, when it was installed or last changed locally
+    if (!wallpaper.projectPath.isEmpty()) {
+        QDateTime modified = QFileInfo(wallpaper.projectPath).lastModified();
+        return modified.isValid() ? modified.toMSecsSinceEpoch() : 0;
+    }
+    return 0;
+}
+
+QVector<quint64> WallpaperSearchIndex::trigrams(const QString& folded)
+{
+    QVector<quint64> grams;
+    if (folded.size() < 3) {
+        return grams;
+    }
+    
+    grams.reserve(folded.size() - 2);
+    const QChar* text = folded.constData();
+    for (int i = 0; i + 2 < folded.size(); ++i) {
+        if (text[i] == '\n' || text[i + 1] == '\n' || text[i + 2] == '\n') {
+            continue;
+        }
+        grams.append((quint64(text[i].unicode()) << 32) |
+                     (quint64(text[i + 1].unicode()) << 16) |
+                     quint64(text[i + 2].unicode()));
+    }
+    
+    std::sort(grams.begin(), grams.end());
+    grams.erase(std::unique(grams.begin(), grams.end()), grams.end());
+    return grams;
+}
+
+quint64 WallpaperSearchIndex::signature(const QChar* text, int length)
+{
+    // One bit per letter and digit, the rest of the alphabet shares what is
+    // left; spaces and punctuation don't count
+    quint64 bits = 0;
+    for (int i = 0; i < length; ++i) {
+        ushort c = text[i].unicode();
+        if (c >= 'a' && c <= 'z') {
+            bits |= quint64(1) << (c - 'a');
+        } else if (c >= '0' && c <= '9') {
+            bits |= quint64(1) << (26 + c - '0');
+        } else if (c > 127 && text[i].isLetterOrNumber()) {
+            bits |= quint64(1) << (36 + c % 28);
+        }
+    }
+    return bits;
+}
+
+int WallpaperSearchIndex::fuzzyDistance(const QChar* text, int length, const QString& term, int* end)
+{
+    // Optimal string alignment distance of term to its best matching span of
+    // text: a typo, missing or extra character, or swapped pair costs one.
+    // The span may start and end anywhere, so row 0 is free
+    const int m = term.size();
+    const QChar* word = term.constData();
+    int rows[3][MAX_FUZZY_LENGTH + 1];
+    int* beforePrevious = rows[0];
+    int* previous = rows[1];
+    int* current = rows[2];
+    for (int j = 0; j <= m; ++j) {
+        beforePrevious[j] = j;
+        previous[j] = j;
+    }
+    
+    int best = m;
+    *end = 0;
+    for (int i = 1; i <= length; ++i) {
+        QChar c = text[i - 1];
+        current[0] = 0;
+        for (int j = 1; j <= m; ++j) {
+            int cost = c == word[j - 1] ? 0 : 1;
+            int value = qMin(qMin(previous[j] + 1, current[j - 1] + 1), previous[j - 1] + cost);
+            if (i > 1 && j > 1 && c == word[j - 2] && text[i - 2] == word[j - 1]) {
+                value = qMin(value, beforePrevious[j - 2] + 1);
+            }
+            current[j] = value;
+        }
+        
+        if (current[m] < best) {
+            best = current[m];
+            *end = i - 1;
+            if (best == 0) {
+                break;
+            }
+        }
+        
+        int* recycled = beforePrevious;
+        beforePrevious = previous;
+        previous = current;
+        current = recycled;
+    }
+    return best;
+}
+
+void WallpaperSearchIndex::update(const QList<WallpaperInfo>& wallpapers)
+{
+    bool changed = false;
+    QSet<QString> present;
+    present.reserve(wallpapers.size());
+    
+    for (const WallpaperInfo& wallpaper : wallpapers) {
+        present.insert(wallpaper.id);
+        QString folded = fold(searchText(wallpaper));
+        
+        int document = documentOf(wallpaper.id);
+        if (document >= 0) {
+            if (m_texts.at(document) == folded) {
+                // Workshop dates arrive after the scan
+                if (wallpaper.updated.isValid() || wallpaper.created.isValid()) {
+                    m_timestamps[document] = timestamp(wallpaper);
+                }
+                continue;
+            }
+            removeDocument(document);
+        }
+        addDocument(wallpaper.id, folded, timestamp(wallpaper));
+        changed = true;
+    }
+    
+    QVector<int> gone;
+    for (auto it = m_documents.constBegin(); it != m_documents.constEnd(); ++it) {
+        if (!present.contains(it.key())) {
+            gone.append(it.value());
+        }
+    }
+    for (int document : gone) {
+        removeDocument(document);
+        changed = true;
+    }
+    
+    if (m_removed >= REBUILD_MIN_REMOVED && m_removed * 100 >= m_texts.size() * REBUILD_PERCENT) {
+        rebuild();
+    }
+    
+    // Rankings may have changed even when the text didn't
+    m_lastQuery.clear();
+    if (changed) {
+        m_lastValid = false;
+    }
+}
+
+void WallpaperSearchIndex::clear()
+{
+    m_texts.clear();
+    m_ids.clear();
+    m_headLengths.clear();
+    m_headSignatures.clear();
+    m_timestamps.clear();
+    m_documents.clear();
+    m_postings.clear();
+    m_removed = 0;
+    m_lastValid = false;
+    m_lastQuery.clear();
+    m_lastExact.clear();
+    m_matches.clear();
+}
+
+void WallpaperSearchIndex::addDocument(const QString& wallpaperId, const QString& folded, qint64 timestamp)
+{
+    int document = m_texts.size();
+    
+    // Title, tags and author end at the third line break
+    int headLength = -1;
+    for (int field = Title; field < Description; ++field) {
+        headLength = folded.indexOf('\n', headLength + 1);
+    }
+    if (headLength < 0) {
+        headLength = folded.size();
+    }
+    
+    m_texts.append(folded);
+    m_ids.append(wallpaperId);
+    m_headLengths.append(headLength);
+    m_headSignatures.append(signature(folded.constData(), headLength));
+    m_timestamps.append(timestamp);
+    m_documents.insert(wallpaperId, document);
+    
+    for (quint64 gram : trigrams(folded)) {
+        m_postings[gram].append(document);
+    }
+}
+
+void WallpaperSearchIndex::removeDocument(int document)
+{
+    for (quint64 gram : trigrams(m_texts.at(document))) {
+        auto it = m_postings.find(gram);
+        if (it == m_postings.end()) {
+            continue;
+        }
+        auto position = std::lower_bound(it->begin(), it->end(), document);
+        if (position != it->end() && *position == document) {
+            it->erase(position);
+        }
+        if (it->isEmpty()) {
+            m_postings.erase(it);
+        }
+    }
+    
+    m_documents.remove(m_ids.at(document));
+    m_texts[document].clear();
+    m_ids[document].clear();
+    m_headLengths[document] = 0;
+    m_headSignatures[document] = 0;
+    ++m_removed;
+}
+
+void WallpaperSearchIndex::rebuild()
+{
+    QVector<QString> texts = m_texts;
+    QVector<QString> ids = m_ids;
+    QVector<qint64> timestamps = m_timestamps;
+    clear();
+    
+    for (int i = 0; i < ids.size(); ++i) {
+        if (!ids.at(i).isEmpty()) {
+            addDocument(ids.at(i), texts.at(i), timestamps.at(i));
+        }
+    }
+}
+
+QVector<int> WallpaperSearchIndex::allDocuments() const
+{
+    QVector<int> documents;
+    documents.reserve(m_documents.size());
+    for (int i = 0; i < m_ids.size(); ++i) {
+        if (!m_ids.at(i).isEmpty()) {
+            documents.append(i);
+        }
+    }
+    return documents;
+}
+
+QVector<int> WallpaperSearchIndex::scan(const QString& term, const QVector<int>& candidates) const
+{
+    QVector<int> matches;
+    for (int document : candidates) {
+        if (!m_ids.at(document).isEmpty() && m_texts.at(document).contains(term)) {
+            matches.append(document);
+        }
+    }
+    return matches;
+}
+
+QVector<int> WallpaperSearchIndex::lookup(const QString& term) const
+{
+    QVector<const QVector<int>*> lists;
+    for (quint64 gram : trigrams(term)) {
+        auto it = m_postings.constFind(gram);
+        if (it == m_postings.constEnd()) {
+            return QVector<int>();
+        }
+        lists.append(&it.value());
+    }
+    if (lists.isEmpty()) {
+        return QVector<int>();
+    }
+    
+    // Rarest trigram first keeps every intersection small
+    std::sort(lists.begin(), lists.end(), [](const QVector<int>* a, const QVector<int>* b) {
+        return a->size() < b->size();
+    });
+    
+    QVector<int> candidates = *lists.first();
+    for (int i = 1; i < lists.size() && !candidates.isEmpty(); ++i) {
+        QVector<int> narrowed;
+        narrowed.reserve(candidates.size());
+        std::set_intersection(candidates.constBegin(), candidates.constEnd(),
+                              lists.at(i)->constBegin(), lists.at(i)->constEnd(),
+                              std::back_inserter(narrowed));
+        candidates.swap(narrowed);
+    }
+    
+    // Every trigram present doesn't mean they are in order; check the text
+    return scan(term, candidates);
+}
+
+QVector<int> WallpaperSearchIndex::exactDocuments(const QStringList& terms) const
+{
+    // Longer words are rarer; start with them and scan for the short ones
+    QStringList ordered = terms;
+    std::sort(ordered.begin(), ordered.end(), [](const QString& a, const QString& b) {
+        return a.size() > b.size();
+    });
+    
+    QVector<int> documents;
+    bool first = true;
+    for (const QString& term : ordered) {
+        if (term.size() >= 3) {
+            QVector<int> matches = lookup(term);
+            if (first) {
+                documents = matches;
+            } else {
+                QVector<int> narrowed;
+                std::set_intersection(documents.constBegin(), documents.constEnd(),
+                                      matches.constBegin(), matches.constEnd(),
+                                      std::back_inserter(narrowed));
+                documents.swap(narrowed);
+            }
+        } else {
+            documents = scan(term, first ? allDocuments() : documents);
+        }
+        first = false;
+        
+        if (documents.isEmpty()) {
+            break;
+        }
+    }
+    return documents;
+}
+
+bool WallpaperSearchIndex::matchTerm(int document, const QString& term, bool headOnly, TermHit& hit) const
+{
+    const QString& text = m_texts.at(document);
+    int headLength = m_headLengths.at(document);
+    
+    // Fields are stored best first, so the first exact hit is the best one
+    int position = headOnly ? QStringView(text).left(headLength).indexOf(term) : text.indexOf(term);
+    if (position >= 0) {
+        hit.field = int(std::count(text.constBegin(), text.constBegin() + position, QChar('\n')));
+        hit.distance = 0;
+        hit.wordStart = position == 0 || !text.at(position - 1).isLetterOrNumber();
+        return true;
+    }
+    
+    // Only the fuzzy pass gets here; the caller checked the signatures
+    int budget = typoBudget(term.size());
+    if (!headOnly || budget == 0) {
+        return false;
+    }
+    
+    int end = 0;
+    int distance = fuzzyDistance(text.constData(), headLength, term, &end);
+    if (distance > budget) {
+        return false;
+    }
+    hit.field = int(std::count(text.constBegin(), text.constBegin() + end, QChar('\n')));
+    hit.distance = distance;
+    hit.wordStart = false;
+    return true;
+}
+
+bool WallpaperSearchIndex::mayMatchFuzzy(int document, const QVector<quint64>& termSignatures,
+                                         const QVector<int>& budgets) const
+{
+    // Each typo can take away at most one of a word's characters, so a word
+    // can't be in the head if more of its characters are missing from it
+    quint64 head = m_headSignatures.at(document);
+    for (int i = 0; i < termSignatures.size(); ++i) {
+        if (qPopulationCount(termSignatures.at(i) & ~head) > budgets.at(i)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+float WallpaperSearchIndex::score(int document, const QString& folded, const QStringList& terms,
+                                  bool headOnly, qint64 now) const
+{
+    float total = 0.0f;
+    for (int i = 0; i < terms.size(); ++i) {
+        TermHit hit;
+        if (!matchTerm(document, terms.at(i), headOnly, hit)) {
+            return -1.0f;
+        }
+        
+        float quality = hit.distance > 0 ? FUZZY_QUALITY / hit.distance
+                      : hit.wordStart ? WORD_START_QUALITY : MID_WORD_QUALITY;
+        total += FIELD_WEIGHTS[qBound(0, hit.field, int(Description))] * quality;
+    }
+    
+    if (m_texts.at(document).startsWith(folded)) {
+        total += TITLE_PREFIX_BONUS;
+    }
+    
+    qint64 timestamp = m_timestamps.at(document);
+    if (timestamp > 0) {
+        double ageDays = qMax<qint64>(0, now - timestamp) / double(MS_PER_DAY);
+        total += RECENCY_WEIGHT * float(std::exp2(-ageDays / RECENCY_HALF_LIFE_DAYS));
+    }
+    return total;
+}
+
+const QVector<WallpaperSearchIndex::Match>& WallpaperSearchIndex::search(const QString& query)
+{
+    QString folded = fold(query).simplified();
+    if (m_lastValid && !folded.isEmpty() && folded == m_lastQuery) {
+        return m_matches;
+    }
+    
+    m_matches.clear();
+    QStringList terms = folded.split(' ', Qt::SkipEmptyParts);
+    if (terms.isEmpty()) {
+        m_lastValid = false;
+        m_lastQuery.clear();
+        return m_matches;
+    }
+    
+    // Documents containing every word as typed. Typing on can only drop some:
+    // each earlier word is part of one of the new ones
+    QVector<int> exact;
+    if (m_lastValid && !m_lastQuery.isEmpty() && folded.contains(m_lastQuery)) {
+        exact = m_lastExact;
+        for (const QString& term : terms) {
+            exact = scan(term, exact);
+        }
+    } else {
+        exact = exactDocuments(terms);
+    }
+    m_lastQuery = folded;
+    m_lastExact = exact;
+    m_lastValid = true;
+    
+    qint64 now = QDateTime::currentMSecsSinceEpoch();
+    m_matches.reserve(exact.size());
+    for (int document : exact) {
+        float documentScore = score(document, folded, terms, false, now);
+        if (documentScore >= 0.0f) {
+            m_matches.append(Match{ document, documentScore });
+        }
+    }
+    
+    // Words long enough for typos may also match with them, but only in title,
+    // tags and author, and only where the signatures leave room for it. That
+    // check is a few bit operations per wallpaper; only the survivors are
+    // aligned, and never against their descriptions
+    bool fuzzy = false;
+    QVector<quint64> termSignatures;
+    QVector<int> budgets;
+    for (const QString& term : terms) {
+        termSignatures.append(signature(term.constData(), term.size()));
+        budgets.append(typoBudget(term.size()));
+        fuzzy = fuzzy || budgets.last() > 0;
+    }
+    
+    if (fuzzy) {
+        auto nextExact = exact.constBegin();
+        for (int document = 0; document < m_ids.size(); ++document) {
+            // exact is ascending, so walking it alongside skips its documents
+            while (nextExact != exact.constEnd() && *nextExact < document) {
+                ++nextExact;
+            }
+            if (nextExact != exact.constEnd() && *nextExact == document) {
+                continue;
+            }
+            if (m_ids.at(document).isEmpty() || !mayMatchFuzzy(document, termSignatures, budgets)) {
+                continue;
+            }
+            
+            float documentScore = score(document, folded, terms, true, now);
+            if (documentScore >= 0.0f) {
+                m_matches.append(Match{ document, documentScore });
+            }
+        }
+    }
+    
+    // Ties keep catalog order
+    std::stable_sort(m_matches.begin(), m_matches.end(), [](const Match& a, const Match& b) {
+        return a.score > b.score;
+    });
+    return m_matches;
+}
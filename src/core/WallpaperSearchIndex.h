@@ -0,0 +1,100 @@
+#ifndef WALLPAPERSEARCHINDEX_H
+#define WALLPAPERSEARCHINDEX_H
+
+#include <QString>
+#include <QStringList>
+#include <QVector>
+#include <QHash>
+#include "WallpaperManager.h"
+
+// Ranked search over the wallpaper catalog. Title, tags, author and
+// description are case folded once into one text column per wallpaper.
+//
+// Every word of a query has to match. Wallpapers with every word as typed
+// come from trigram posting lists, intersected shortest first and then
+// confirmed with a substring match. A query that contains the previous one
+// only filters that one's exact hits. Words of four or more characters may
+// also be off by one typo or swapped pair (two from eight characters on); a
+// wallpaper matched that way needs every word in its title, tags and author.
+// Only wallpapers whose character signature there, one bit per letter or
+// digit, leaves room for every word within its typo budget are aligned.
+//
+// Results are ranked by where the words hit (title over tags over author over
+// description), how closely, and how recently the wallpaper was updated.
+// update() re-indexes only wallpapers that were added, removed or changed.
+class WallpaperSearchIndex
+{
+public:
+    struct Match {
+        int document;
+        float score;
+    };
+    
+    WallpaperSearchIndex();
+    
+    void update(const QList<WallpaperInfo>& wallpapers);
+    void clear();
+    
+    // Matches for query, best first; empty for an empty query
+    const QVector<Match>& search(const QString& query);
+    
+    const QString& wallpaperId(int document) const { return m_ids.at(document); }
+    int documentOf(const QString& wallpaperId) const { return m_documents.value(wallpaperId, -1); }
+    int documentCount() const { return m_documents.size(); }
+    int trigramCount() const { return m_postings.size(); }
+    
+    static QString fold(const QString& text);
+    // Typos a word of this length may contain
+    static int typoBudget(int length);
+    
+    // Longer words only match exactly
+    static constexpr int MAX_FUZZY_LENGTH = 32;
+
+private:
+    enum Field { Title, Tags, Author, Description };
+    
+    struct TermHit {
+        int field = Title;
+        int distance = 0;
+        bool wordStart = false;
+    };
+    
+    static QString searchText(const WallpaperInfo& wallpaper);
+    static QVector<quint64> trigrams(const QString& folded);
+    static quint64 signature(const QChar* text, int length);
+    static qint64 timestamp(const WallpaperInfo& wallpaper);
+    static int fuzzyDistance(const QChar* text, int length, const QString& term, int* end);
+    
+    void addDocument(const QString& wallpaperId, const QString& folded, qint64 timestamp);
+    void removeDocument(int document);
+    void rebuild();
+    
+    QVector<int> exactDocuments(const QStringList& terms) const;
+    QVector<int> lookup(const QString& term) const;
+    QVector<int> scan(const QString& term, const QVector<int>& candidates) const;
+    QVector<int> allDocuments() const;
+    
+    // headOnly: the fuzzy pass, which only looks at title, tags and author
+    bool matchTerm(int document, const QString& term, bool headOnly, TermHit& hit) const;
+    bool mayMatchFuzzy(int document, const QVector<quint64>& termSignatures, const QVector<int>& budgets) const;
+    float score(int document, const QString& folded, const QStringList& terms,
+                bool headOnly, qint64 now) const;
+    
+    // Documents are only ever appended, so posting lists stay sorted; removed
+    // ones leave an empty id behind until the next rebuild
+    QVector<QString> m_texts;           // title \n tags \n author \n description
+    QVector<QString> m_ids;
+    QVector<int> m_headLengths;         // title, tags and author, for fuzzy hits
+    QVector<quint64> m_headSignatures;
+    QVector<qint64> m_timestamps;       // ms since epoch, 0 if unknown
+    QHash<QString, int> m_documents;
+    QHash<quint64, QVector<int>> m_postings;
+    int m_removed;
+    
+    QString m_lastQuery;
+    QVector<int> m_lastExact;
+    bool m_lastValid;
+    QVector<Match> m_matches;
+};
+
+#endif // WALLPAPERSEARCHINDEX_H
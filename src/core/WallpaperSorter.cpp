@@ -0,0 +1,155 @@
+#include "WallpaperSorter.h"
+#include <QFileInfo>
+#include <QDateTime>
+#include <algorithm>
+
+WallpaperSorter::Order WallpaperSorter::orderFromString(const QString& order)
+{
+    if (order == "name") {
+        return Order::Name;
+    }
+    if (order == "author") {
+        return Order::Author;
+    }
+    if (order == "size") {
+        return Order::Size;
+    }
+    if (order == "added") {
+        return Order::DateAdded;
+    }
+    if (order == "updated") {
+        return Order::Updated;
+    }
+    if (order == "last_used") {
+        return Order::LastUsed;
+    }
+    return Order::Default;
+}
+
+QString WallpaperSorter::orderToString(Order order)
+{
+    switch (order) {
+    case Order::Name:
+        return "name";
+    case Order::Author:
+        return "author";
+    case Order::Size:
+        return "size";
+    case Order::DateAdded:
+        return "added";
+    case Order::Updated:
+        return "updated";
+    case Order::LastUsed:
+        return "last_used";
+    case Order::Default:
+        break;
+    }
+    return "default";
+}
+
+WallpaperSorter::WallpaperSorter()
+{
+    // "Wallpaper 2" before "Wallpaper 10"; names differing only in case
+    // compare equal and keep their current order
+    m_collator.setNumericMode(true);
+    m_collator.setCaseSensitivity(Qt::CaseInsensitive);
+}
+
+qint64 WallpaperSorter::addedTime(const WallpaperInfo& wallpaper)
+{
+    if (wallpaper.path.isEmpty()) {
+        return 0;
+    }
+    
+    // The workshop directory is created when the item is downloaded
+    QFileInfo info(wallpaper.path);
+    QDateTime added = info.birthTime();
+    if (!added.isValid()) {
+        added = info.lastModified();
+    }
+    return added.isValid() ? added.toMSecsSinceEpoch() : 0;
+}
+
+void WallpaperSorter::update(const QList<WallpaperInfo>& wallpapers, const QHash<QString, qint64>& lastUsed)
+{
+    QHash<QString, Key> keys;
+    keys.reserve(wallpapers.size());
+    m_rows.clear();
+    m_rows.reserve(wallpapers.size());
+    
+    for (const WallpaperInfo& wallpaper : wallpapers) {
+        Key key = m_keysById.value(wallpaper.id);
+        
+        // Collation keys are the expensive part; only make them when needed
+        if (!key.nameKey || key.name != wallpaper.name) {
+            key.name = wallpaper.name;
+            key.nameKey = m_collator.sortKey(wallpaper.name);
+        }
+        if (!key.authorKey || key.author != wallpaper.author) {
+            key.author = wallpaper.author;
+            key.authorKey = m_collator.sortKey(wallpaper.author);
+        }
+        if (key.added == 0) {
+            key.added = addedTime(wallpaper);
+        }
+        
+        key.size = wallpaper.fileSize;
+        key.updated = wallpaper.updated.isValid() ? wallpaper.updated.toMSecsSinceEpoch()
+                    : wallpaper.created.isValid() ? wallpaper.created.toMSecsSinceEpoch() : 0;
+        key.lastUsed = lastUsed.value(wallpaper.id, 0);
+        
+        keys.insert(wallpaper.id, key);
+        m_rows.append(key);
+    }
+    
+    // Wallpapers that are gone don't keep their keys
+    m_keysById.swap(keys);
+}
+
+void WallpaperSorter::setLastUsed(int row, qint64 time)
+{
+    if (row < 0 || row >= m_rows.size()) {
+        return;
+    }
+    m_rows[row].lastUsed = time;
+}
+
+void WallpaperSorter::sort(QVector<int>& rows, Order order) const
+{
+    auto byNumber = [this, &rows](qint64 Key::*field) {
+        std::stable_sort(rows.begin(), rows.end(), [this, field](int a, int b) {
+            return m_rows.at(a).*field > m_rows.at(b).*field;
+        });
+    };
+    
+    switch (order) {
+    case Order::Default:
+        break;
+    case Order::Name:
+        std::stable_sort(rows.begin(), rows.end(), [this](int a, int b) {
+            return m_rows.at(a).nameKey->compare(*m_rows.at(b).nameKey) < 0;
+        });
+        break;
+    case Order::Author:
+        std::stable_sort(rows.begin(), rows.end(), [this](int a, int b) {
+            int author = m_rows.at(a).authorKey->compare(*m_rows.at(b).authorKey);
+            if (author != 0) {
+                return author < 0;
+            }
+            return m_rows.at(a).nameKey->compare(*m_rows.at(b).nameKey) < 0;
+        });
+        break;
+    case Order::Size:
+        byNumber(&Key::size);
+        break;
+    case Order::DateAdded:
+        byNumber(&Key::added);
+        break;
+    case Order::Updated:
+        byNumber(&Key::updated);
+        break;
+    case Order::LastUsed:
+        byNumber(&Key::lastUsed);
+        break;
+    }
+}
@@ -0,0 +1,62 @@
+#ifndef WALLPAPERSORTER_H
+#define WALLPAPERSORTER_H
+
+#include <QString>
+#include <QVector>
+#include <QHash>
+#include <QCollator>
+#include <QCollatorSortKey>
+#include <optional>
+#include "WallpaperManager.h"
+
+// Sort orders for the library grid. Everything a sort looks at is computed
+// once per catalog entry: locale collation keys for name and author, and the
+// size and dates as plain numbers. Sorting then only compares keys, however
+// large the library. update() recomputes keys only for wallpapers that are
+// new or whose name or author changed.
+class WallpaperSorter
+{
+public:
+    enum class Order {
+        Default,    // scan order, or best match first while searching
+        Name,
+        Author,
+        Size,       // largest first
+        DateAdded,  // newest first
+        Updated,    // newest first
+        LastUsed    // most recent first, never used last
+    };
+    
+    static Order orderFromString(const QString& order);
+    static QString orderToString(Order order);
+    
+    WallpaperSorter();
+    
+    // Keys for catalog rows, in the order of wallpapers. lastUsed holds launch
+    // times in ms since epoch by wallpaper id
+    void update(const QList<WallpaperInfo>& wallpapers, const QHash<QString, qint64>& lastUsed);
+    void setLastUsed(int row, qint64 time);
+    
+    // Sorts catalog rows; equal keys keep their current order
+    void sort(QVector<int>& rows, Order order) const;
+
+private:
+    struct Key {
+        QString name;   // what the collation keys were made from
+        QString author;
+        std::optional<QCollatorSortKey> nameKey;
+        std::optional<QCollatorSortKey> authorKey;
+        qint64 size = 0;
+        qint64 added = 0;
+        qint64 updated = 0;
+        qint64 lastUsed = 0;
+    };
+    
+    static qint64 addedTime(const WallpaperInfo& wallpaper);
+    
+    QCollator m_collator;
+    QHash<QString, Key> m_keysById;     // survives catalog reloads
+    QVector<Key> m_rows;                // per catalog row
+};
+
+#endif // WALLPAPERSORTER_H
@@ -2,10 +2,19 @@
 #include "../widgets/WallpaperPreview.h"
 #include "PropertiesPanel.h"
 #include "../widgets/PlaylistPreview.h"
+#include "../widgets/OutputLogView.h"
 #include "../playlist/WallpaperPlaylist.h"
 #include "SettingsDialog.h"
 #include "../core/ConfigManager.h"
 #include "../core/WallpaperManager.h"
+#include "../core/LaunchTimings.h"
+#include "../core/RendererProcessManager.h"
+#include "../core/PowerProfileService.h"
+#include "../core/RendererLogClassifier.h"
+#include "../core/RotatingLogFile.h"
+#include "../core/ThumbnailCache.h"
+#include "../core/PreviewPixmapCache.h"
+#include "../core/PreviewAnimator.h"
 #include "../steam/SteamDetector.h"
 #include "../addons/WNELAddon.h"  // Add WNEL addon include
 #include <QApplication>
@@ -47,6 +56,9 @@
 #include <QMimeData>
 #include <QDragMoveEvent>
 #include <QWidget>
+#include <QDialog>
+#include <QDialogButtonBox>
+#include <QPlainTextEdit>
 
 Q_LOGGING_CATEGORY(mainWindow, "app.mainwindow")
 
@@ -212,6 +224,8 @@ MainWindow::MainWindow(QWidget *parent)
     , m_wallpaperManager(new WallpaperManager(this))
     , m_wallpaperPlaylist(new WallpaperPlaylist(this))
     , m_wnelAddon(new WNELAddon(this))
+    , m_powerProfile(new PowerProfileService(this))
+    , m_logFile(new RotatingLogFile(this))
     , m_refreshing(false)
     , m_isClosing(false)
     , m_startMinimized(false)
@@ -232,10 +246,14 @@ MainWindow::MainWindow(QWidget *parent)
     setWindowTitle("Wallpaper Engine GUI");
     setWindowIcon(QIcon(":/icons/icons/wallpaper.png"));
     
+    applyLogFileSettings();
     setupUI();
     setupSystemTray();
     loadSettings();
     
+    // Watch AC/battery state for the battery profile
+    m_powerProfile->start();
+    
     // Check for first run after UI is set up
     QTimer::singleShot(100, this, &MainWindow::checkFirstRun);
 }
@@ -336,6 +354,13 @@ void MainWindow::setupMenuBar()
     // Help menu
     auto *helpMenu = menuBar()->addMenu("&Help");
     
+    auto *launchTimingsAction = new QAction("&Launch Timings...", this);
+    launchTimingsAction->setStatusTip("Show wallpaper launch latency histograms");
+    connect(launchTimingsAction, &QAction::triggered, this, &MainWindow::showLaunchTimings);
+    helpMenu->addAction(launchTimingsAction);
+    
+    helpMenu->addSeparator();
+    
     m_aboutAction = new QAction("&About", this);
     m_aboutAction->setStatusTip("Show application information");
     connect(m_aboutAction, &QAction::triggered, this, &MainWindow::showAbout);
@@ -460,16 +485,24 @@ void MainWindow::createCentralWidget()
     m_rightTabWidget = m_propertiesPanel->m_innerTabWidget;
 
     // instantiate output controls
-    m_outputTextEdit    = new QTextEdit;
+    m_outputLogView     = new OutputLogView;
+    m_logCountersLabel  = new QLabel;
     m_clearOutputButton = new QPushButton("Clear");
     m_saveOutputButton  = new QPushButton("Save Log");
-    m_outputTextEdit->setReadOnly(true);
+    m_outputLogView->logModel()->setCapacity(m_config.outputLogLines());
+    
+    // Renderer line counters are atomics, polling them once a second is cheap
+    auto* logCountersTimer = new QTimer(this);
+    connect(logCountersTimer, &QTimer::timeout, this, &MainWindow::updateLogCounters);
+    logCountersTimer->start(1000);
+    updateLogCounters();
     connect(m_clearOutputButton, &QPushButton::clicked, this, &MainWindow::clearOutput);
     connect(m_saveOutputButton,  &QPushButton::clicked, this, &MainWindow::saveOutput);
 
     // reparent output controls into "Engine Log" tab
     if (auto *logLayout = qobject_cast<QVBoxLayout*>(m_propertiesPanel->engineLogTab()->layout())) {
-        logLayout->addWidget(m_outputTextEdit);
+        logLayout->addWidget(m_outputLogView);
+        logLayout->addWidget(m_logCountersLabel);
         logLayout->addWidget(m_clearOutputButton);
         logLayout->addWidget(m_saveOutputButton);
     }
@@ -540,6 +573,10 @@ void MainWindow::createCentralWidget()
     // wallpaper manager → clear last wallpaper on stop
     connect(m_wallpaperManager, &WallpaperManager::wallpaperStopped,
             this, &MainWindow::onWallpaperStopped);
+    
+    // power profile → lighter profile on battery, normal profile on AC
+    connect(m_powerProfile, &PowerProfileService::powerSourceChanged,
+            this, &MainWindow::onPowerSourceChanged);
 
     // playlist → launch wallpaper with proper source tracking
     connect(m_wallpaperPlaylist, &WallpaperPlaylist::playlistLaunchRequested,
@@ -677,6 +714,7 @@ void MainWindow::changeEvent(QEvent *event)
             if (m_playlistPreview) {
                 m_playlistPreview->stopAllPreviewAnimations();
             }
+            PreviewAnimator::instance().setPaused(true);
             
             if (m_systemTrayIcon && m_systemTrayIcon->isVisible()) {
                 hideToTray();
@@ -692,6 +730,7 @@ void MainWindow::changeEvent(QEvent *event)
             if (m_playlistPreview) {
                 m_playlistPreview->startAllPreviewAnimations();
             }
+            PreviewAnimator::instance().setPaused(false);
         }
     }
     QMainWindow::changeEvent(event);
@@ -847,6 +886,7 @@ void MainWindow::showWindow()
     if (m_playlistPreview) {
         m_playlistPreview->startAllPreviewAnimations();
     }
+    PreviewAnimator::instance().setPaused(false);
     
     // Update menu actions
     if (m_showAction && m_hideAction) {
@@ -867,6 +907,7 @@ void MainWindow::hideToTray()
     if (m_playlistPreview) {
         m_playlistPreview->stopAllPreviewAnimations();
     }
+    PreviewAnimator::instance().setPaused(true);
     
     hide();
     
@@ -1044,6 +1085,27 @@ void MainWindow::openSettings()
     if (dialog.exec() == QDialog::Accepted) {
         // Settings were saved, update status
         updateStatusBar();
+        m_powerProfile->reloadSettings();
+        m_powerProfile->poll();
+        
+        // Renderer output capture (redirection changes apply to the next launch)
+        RendererOutputWorker::CaptureMode captureMode =
+            RendererOutputWorker::captureModeFromString(m_config.outputCaptureMode());
+        m_wallpaperManager->renderers()->setCaptureMode(captureMode);
+        m_wallpaperManager->renderers()->setOutputLimits(m_config.outputCollapseRepeats(), m_config.outputLineBudget());
+        if (m_wnelAddon) {
+            m_wnelAddon->renderers()->setCaptureMode(captureMode);
+            m_wnelAddon->renderers()->setOutputLimits(m_config.outputCollapseRepeats(), m_config.outputLineBudget());
+        }
+        m_outputLogView->logModel()->setCapacity(m_config.outputLogLines());
+        applyLogFileSettings();
+        
+        ThumbnailCache::instance().setEnabled(m_config.thumbnailCacheEnabled());
+        ThumbnailCache::instance().setMaxBytes(m_config.thumbnailCacheSizeMb() * 1024LL * 1024);
+        PreviewPixmapCache::instance().setMemoryBudget(m_config.previewMemoryBudgetMb() * 1024LL * 1024);
+        PreviewAnimator::instance().setFrameBudget(m_config.previewAnimationFrameBudget());
+        PreviewAnimator::instance().setMaxConcurrent(m_config.previewAnimationLimit());
+        PreviewAnimator::instance().setPolicy(PreviewAnimator::policyFromString(m_config.previewAnimationPolicy()));
         
         bool isConfigValid = m_config.isConfigurationValid();
         
@@ -1211,7 +1273,7 @@ void MainWindow::onRefreshFinished()
                 // Launch the wallpaper automatically (this will mark it as startup restoration)
                 launchWallpaperWithSource(wallpaperToRestore, LaunchSource::StartupRestore);
                 
-                // Update the UI to show the selected wallpaper (with pagination navigation and scrolling)
+                // Update the UI to show the selected wallpaper (scrolls it into view)
                 // This needs to happen after launch because the grid gets refreshed after wallpaper manager signals
                 QTimer::singleShot(200, this, [this, wallpaperToRestore]() {
                     if (m_wallpaperPreview) {
@@ -1350,8 +1412,12 @@ void MainWindow::onWallpaperLaunched(const WallpaperInfo& wallpaper)
         if (m_propertiesPanel) {
             ConfigManager& config = ConfigManager::instance();
             
-            // Add wallpaper-specific settings from ConfigManager
+            // Fields covered by the battery profile are lowered while on battery
             bool silent = config.getWallpaperSilent(wallpaper.id);
+            int fps = config.getWallpaperValue(wallpaper.id, "fps", 30).toInt();
+            m_powerProfile->applyBatteryProfile(fps, silent);
+            
+            // Add wallpaper-specific settings from ConfigManager
             if (silent) additionalArgs << "--silent";
             
             int volume = config.getWallpaperMasterVolume(wallpaper.id);
@@ -1383,6 +1449,11 @@ void MainWindow::onWallpaperLaunched(const WallpaperInfo& wallpaper)
             QString customScreenRoot = config.getWallpaperValue(wallpaper.id, "custom_screen_root").toString();
             QString effectiveScreen = customScreenRoot.isEmpty() ? screenRoot : customScreenRoot;
             
+            // A relaunch stays on the output the wallpaper is running on
+            if (!m_launchScreenRoot.isEmpty()) {
+                effectiveScreen = m_launchScreenRoot;
+            }
+            
             if (!effectiveScreen.isEmpty()) {
                 if (wallpaper.type == "External") {
                     additionalArgs << "--output" << effectiveScreen;
@@ -1395,7 +1466,6 @@ void MainWindow::onWallpaperLaunched(const WallpaperInfo& wallpaper)
             QString windowGeometry = config.getWallpaperValue(wallpaper.id, "window_geometry").toString();
             if (!windowGeometry.isEmpty()) additionalArgs << "--window" << windowGeometry;
             
-            int fps = config.getWallpaperValue(wallpaper.id, "fps", 30).toInt();
             if (fps != 30) additionalArgs << "--fps" << QString::number(fps);
             
             QString backgroundId = config.getWallpaperValue(wallpaper.id, "background_id").toString();
@@ -1426,17 +1496,22 @@ void MainWindow::onWallpaperLaunched(const WallpaperInfo& wallpaper)
         // Launch wallpaper with error handling and custom settings
         bool success = false;
         
+        // Renderers run per output; only the one on the target output is replaced
+        QString targetScreen = RendererProcessManager::screenFromArgs(additionalArgs);
+        
         // Check if this is an external wallpaper
         if (wallpaper.type == "External" && m_wnelAddon && m_wnelAddon->isEnabled()) {
-            qCDebug(mainWindow) << "Launching external wallpaper via WNEL addon";
-            // Ensure regular wallpaper engine is stopped before launching external wallpaper
-            m_wallpaperManager->stopWallpaper();
+            qCDebug(mainWindow) << "Launching external wallpaper via WNEL addon on" << targetScreen;
+            // Ensure regular wallpaper engine is stopped on this output before launching external wallpaper
+            m_wallpaperManager->stopWallpaperOnScreen(targetScreen);
+            m_wallpaperManager->renderers()->terminateOrphan(targetScreen);
             success = m_wnelAddon->launchExternalWallpaper(wallpaper.id, additionalArgs);
         } else {
-            qCDebug(mainWindow) << "Launching regular wallpaper via WallpaperManager";
-            // Ensure external wallpaper is stopped before launching regular wallpaper
+            qCDebug(mainWindow) << "Launching regular wallpaper via WallpaperManager on" << targetScreen;
+            // Ensure external wallpaper is stopped on this output before launching regular wallpaper
             if (m_wnelAddon) {
-                m_wnelAddon->stopWallpaper();
+                m_wnelAddon->stopWallpaperOnScreen(targetScreen);
+                m_wnelAddon->renderers()->terminateOrphan(targetScreen);
             }
             success = m_wallpaperManager->launchWallpaper(wallpaper.id, additionalArgs);
         }
@@ -1480,8 +1555,9 @@ void MainWindow::onWallpaperLaunched(const WallpaperInfo& wallpaper)
                 qCDebug(mainWindow) << "Playlist launch - clearing last wallpaper and marking as playlist session";
                 m_config.setLastSelectedWallpaper("");
                 m_config.setLastSessionUsedPlaylist(true);
-            } else if (m_lastLaunchSource == LaunchSource::StartupRestore) {
-                // Startup restoration: preserve the existing configuration (don't change it)
+            } else if (m_lastLaunchSource == LaunchSource::StartupRestore ||
+                       m_lastLaunchSource == LaunchSource::PowerProfile) {
+                // Startup restoration / power profile switch: preserve the existing configuration (don't change it)
                 qCDebug(mainWindow) << "Startup restoration - preserving existing configuration";
                 // Don't change the config during startup restoration
             } else {
@@ -1508,7 +1584,7 @@ void MainWindow::onWallpaperLaunched(const WallpaperInfo& wallpaper)
         QString errorMsg = QString("Exception occurred while launching wallpaper: %1").arg(e.what());
         qCCritical(mainWindow) << errorMsg;
         if (m_wallpaperManager) {
-            emit m_wallpaperManager->outputReceived("ERROR: " + errorMsg);
+            emit m_wallpaperManager->outputReceived("ERROR: " + errorMsg, RendererLogClassifier::Severity::Error);
         }
         QMessageBox::critical(this, "Launch Error", errorMsg);
         m_statusLabel->setText("Launch error");
@@ -1516,7 +1592,7 @@ void MainWindow::onWallpaperLaunched(const WallpaperInfo& wallpaper)
         QString errorMsg = "Unknown error occurred while launching wallpaper";
         qCCritical(mainWindow) << errorMsg;
         if (m_wallpaperManager) {
-            emit m_wallpaperManager->outputReceived("ERROR: " + errorMsg);
+            emit m_wallpaperManager->outputReceived("ERROR: " + errorMsg, RendererLogClassifier::Severity::Error);
         }
         QMessageBox::critical(this, "Launch Error", errorMsg);
         m_statusLabel->setText("Launch error");
@@ -1525,11 +1601,64 @@ void MainWindow::onWallpaperLaunched(const WallpaperInfo& wallpaper)
     qCDebug(mainWindow) << "onWallpaperLaunched - END:" << wallpaper.name;
 }
 
-void MainWindow::launchWallpaperWithSource(const WallpaperInfo& wallpaper, LaunchSource source)
+void MainWindow::launchWallpaperWithSource(const WallpaperInfo& wallpaper, LaunchSource source,
+                                           const QString& screenRoot)
 {
     qCDebug(mainWindow) << "launchWallpaperWithSource called with source:" << static_cast<int>(source) << "wallpaper:" << wallpaper.name;
     m_lastLaunchSource = source;
+    m_launchScreenRoot = screenRoot;
     onWallpaperLaunched(wallpaper);
+    m_launchScreenRoot.clear();
+}
+
+void MainWindow::onPowerSourceChanged(bool onBattery)
+{
+    m_statusLabel->setText(onBattery ? "Running on battery power" : "Running on AC power");
+    
+    // Renderers paused by the battery profile always continue on AC
+    if (!onBattery) {
+        m_wallpaperManager->renderers()->resumeAll();
+        m_wnelAddon->renderers()->resumeAll();
+    }
+    
+    if (!m_config.batteryProfileEnabled()) {
+        return;
+    }
+    
+    if (onBattery && m_powerProfile->batteryAction() == PowerProfileService::BatteryAction::Pause) {
+        m_wallpaperManager->renderers()->pauseAll();
+        m_wnelAddon->renderers()->pauseAll();
+        onOutputReceived("Battery profile: wallpapers paused until AC power returns");
+        return;
+    }
+    
+    if (m_powerProfile->batteryAction() != PowerProfileService::BatteryAction::Reduce) {
+        return;
+    }
+    
+    // Relaunch running wallpapers so their launch arguments pick up the
+    // current profile, each on the output it is running on
+    QList<QPair<QString, QString>> running;     // screen root, wallpaper id
+    for (const QString& screenRoot : m_wallpaperManager->activeScreens()) {
+        running.append({ screenRoot, m_wallpaperManager->getWallpaperOnScreen(screenRoot) });
+    }
+    for (const QString& screenRoot : m_wnelAddon->activeScreens()) {
+        running.append({ screenRoot, m_wnelAddon->renderers()->wallpaperOn(screenRoot) });
+    }
+    
+    onOutputReceived(QString("%1 profile: relaunching %2 wallpaper(s)")
+                     .arg(onBattery ? "Battery" : "Normal")
+                     .arg(running.size()));
+    
+    for (const auto& [screenRoot, wallpaperId] : running) {
+        auto wallpaperInfo = m_wallpaperManager->getWallpaperInfo(wallpaperId);
+        if (wallpaperInfo.has_value()) {
+            launchWallpaperWithSource(wallpaperInfo.value(), LaunchSource::PowerProfile, screenRoot);
+        } else if (m_wnelAddon->hasExternalWallpaper(wallpaperId)) {
+            launchWallpaperWithSource(m_wnelAddon->getExternalWallpaperById(wallpaperId).toWallpaperInfo(),
+                                      LaunchSource::PowerProfile, screenRoot);
+        }
+    }
 }
 
 void MainWindow::onWallpaperStopped()
@@ -1591,21 +1720,78 @@ void MainWindow::showAbout()
         "<p><a href=\"https://github.com/Almamu/linux-wallpaperengine\">linux-wallpaperengine project</a></p>");
 }
 
-void MainWindow::onOutputReceived(const QString& output)
+void MainWindow::showLaunchTimings()
 {
-    QString timestamp = QDateTime::currentDateTime().toString("hh:mm:ss");
-    QString formattedOutput = QString("[%1] %2").arg(timestamp, output.trimmed());
+    LaunchTimings& timings = LaunchTimings::instance();
+    
+    QDialog dialog(this);
+    dialog.setWindowTitle("Launch Timings");
+    dialog.resize(640, 420);
+    
+    auto *layout = new QVBoxLayout(&dialog);
+    auto *infoLabel = new QLabel("Milliseconds from the stop request of the previous wallpaper "
+                                 "until each launch phase was reached.", &dialog);
+    infoLabel->setWordWrap(true);
+    layout->addWidget(infoLabel);
+    
+    auto *textView = new QPlainTextEdit(&dialog);
+    textView->setReadOnly(true);
+    textView->setFont(QFont("monospace"));
+    textView->setPlainText(timings.toText());
+    layout->addWidget(textView);
+    
+    // Keep the view live while launches are in flight
+    connect(&timings, &LaunchTimings::timingsChanged, textView, [textView, &timings]() {
+        textView->setPlainText(timings.toText());
+    });
     
-    m_outputTextEdit->append(formattedOutput);
+    auto *buttonBox = new QDialogButtonBox(QDialogButtonBox::Close, &dialog);
+    auto *exportButton = buttonBox->addButton("Export JSON...", QDialogButtonBox::ActionRole);
+    auto *resetButton = buttonBox->addButton("Reset", QDialogButtonBox::ResetRole);
+    layout->addWidget(buttonBox);
+    
+    connect(buttonBox, &QDialogButtonBox::rejected, &dialog, &QDialog::reject);
+    connect(resetButton, &QPushButton::clicked, &timings, &LaunchTimings::clear);
+    connect(exportButton, &QPushButton::clicked, &dialog, [this, &dialog, &timings]() {
+        QString fileName = QFileDialog::getSaveFileName(&dialog,
+            "Export Launch Timings",
+            QString("wallpaperengine-launch-timings-%1.json").arg(QDateTime::currentDateTime().toString("yyyy-MM-dd-hhmmss")),
+            "JSON Files (*.json);;All Files (*)");
+        
+        if (fileName.isEmpty()) {
+            return;
+        }
+        
+        if (timings.dumpToFile(fileName)) {
+            m_statusLabel->setText("Launch timings saved to: " + fileName);
+        } else {
+            QMessageBox::warning(&dialog, "Export Failed", "Could not write launch timings to: " + fileName);
+        }
+    });
+    
+    dialog.exec();
+}
+
+void MainWindow::onOutputReceived(const QString& output, RendererLogClassifier::Severity severity)
+{
+    QString timestamp = QDateTime::currentDateTime().toString("hh:mm:ss");
     
-    // Auto-scroll to bottom
-    QTextCursor cursor = m_outputTextEdit->textCursor();
-    cursor.movePosition(QTextCursor::End);
-    m_outputTextEdit->setTextCursor(cursor);
+    // One row per line; the log view batches them and repaints at most once per frame
+    const QStringList lines = output.trimmed().split('\n');
+    for (const QString& line : lines) {
+        m_outputLogView->appendLine(QString("[%1] %2").arg(timestamp, line));
+    }
     
-    // Force immediate update
-    m_outputTextEdit->update();
-    QApplication::processEvents();
+    // The on-disk log gets full dates and is written on its own thread
+    if (m_logFile->isEnabled()) {
+        QString fileTimestamp = QDateTime::currentDateTime().toString("yyyy-MM-dd hh:mm:ss.zzz");
+        QStringList fileLines;
+        fileLines.reserve(lines.size());
+        for (const QString& line : lines) {
+            fileLines << QString("[%1] %2").arg(fileTimestamp, line);
+        }
+        m_logFile->append(fileLines);
+    }
     
     // Only switch to output tab for critical errors or initial launch messages
     // Avoid switching for repetitive/cyclic error messages that would interfere with user interaction
@@ -1619,8 +1805,9 @@ void MainWindow::onOutputReceived(const QString& output)
     if (output.contains("Launching") || output.contains("Command:") || 
         output.contains("process finished") || output.contains("Stopping")) {
         shouldSwitch = true;
-    } else if (output.contains("ERROR") || output.contains("FAILED") || output.contains("WARNING")) {
-        // For errors, only switch if it's a new error or sufficient time has passed
+    } else if (severity >= RendererLogClassifier::Severity::Error) {
+        // The output workers already classified every line; for errors, only
+        // switch if it's a new error or sufficient time has passed
         // This prevents cyclic errors from interfering with tab switching
         if (output != lastError || lastTabSwitch.secsTo(now) > 10) {
             shouldSwitch = true;
@@ -1640,11 +1827,56 @@ void MainWindow::onOutputReceived(const QString& output)
 
 void MainWindow::clearOutput()
 {
-    m_outputTextEdit->clear();
-    m_outputTextEdit->append(QString("[%1] Output cleared").arg(
+    m_outputLogView->clear();
+    RendererLogClassifier::instance().resetCounters();
+    updateLogCounters();
+    m_outputLogView->appendLine(QString("[%1] Output cleared").arg(
         QDateTime::currentDateTime().toString("hh:mm:ss")));
 }
 
+void MainWindow::applyLogFileSettings()
+{
+    m_logFile->configure(m_config.outputFileLogging(),
+                         m_config.outputLogDirectory(),
+                         static_cast<qint64>(m_config.outputLogFileSizeKb()) * 1024,
+                         m_config.outputLogFileCount(),
+                         m_config.outputCompressRotatedLogs());
+}
+
+void MainWindow::updateLogCounters()
+{
+    RendererLogClassifier::Counters counters = RendererLogClassifier::instance().counters();
+    using Severity = RendererLogClassifier::Severity;
+    using Source = RendererLogClassifier::Source;
+    
+    quint64 errors = counters.count(Severity::Error) + counters.count(Severity::Fatal);
+    
+    // Lines the output workers collapsed into repeat summaries or dropped over budget
+    quint64 collapsed = m_wallpaperManager->renderers()->collapsedOutputLines();
+    quint64 dropped = m_wallpaperManager->renderers()->droppedOutputLines();
+    if (m_wnelAddon) {
+        collapsed += m_wnelAddon->renderers()->collapsedOutputLines();
+        dropped += m_wnelAddon->renderers()->droppedOutputLines();
+    }
+    
+    m_logCountersLabel->setText(QString("Renderer lines: %1  |  Errors: %2  |  Warnings: %3  |  Collapsed: %4  |  Dropped: %5")
+                                    .arg(counters.total())
+                                    .arg(errors)
+                                    .arg(counters.count(Severity::Warning))
+                                    .arg(collapsed)
+                                    .arg(dropped));
+    
+    QStringList details;
+    for (Source source : { Source::Engine, Source::Mpv, Source::GL, Source::Audio }) {
+        quint64 sourceErrors = counters.count(source, Severity::Error) + counters.count(source, Severity::Fatal);
+        details << QString("%1: %2 errors, %3 warnings")
+                       .arg(RendererLogClassifier::sourceName(source))
+                       .arg(sourceErrors)
+                       .arg(counters.count(source, Severity::Warning));
+    }
+    m_logCountersLabel->setToolTip(details.join("\n"));
+}
+
 void MainWindow::saveOutput()
 {
     QString fileName = QFileDialog::getSaveFileName(this,
@@ -1656,7 +1888,7 @@ void MainWindow::saveOutput()
         QFile file(fileName);
         if (file.open(QIODevice::WriteOnly | QIODevice::Text)) {
             QTextStream out(&file);
-            out << m_outputTextEdit->toPlainText();
+            out << m_outputLogView->toPlainText();
             m_statusLabel->setText("Log saved to: " + fileName);
         } else {
             QMessageBox::warning(this, "Save Failed", "Could not save log file: " + file.errorString());
@@ -2016,6 +2248,45 @@ void MainWindow::onStopWallpaperClicked()
     bool stoppedSomething = false;
     QStringList stoppedItems;
     
+    // With renderers on several outputs, let the user stop a single output
+    QStringList activeScreens;
+    if (m_wallpaperManager) {
+        activeScreens << m_wallpaperManager->activeScreens();
+    }
+    if (m_wnelAddon) {
+        activeScreens << m_wnelAddon->activeScreens();
+    }
+    activeScreens.removeDuplicates();
+    
+    if (activeScreens.size() > 1) {
+        const QString allOutputs = "All outputs";
+        QStringList choices;
+        choices << allOutputs;
+        for (const QString& screenRoot : activeScreens) {
+            choices << RendererProcessManager::displayName(screenRoot);
+        }
+        
+        bool ok = false;
+        QString choice = QInputDialog::getItem(this, "Stop Wallpaper",
+            "Wallpapers are running on several outputs. Stop which one?", choices, 0, false, &ok);
+        if (!ok) {
+            return;
+        }
+        
+        if (choice != allOutputs) {
+            QString screenRoot = activeScreens.value(choices.indexOf(choice) - 1);
+            if (m_wallpaperManager) {
+                m_wallpaperManager->stopWallpaperOnScreen(screenRoot);
+            }
+            if (m_wnelAddon) {
+                m_wnelAddon->stopWallpaperOnScreen(screenRoot);
+            }
+            m_statusLabel->setText(QString("Stopped wallpaper on %1").arg(choice));
+            updatePlaylistButtonStates();
+            return;
+        }
+    }
+    
     // Stop both regular and external wallpapers
     if (m_wallpaperManager && m_wallpaperManager->isWallpaperRunning()) {
         m_wallpaperManager->stopWallpaper();
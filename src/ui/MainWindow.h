@@ -20,6 +20,7 @@
 #include <QDropEvent>
 #include <QMimeData>
 #include <QEvent>
+#include "../core/RendererLogClassifier.h"
 
 class WallpaperPreview;
 class PropertiesPanel;
@@ -28,6 +29,9 @@ class WallpaperManager;
 class WallpaperPlaylist;
 class PlaylistPreview;
 class WNELAddon;
+class PowerProfileService;
+class OutputLogView;
+class RotatingLogFile;
 struct WallpaperInfo;
 
 // Custom QTabWidget that accepts drops on tab buttons
@@ -59,7 +63,8 @@ public:
     enum class LaunchSource {
         Manual,           // User double-click, launch button, etc.
         Playlist,         // Playlist timer, next/previous buttons
-        StartupRestore    // Application startup restoration
+        StartupRestore,   // Application startup restoration
+        PowerProfile      // Relaunch after switching between AC and battery
     };
     
     // Methods for system tray
@@ -75,18 +80,22 @@ private slots:
     void openSettings();
     void refreshWallpapers();
     void showAbout();
+    void showLaunchTimings();
     void onWallpaperSelected(const WallpaperInfo& wallpaper);
     void onWallpaperLaunched(const WallpaperInfo& wallpaper);
     void onWallpaperStopped();
+    void onPowerSourceChanged(bool onBattery);
     void onWallpaperSelectionRejected(const QString& wallpaperId);
     void onRefreshProgress(int current, int total);
     void onRefreshFinished();
     void checkFirstRun();
     void initializeWithValidConfig();
     void showConfigurationIssuesDialog(const QString& issues);
-    void onOutputReceived(const QString& output);
+    void onOutputReceived(const QString& output,
+                          RendererLogClassifier::Severity severity = RendererLogClassifier::Severity::Info);
     void clearOutput();
     void saveOutput();
+    void updateLogCounters();
     
     // Playlist slots
     void onAddToPlaylistClicked();
@@ -125,6 +134,7 @@ private:
     void saveSettings();
     void updateStatusBar();
     void showFirstRunDialog();
+    void applyLogFileSettings();
     
     // System tray methods
     void setupSystemTray();
@@ -134,8 +144,10 @@ private:
     // Main tab unsaved changes handling
     bool handleMainTabClickWithUnsavedCheck(int index);
     
-    // Launch helper method
-    void launchWallpaperWithSource(const WallpaperInfo& wallpaper, LaunchSource source);
+    // Launch helper method; a screen root keeps the wallpaper on that output
+    // instead of the configured one
+    void launchWallpaperWithSource(const WallpaperInfo& wallpaper, LaunchSource source,
+                                   const QString& screenRoot = QString());
 
     // UI Components
     DropTabWidget* m_mainTabWidget;
@@ -144,7 +156,8 @@ private:
     WallpaperPreview *m_wallpaperPreview;
     PropertiesPanel *m_propertiesPanel;
     PlaylistPreview *m_playlistPreview;
-    QTextEdit *m_outputTextEdit;
+    OutputLogView *m_outputLogView;
+    QLabel *m_logCountersLabel;
     
     // Playlist UI components
     QPushButton *m_addToPlaylistButton;
@@ -176,6 +189,8 @@ private:
     WallpaperManager *m_wallpaperManager;
     WallpaperPlaylist *m_wallpaperPlaylist;
     WNELAddon *m_wnelAddon;  // WNEL addon manager
+    PowerProfileService *m_powerProfile;  // AC/battery profile switching
+    RotatingLogFile *m_logFile;           // on-disk copy of the Engine Log
     
     // State
     QString m_currentWallpaperId;
@@ -184,6 +199,7 @@ private:
     bool m_startMinimized;
     bool m_isLaunchingWallpaper; // Track when we're launching a new wallpaper
     LaunchSource m_lastLaunchSource; // Track the source of the last wallpaper launch
+    QString m_launchScreenRoot;      // Output of a relaunch, empty for the configured one
     bool m_showHiddenWallpapers; // Track whether hidden wallpapers are shown
     
     // Main tab unsaved changes handling
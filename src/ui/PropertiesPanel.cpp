@@ -1,6 +1,8 @@
 #include "PropertiesPanel.h"
 #include "../core/ConfigManager.h"
 #include "../steam/SteamApiManager.h"
+#include "../core/PreviewPixmapCache.h"
+#include "../core/PreviewPlaceholder.h"
 #include <QVBoxLayout>
 #include <QHBoxLayout>
 #include <QFormLayout>
@@ -162,6 +164,7 @@ PropertiesPanel::PropertiesPanel(QWidget* parent)
     , m_currentSettings()
     , m_wallpaperManager(nullptr)
     , m_previewMovie(nullptr)
+    , m_previewRequest(0)
     , m_propertyWidgets()
     , m_originalValues()
     , m_originalPropertyObjects()
@@ -882,6 +885,16 @@ void PropertiesPanel::updatePreview(const WallpaperInfo& wallpaper)
     // Stop any existing animation first
     stopPreviewAnimation();
     
+    // A decode still queued for the previous wallpaper is no longer wanted
+    if (m_previewRequest != 0) {
+        PreviewPixmapCache::instance().cancel(m_previewRequest);
+        m_previewRequest = 0;
+    }
+    if (!m_previewKey.isEmpty()) {
+        PreviewPixmapCache::instance().release(m_previewKey);
+        m_previewKey.clear();
+    }
+    
     if (!wallpaper.previewPath.isEmpty() && QFileInfo::exists(wallpaper.previewPath)) {
         // Check if it's an animated preview first
         if (hasAnimatedPreview(wallpaper.previewPath)) {
@@ -889,28 +902,44 @@ void PropertiesPanel::updatePreview(const WallpaperInfo& wallpaper)
             return;
         }
         
-        // Load static image
-        QPixmap originalPixmap(wallpaper.previewPath);
+        // Decode the static image off the GUI thread, straight at label size
+        QSize labelSize = m_previewLabel->size();
+        if (labelSize.width() < 50 || labelSize.height() < 50) {
+            labelSize = QSize(256, 144); // Use default size if label isn't sized yet
+        }
         
-        if (!originalPixmap.isNull()) {
-            qCDebug(propertiesPanel) << "Loaded preview image, original size:" 
-                                    << originalPixmap.width() << "x" << originalPixmap.height();
-            
-            // Scale the image properly while maintaining aspect ratio
-            QSize labelSize = m_previewLabel->size();
-            if (labelSize.width() < 50 || labelSize.height() < 50) {
-                labelSize = QSize(256, 144); // Use default size if label isn't sized yet
-            }
-            
-            QPixmap scaledPixmap = scalePixmapKeepAspectRatio(originalPixmap, labelSize);
-            m_previewLabel->setPixmap(scaledPixmap);
-            
-            qCDebug(propertiesPanel) << "Preview image set successfully, scaled to:" 
-                                    << scaledPixmap.width() << "x" << scaledPixmap.height();
+        QString previewPath = wallpaper.previewPath;
+        qreal dpr = m_previewLabel->devicePixelRatioF();
+        
+        // Show the blurred placeholder while decoding, if one was made already
+        QByteArray placeholder = wallpaper.previewPlaceholder.isEmpty()
+            ? PreviewPlaceholder::instance().cached(previewPath)
+            : wallpaper.previewPlaceholder;
+        qreal aspect = PreviewPlaceholder::aspectRatio(placeholder);
+        if (aspect > 0.0) {
+            QSize blurSize = QSizeF(aspect, 1.0).scaled(QSizeF(labelSize), Qt::KeepAspectRatio).toSize();
+            QImage blur = PreviewPlaceholder::render(placeholder, blurSize * dpr);
+            m_previewLabel->setPixmap(scalePixmapKeepAspectRatio(QPixmap::fromImage(blur), labelSize));
         } else {
-            qCWarning(propertiesPanel) << "Failed to load preview image:" << wallpaper.previewPath;
-            setPlaceholderPreview("Failed to load preview");
+            setPlaceholderPreview("Loading preview...");
         }
+        
+        m_previewRequest = PreviewPixmapCache::instance().load(previewPath, labelSize, this,
+            [this, previewPath, labelSize, dpr](const QPixmap& pixmap) {
+                m_previewRequest = 0;
+                if (pixmap.isNull()) {
+                    qCWarning(propertiesPanel) << "Failed to load preview image:" << previewPath;
+                    setPlaceholderPreview("Failed to load preview");
+                    return;
+                }
+                m_previewKey = PreviewPixmapCache::key(previewPath, labelSize, dpr);
+                
+                QPixmap scaledPixmap = scalePixmapKeepAspectRatio(pixmap, labelSize);
+                m_previewLabel->setPixmap(scaledPixmap);
+                
+                qCDebug(propertiesPanel) << "Preview image set successfully, scaled to:" 
+                                        << scaledPixmap.width() << "x" << scaledPixmap.height();
+            }, false, dpr);
     } else {
         qCDebug(propertiesPanel) << "No valid preview path, setting placeholder";
         setPlaceholderPreview("No preview available");
@@ -923,21 +952,27 @@ QPixmap PropertiesPanel::scalePixmapKeepAspectRatio(const QPixmap& original, con
         return original;
     }
     
-    // Calculate the best fit size while maintaining aspect ratio
-    QSize originalSize = original.size();
-    QSize scaledSize = originalSize.scaled(targetSize, Qt::KeepAspectRatio);
+    // Work in device pixels so the label shows the result without scaling it
+    // again; previews decoded for this screen are not resampled at all
+    qreal dpr = m_previewLabel->devicePixelRatioF();
+    QSize targetPixels = targetSize * dpr;
+    QSize scaledSize = original.size().scaled(targetPixels, Qt::KeepAspectRatio);
     
     // Scale the pixmap
-    QPixmap scaled = original.scaled(scaledSize, Qt::KeepAspectRatio, Qt::SmoothTransformation);
+    QPixmap scaled = scaledSize == original.size()
+        ? original
+        : original.scaled(scaledSize, Qt::KeepAspectRatio, Qt::SmoothTransformation);
+    scaled.setDevicePixelRatio(dpr);
     
     // Create a pixmap with the target size and center the scaled image
-    QPixmap result(targetSize);
+    QPixmap result(targetPixels);
+    result.setDevicePixelRatio(dpr);
     result.fill(Qt::transparent);
     
     QPainter painter(&result);
-    int x = (targetSize.width() - scaled.width()) / 2;
-    int y = (targetSize.height() - scaled.height()) / 2;
-    painter.drawPixmap(x, y, scaled);
+    qreal x = (targetPixels.width() - scaled.width()) / (2 * dpr);
+    qreal y = (targetPixels.height() - scaled.height()) / (2 * dpr);
+    painter.drawPixmap(QPointF(x, y), scaled);
     
     return result;
 }
@@ -1361,8 +1396,7 @@ void PropertiesPanel::restartWallpaperWithChanges()
     }
     
     // Only restart if the wallpaper is currently running and it's the same wallpaper being modified
-    if (m_wallpaperManager->isWallpaperRunning() && 
-        m_wallpaperManager->getCurrentWallpaper() == m_currentWallpaper.id) {
+    if (m_wallpaperManager->isWallpaperActive(m_currentWallpaper.id)) {
         
         qCDebug(propertiesPanel) << "Automatically restarting wallpaper with new changes:" << m_currentWallpaper.name;
         
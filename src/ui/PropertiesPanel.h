@@ -224,6 +224,8 @@ private:
     
     // Animation support for preview
     QMovie* m_previewMovie;
+    quint64 m_previewRequest;
+    QString m_previewKey;   // reference held in PreviewPixmapCache
     
     // Track modified properties
     QMap<QString, QWidget*> m_propertyWidgets;
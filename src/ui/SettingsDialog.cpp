@@ -2,6 +2,10 @@
 #include "../core/ConfigManager.h"
 #include "../steam/SteamDetector.h"
 #include "../steam/SteamApiManager.h"
+#include "../core/RotatingLogFile.h"
+#include "../core/ThumbnailCache.h"
+#include "../core/PreviewPixmapCache.h"
+#include "../core/PreviewAnimator.h"
 #include <QApplication>
 #include <QVBoxLayout>
 #include <QHBoxLayout>
@@ -20,6 +24,7 @@
 #include <QProcess>
 #include <QStyleFactory>
 #include <QClipboard>
+#include <QSpinBox>
 
 SettingsDialog::SettingsDialog(QWidget *parent)
     : QDialog(parent)
@@ -53,6 +58,15 @@ void SettingsDialog::setupUI()
     // Create Extra tab
     tabWidget->addTab(createExtraTab(), "Extra");
     
+    // Create Power tab
+    tabWidget->addTab(createPowerTab(), "Power");
+    
+    // Create Output tab
+    tabWidget->addTab(createOutputTab(), "Output");
+    
+    // Create Previews tab
+    tabWidget->addTab(createPreviewsTab(), "Previews");
+    
     // Create button box
     auto *buttonLayout = new QHBoxLayout;
     
@@ -488,6 +502,327 @@ QWidget* SettingsDialog::createExtraTab()
     return widget;
 }
 
+QWidget* SettingsDialog::createPowerTab()
+{
+    auto* widget = new QWidget;
+    auto* mainLayout = new QVBoxLayout(widget);
+    mainLayout->setContentsMargins(0, 0, 0, 0);
+    
+    // Create scroll area for power tab
+    auto* scrollArea = new QScrollArea;
+    scrollArea->setWidgetResizable(true);
+    scrollArea->setHorizontalScrollBarPolicy(Qt::ScrollBarAsNeeded);
+    scrollArea->setVerticalScrollBarPolicy(Qt::ScrollBarAsNeeded);
+    scrollArea->setFrameShape(QFrame::NoFrame);
+    
+    auto* scrollWidget = new QWidget;
+    auto* layout = new QVBoxLayout(scrollWidget);
+    layout->setContentsMargins(12, 12, 12, 12);
+    
+    // Battery profile section
+    auto* batteryGroup = new QGroupBox("Battery Profile");
+    auto* batteryLayout = new QVBoxLayout(batteryGroup);
+    
+    m_batteryProfileCheckbox = new QCheckBox("Use a lighter profile while running on battery");
+    batteryLayout->addWidget(m_batteryProfileCheckbox);
+    
+    auto* batteryDescription = new QLabel(
+        "When the machine switches to battery, running wallpapers are relaunched with a lower "
+        "frame rate and muted audio, or paused entirely. Restoring AC power restores the normal "
+        "wallpaper settings."
+    );
+    batteryDescription->setWordWrap(true);
+    batteryDescription->setStyleSheet("QLabel { color: #666; margin: 8px 0px; }");
+    batteryLayout->addWidget(batteryDescription);
+    
+    auto* batteryForm = new QFormLayout;
+    m_batteryActionCombo = new QComboBox;
+    m_batteryActionCombo->addItem("Reduce frame rate", "reduce");
+    m_batteryActionCombo->addItem("Pause wallpapers", "pause");
+    batteryForm->addRow("On battery:", m_batteryActionCombo);
+    
+    m_batteryFpsSpinBox = new QSpinBox;
+    m_batteryFpsSpinBox->setRange(1, 144);
+    m_batteryFpsSpinBox->setSuffix(" fps");
+    batteryForm->addRow("Frame rate limit:", m_batteryFpsSpinBox);
+    
+    m_batterySilentCheckbox = new QCheckBox("Mute wallpaper audio");
+    batteryForm->addRow("", m_batterySilentCheckbox);
+    
+    m_powerSysfsRootEdit = new QLineEdit;
+    m_powerSysfsRootEdit->setPlaceholderText("/sys/class/power_supply");
+    batteryForm->addRow("Power supply path:", m_powerSysfsRootEdit);
+    batteryLayout->addLayout(batteryForm);
+    
+    // Only the reduce action uses the fps/silent fields
+    auto updatePowerControls = [this]() {
+        bool enabled = m_batteryProfileCheckbox->isChecked();
+        bool reduce = m_batteryActionCombo->currentData().toString() == "reduce";
+        m_batteryActionCombo->setEnabled(enabled);
+        m_batteryFpsSpinBox->setEnabled(enabled && reduce);
+        m_batterySilentCheckbox->setEnabled(enabled && reduce);
+    };
+    connect(m_batteryProfileCheckbox, &QCheckBox::toggled, this, updatePowerControls);
+    connect(m_batteryActionCombo, QOverload<int>::of(&QComboBox::currentIndexChanged), this, updatePowerControls);
+    
+    layout->addWidget(batteryGroup);
+    layout->addStretch();
+    
+    // Set the scroll widget
+    scrollArea->setWidget(scrollWidget);
+    mainLayout->addWidget(scrollArea);
+    
+    return widget;
+}
+
+QWidget* SettingsDialog::createOutputTab()
+{
+    auto* widget = new QWidget;
+    auto* mainLayout = new QVBoxLayout(widget);
+    mainLayout->setContentsMargins(0, 0, 0, 0);
+    
+    // Create scroll area for output tab
+    auto* scrollArea = new QScrollArea;
+    scrollArea->setWidgetResizable(true);
+    scrollArea->setHorizontalScrollBarPolicy(Qt::ScrollBarAsNeeded);
+    scrollArea->setVerticalScrollBarPolicy(Qt::ScrollBarAsNeeded);
+    scrollArea->setFrameShape(QFrame::NoFrame);
+    
+    auto* scrollWidget = new QWidget;
+    auto* layout = new QVBoxLayout(scrollWidget);
+    layout->setContentsMargins(12, 12, 12, 12);
+    
+    // Renderer output capture section
+    auto* captureGroup = new QGroupBox("Renderer Output");
+    auto* captureLayout = new QVBoxLayout(captureGroup);
+    
+    auto* captureDescription = new QLabel(
+        "Chatty renderers can print many lines per second. Capturing only errors, or nothing at all, "
+        "sends their regular output straight to /dev/null and skips decoding the rest. Changes to what is discarded take "
+        "effect the next time a wallpaper is launched."
+    );
+    captureDescription->setWordWrap(true);
+    captureDescription->setStyleSheet("QLabel { color: #666; margin: 8px 0px; }");
+    captureLayout->addWidget(captureDescription);
+    
+    auto* captureForm = new QFormLayout;
+    m_outputCaptureCombo = new QComboBox;
+    m_outputCaptureCombo->addItem("Full output", "full");
+    m_outputCaptureCombo->addItem("Errors only", "errors");
+    m_outputCaptureCombo->addItem("Off", "off");
+    captureForm->addRow("Capture:", m_outputCaptureCombo);
+    
+    m_outputLogLinesSpinBox = new QSpinBox;
+    m_outputLogLinesSpinBox->setRange(500, 1000000);
+    m_outputLogLinesSpinBox->setSingleStep(1000);
+    m_outputLogLinesSpinBox->setSuffix(" lines");
+    m_outputLogLinesSpinBox->setToolTip("Older lines are dropped from the Engine Log once this many are kept");
+    captureForm->addRow("Log history:", m_outputLogLinesSpinBox);
+    
+    m_outputCollapseCheckbox = new QCheckBox("Collapse repeated lines into one line with a \"… ×N\" count");
+    captureForm->addRow("", m_outputCollapseCheckbox);
+    
+    m_outputLineBudgetSpinBox = new QSpinBox;
+    m_outputLineBudgetSpinBox->setRange(0, 100000);
+    m_outputLineBudgetSpinBox->setSingleStep(50);
+    m_outputLineBudgetSpinBox->setSuffix(" lines/s");
+    m_outputLineBudgetSpinBox->setSpecialValueText("Unlimited");
+    m_outputLineBudgetSpinBox->setToolTip("Lines beyond this rate are counted and dropped, per output");
+    captureForm->addRow("Rate limit:", m_outputLineBudgetSpinBox);
+    captureLayout->addLayout(captureForm);
+    
+    layout->addWidget(captureGroup);
+    
+    // On-disk log section
+    auto* fileGroup = new QGroupBox("Log File");
+    auto* fileLayout = new QVBoxLayout(fileGroup);
+    
+    m_outputFileLoggingCheckbox = new QCheckBox("Write renderer and application output to rotating log files");
+    fileLayout->addWidget(m_outputFileLoggingCheckbox);
+    
+    auto* fileForm = new QFormLayout;
+    auto* directoryLayout = new QHBoxLayout;
+    m_outputLogDirectoryEdit = new QLineEdit;
+    m_outputLogDirectoryEdit->setPlaceholderText(RotatingLogFile::defaultDirectory());
+    auto* browseLogDirectoryButton = new QPushButton("Browse...");
+    directoryLayout->addWidget(m_outputLogDirectoryEdit);
+    directoryLayout->addWidget(browseLogDirectoryButton);
+    fileForm->addRow("Folder:", directoryLayout);
+    
+    m_outputLogFileSizeSpinBox = new QSpinBox;
+    m_outputLogFileSizeSpinBox->setRange(1, 1024);
+    m_outputLogFileSizeSpinBox->setSuffix(" MB");
+    fileForm->addRow("Rotate at:", m_outputLogFileSizeSpinBox);
+    
+    m_outputLogFileCountSpinBox = new QSpinBox;
+    m_outputLogFileCountSpinBox->setRange(1, 100);
+    m_outputLogFileCountSpinBox->setToolTip("Number of rotated files kept besides the active one");
+    fileForm->addRow("Keep files:", m_outputLogFileCountSpinBox);
+    
+    m_outputCompressLogsCheckbox = new QCheckBox("Compress rotated files (.qz)");
+    fileForm->addRow("", m_outputCompressLogsCheckbox);
+    fileLayout->addLayout(fileForm);
+    
+    connect(browseLogDirectoryButton, &QPushButton::clicked, this, [this]() {
+        QString current = m_outputLogDirectoryEdit->text().isEmpty() ? RotatingLogFile::defaultDirectory()
+                                                                    : m_outputLogDirectoryEdit->text();
+        QString directory = QFileDialog::getExistingDirectory(this, "Select Log Folder", current);
+        if (!directory.isEmpty()) {
+            m_outputLogDirectoryEdit->setText(directory);
+        }
+    });
+    
+    auto updateLogFileControls = [this](bool enabled) {
+        m_outputLogDirectoryEdit->setEnabled(enabled);
+        m_outputLogFileSizeSpinBox->setEnabled(enabled);
+        m_outputLogFileCountSpinBox->setEnabled(enabled);
+        m_outputCompressLogsCheckbox->setEnabled(enabled);
+    };
+    connect(m_outputFileLoggingCheckbox, &QCheckBox::toggled, this, updateLogFileControls);
+    
+    layout->addWidget(fileGroup);
+    layout->addStretch();
+    
+    // Set the scroll widget
+    scrollArea->setWidget(scrollWidget);
+    mainLayout->addWidget(scrollArea);
+    
+    return widget;
+}
+
+QWidget* SettingsDialog::createPreviewsTab()
+{
+    auto* widget = new QWidget;
+    auto* mainLayout = new QVBoxLayout(widget);
+    mainLayout->setContentsMargins(0, 0, 0, 0);
+    
+    // Create scroll area for previews tab
+    auto* scrollArea = new QScrollArea;
+    scrollArea->setWidgetResizable(true);
+    scrollArea->setHorizontalScrollBarPolicy(Qt::ScrollBarAsNeeded);
+    scrollArea->setVerticalScrollBarPolicy(Qt::ScrollBarAsNeeded);
+    scrollArea->setFrameShape(QFrame::NoFrame);
+    
+    auto* scrollWidget = new QWidget;
+    auto* layout = new QVBoxLayout(scrollWidget);
+    layout->setContentsMargins(12, 12, 12, 12);
+    
+    // Thumbnail cache section
+    auto* cacheGroup = new QGroupBox("Thumbnail Cache");
+    auto* cacheLayout = new QVBoxLayout(cacheGroup);
+    
+    auto* cacheDescription = new QLabel(
+        "Preview images are scaled down once and kept on disk at grid size, so browsing the library "
+        "reads a few kilobytes per wallpaper instead of decoding the full preview every time. "
+        "Edited previews are picked up automatically."
+    );
+    cacheDescription->setWordWrap(true);
+    cacheDescription->setStyleSheet("QLabel { color: #666; margin: 8px 0px; }");
+    cacheLayout->addWidget(cacheDescription);
+    
+    m_thumbnailCacheCheckbox = new QCheckBox("Cache scaled preview thumbnails on disk");
+    cacheLayout->addWidget(m_thumbnailCacheCheckbox);
+    
+    auto* cacheForm = new QFormLayout;
+    m_thumbnailCacheSizeSpinBox = new QSpinBox;
+    m_thumbnailCacheSizeSpinBox->setRange(16, 8192);
+    m_thumbnailCacheSizeSpinBox->setSingleStep(64);
+    m_thumbnailCacheSizeSpinBox->setSuffix(" MB");
+    m_thumbnailCacheSizeSpinBox->setToolTip("The oldest thumbnails are deleted once the cache grows past this size");
+    cacheForm->addRow("Size limit:", m_thumbnailCacheSizeSpinBox);
+    
+    auto* usageLayout = new QHBoxLayout;
+    m_thumbnailCacheUsageLabel = new QLabel;
+    auto* clearCacheButton = new QPushButton("Clear Cache");
+    usageLayout->addWidget(m_thumbnailCacheUsageLabel);
+    usageLayout->addStretch();
+    usageLayout->addWidget(clearCacheButton);
+    cacheForm->addRow("In use:", usageLayout);
+    cacheLayout->addLayout(cacheForm);
+    
+    connect(clearCacheButton, &QPushButton::clicked, this, [this]() {
+        ThumbnailCache::instance().clear();
+        m_thumbnailCacheUsageLabel->setText("0.0 MB");
+    });
+    connect(m_thumbnailCacheCheckbox, &QCheckBox::toggled, m_thumbnailCacheSizeSpinBox, &QWidget::setEnabled);
+    
+    layout->addWidget(cacheGroup);
+    
+    // In-memory pixmap cache section
+    auto* memoryGroup = new QGroupBox("Memory Cache");
+    auto* memoryLayout = new QVBoxLayout(memoryGroup);
+    
+    auto* memoryDescription = new QLabel(
+        "Decoded previews are shared between the library grid, the playlist and the properties panel. "
+        "Previews that are no longer on screen are kept up to this budget and dropped least recently "
+        "used first. While the library is idle, the next screen of previews and workshop details can "
+        "be loaded ahead in the background; any input pauses it."
+    );
+    memoryDescription->setWordWrap(true);
+    memoryDescription->setStyleSheet("QLabel { color: #666; margin: 8px 0px; }");
+    memoryLayout->addWidget(memoryDescription);
+    
+    m_previewPrefetchCheckbox = new QCheckBox("Prefetch the next screen of previews while idle");
+    memoryLayout->addWidget(m_previewPrefetchCheckbox);
+    
+    auto* memoryForm = new QFormLayout;
+    m_previewMemoryBudgetSpinBox = new QSpinBox;
+    m_previewMemoryBudgetSpinBox->setRange(4, 4096);
+    m_previewMemoryBudgetSpinBox->setSingleStep(16);
+    m_previewMemoryBudgetSpinBox->setSuffix(" MB");
+    memoryForm->addRow("Budget:", m_previewMemoryBudgetSpinBox);
+    
+    m_previewMemoryStatsLabel = new QLabel;
+    memoryForm->addRow("In use:", m_previewMemoryStatsLabel);
+    memoryLayout->addLayout(memoryForm);
+    
+    layout->addWidget(memoryGroup);
+    
+    // Animated previews section
+    auto* animationGroup = new QGroupBox("Animated Previews");
+    auto* animationLayout = new QVBoxLayout(animationGroup);
+    
+    auto* animationDescription = new QLabel(
+        "Animated previews share one clock and only play while they are on screen. The frame budget "
+        "caps how many frames all of them together may decode per second; when it is used up the "
+        "animations slow down instead of taking more CPU. On slower machines, play only the preview "
+        "under the mouse or the selected one, and limit how many may play at once."
+    );
+    animationDescription->setWordWrap(true);
+    animationDescription->setStyleSheet("QLabel { color: #666; margin: 8px 0px; }");
+    animationLayout->addWidget(animationDescription);
+    
+    auto* animationForm = new QFormLayout;
+    m_animationFrameBudgetSpinBox = new QSpinBox;
+    m_animationFrameBudgetSpinBox->setRange(10, 600);
+    m_animationFrameBudgetSpinBox->setSingleStep(10);
+    m_animationFrameBudgetSpinBox->setSuffix(" frames/s");
+    animationForm->addRow("Frame budget:", m_animationFrameBudgetSpinBox);
+    
+    m_animationPolicyCombo = new QComboBox;
+    m_animationPolicyCombo->addItem("Always", "always");
+    m_animationPolicyCombo->addItem("While hovered", "hover");
+    m_animationPolicyCombo->addItem("When selected", "selected");
+    animationForm->addRow("Play previews:", m_animationPolicyCombo);
+    
+    m_animationLimitSpinBox = new QSpinBox;
+    m_animationLimitSpinBox->setRange(1, 64);
+    animationForm->addRow("At most playing:", m_animationLimitSpinBox);
+    
+    m_animationStatsLabel = new QLabel;
+    animationForm->addRow("Now:", m_animationStatsLabel);
+    animationLayout->addLayout(animationForm);
+    
+    layout->addWidget(animationGroup);
+    layout->addStretch();
+    
+    // Set the scroll widget
+    scrollArea->setWidget(scrollWidget);
+    mainLayout->addWidget(scrollArea);
+    
+    return widget;
+}
+
 void SettingsDialog::loadSettings()
 {
     // Paths
@@ -571,6 +906,42 @@ void SettingsDialog::loadSettings()
     
     // Update UI state based on WNEL enabled state
     onWNELEnabledChanged(m_enableWNELCheckbox->isChecked());
+    
+    // Load power profile settings
+    int actionIndex = m_batteryActionCombo->findData(m_config.batteryAction());
+    m_batteryActionCombo->setCurrentIndex(actionIndex >= 0 ? actionIndex : 0);
+    m_batteryFpsSpinBox->setValue(m_config.batteryFps());
+    m_batterySilentCheckbox->setChecked(m_config.batterySilent());
+    m_powerSysfsRootEdit->setText(m_config.powerSupplySysfsRoot());
+    m_batteryProfileCheckbox->setChecked(m_config.batteryProfileEnabled());
+    emit m_batteryProfileCheckbox->toggled(m_batteryProfileCheckbox->isChecked());
+    
+    // Load output settings
+    int captureIndex = m_outputCaptureCombo->findData(m_config.outputCaptureMode());
+    m_outputCaptureCombo->setCurrentIndex(captureIndex >= 0 ? captureIndex : 0);
+    m_outputLogLinesSpinBox->setValue(m_config.outputLogLines());
+    m_outputCollapseCheckbox->setChecked(m_config.outputCollapseRepeats());
+    m_outputLineBudgetSpinBox->setValue(m_config.outputLineBudget());
+    m_outputLogDirectoryEdit->setText(m_config.outputLogDirectory());
+    m_outputLogFileSizeSpinBox->setValue(qMax(1, m_config.outputLogFileSizeKb() / 1024));
+    m_outputLogFileCountSpinBox->setValue(m_config.outputLogFileCount());
+    m_outputCompressLogsCheckbox->setChecked(m_config.outputCompressRotatedLogs());
+    m_outputFileLoggingCheckbox->setChecked(m_config.outputFileLogging());
+    emit m_outputFileLoggingCheckbox->toggled(m_outputFileLoggingCheckbox->isChecked());
+    
+    // Load preview settings
+    m_thumbnailCacheSizeSpinBox->setValue(m_config.thumbnailCacheSizeMb());
+    m_thumbnailCacheCheckbox->setChecked(m_config.thumbnailCacheEnabled());
+    m_thumbnailCacheSizeSpinBox->setEnabled(m_thumbnailCacheCheckbox->isChecked());
+    m_thumbnailCacheUsageLabel->setText(QString("%1 MB").arg(ThumbnailCache::instance().diskUsage() / (1024.0 * 1024.0), 0, 'f', 1));
+    m_previewMemoryBudgetSpinBox->setValue(m_config.previewMemoryBudgetMb());
+    m_previewMemoryStatsLabel->setText(PreviewPixmapCache::instance().statsText());
+    m_previewPrefetchCheckbox->setChecked(m_config.previewPrefetchEnabled());
+    m_animationFrameBudgetSpinBox->setValue(m_config.previewAnimationFrameBudget());
+    int policyIndex = m_animationPolicyCombo->findData(m_config.previewAnimationPolicy());
+    m_animationPolicyCombo->setCurrentIndex(policyIndex >= 0 ? policyIndex : 0);
+    m_animationLimitSpinBox->setValue(m_config.previewAnimationLimit());
+    m_animationStatsLabel->setText(PreviewAnimator::instance().statsText());
 }
 
 void SettingsDialog::saveSettings()
@@ -606,6 +977,34 @@ void SettingsDialog::saveSettings()
     m_config.setExternalWallpapersPath(m_externalWallpapersPathEdit->text());
     m_config.setWNELBinaryPath(m_wnelBinaryPathEdit->text());
     
+    // Save power profile settings
+    m_config.setBatteryProfileEnabled(m_batteryProfileCheckbox->isChecked());
+    m_config.setBatteryAction(m_batteryActionCombo->currentData().toString());
+    m_config.setBatteryFps(m_batteryFpsSpinBox->value());
+    m_config.setBatterySilent(m_batterySilentCheckbox->isChecked());
+    QString sysfsRoot = m_powerSysfsRootEdit->text().trimmed();
+    m_config.setPowerSupplySysfsRoot(sysfsRoot.isEmpty() ? QString("/sys/class/power_supply") : sysfsRoot);
+    
+    // Save output settings
+    m_config.setOutputCaptureMode(m_outputCaptureCombo->currentData().toString());
+    m_config.setOutputLogLines(m_outputLogLinesSpinBox->value());
+    m_config.setOutputCollapseRepeats(m_outputCollapseCheckbox->isChecked());
+    m_config.setOutputLineBudget(m_outputLineBudgetSpinBox->value());
+    m_config.setOutputFileLogging(m_outputFileLoggingCheckbox->isChecked());
+    m_config.setOutputLogDirectory(m_outputLogDirectoryEdit->text().trimmed());
+    m_config.setOutputLogFileSizeKb(m_outputLogFileSizeSpinBox->value() * 1024);
+    m_config.setOutputLogFileCount(m_outputLogFileCountSpinBox->value());
+    m_config.setOutputCompressRotatedLogs(m_outputCompressLogsCheckbox->isChecked());
+    
+    // Save preview settings
+    m_config.setThumbnailCacheEnabled(m_thumbnailCacheCheckbox->isChecked());
+    m_config.setThumbnailCacheSizeMb(m_thumbnailCacheSizeSpinBox->value());
+    m_config.setPreviewMemoryBudgetMb(m_previewMemoryBudgetSpinBox->value());
+    m_config.setPreviewPrefetchEnabled(m_previewPrefetchCheckbox->isChecked());
+    m_config.setPreviewAnimationFrameBudget(m_animationFrameBudgetSpinBox->value());
+    m_config.setPreviewAnimationPolicy(m_animationPolicyCombo->currentData().toString());
+    m_config.setPreviewAnimationLimit(m_animationLimitSpinBox->value());
+    
     // Mark first run as complete if configuration is now valid
     if (m_config.isConfigurationValid()) {
         m_config.setFirstRun(false);
@@ -14,6 +14,7 @@
 #include <QCheckBox>
 #include <QComboBox>
 #include <QScrollArea>
+#include <QSpinBox>
 
 class ConfigManager;
 
@@ -56,6 +57,9 @@ private:
     QWidget* createApiTab();       // Method for Steam API tab
     QWidget* createThemeTab();     // Method for Theme tab
     QWidget* createExtraTab();     // Method for Extra tab
+    QWidget* createPowerTab();     // Method for Power tab
+    QWidget* createOutputTab();    // Method for Output tab
+    QWidget* createPreviewsTab();  // Method for Previews tab
     void loadSettings();
     void saveSettings();
     void updateSteamStatus();
@@ -94,6 +98,36 @@ private:
     QPushButton* m_browseWNELBinaryButton;
     QPushButton* m_testWNELBinaryButton;
     
+    // Power tab components
+    QCheckBox* m_batteryProfileCheckbox;
+    QComboBox* m_batteryActionCombo;
+    QSpinBox* m_batteryFpsSpinBox;
+    QCheckBox* m_batterySilentCheckbox;
+    QLineEdit* m_powerSysfsRootEdit;
+    
+    // Output tab components
+    QComboBox* m_outputCaptureCombo;
+    QSpinBox* m_outputLogLinesSpinBox;
+    QCheckBox* m_outputCollapseCheckbox;
+    QSpinBox* m_outputLineBudgetSpinBox;
+    QCheckBox* m_outputFileLoggingCheckbox;
+    QLineEdit* m_outputLogDirectoryEdit;
+    QSpinBox* m_outputLogFileSizeSpinBox;
+    QSpinBox* m_outputLogFileCountSpinBox;
+    QCheckBox* m_outputCompressLogsCheckbox;
+    
+    // Previews tab components
+    QCheckBox* m_thumbnailCacheCheckbox;
+    QSpinBox* m_thumbnailCacheSizeSpinBox;
+    QLabel* m_thumbnailCacheUsageLabel;
+    QSpinBox* m_previewMemoryBudgetSpinBox;
+    QLabel* m_previewMemoryStatsLabel;
+    QCheckBox* m_previewPrefetchCheckbox;
+    QSpinBox* m_animationFrameBudgetSpinBox;
+    QComboBox* m_animationPolicyCombo;
+    QSpinBox* m_animationLimitSpinBox;
+    QLabel* m_animationStatsLabel;
+    
     // Configuration
     ConfigManager& m_config;
 };
@@ -0,0 +1,202 @@
+#include "OutputLogView.h"
+#include <QApplication>
+#include <QClipboard>
+#include <QScrollBar>
+#include <algorithm>
+
+namespace {
+// One flush per display frame at 60 Hz
+constexpr int FLUSH_INTERVAL_MS = 16;
+}
+
+OutputLogModel::OutputLogModel(int capacity, QObject* parent)
+    : QAbstractListModel(parent)
+    , m_capacity(qMax(1, capacity))
+    , m_first(0)
+    , m_count(0)
+    , m_droppedLines(0)
+{
+    m_lines.resize(m_capacity);
+}
+
+int OutputLogModel::rowCount(const QModelIndex& parent) const
+{
+    return parent.isValid() ? 0 : m_count;
+}
+
+QVariant OutputLogModel::data(const QModelIndex& index, int role) const
+{
+    if (!index.isValid() || index.row() >= m_count) {
+        return QVariant();
+    }
+    
+    if (role == Qt::DisplayRole || role == Qt::ToolTipRole) {
+        return lineAt(index.row());
+    }
+    return QVariant();
+}
+
+void OutputLogModel::appendLine(const QString& line)
+{
+    m_pending.append(line);
+    
+    // Lines that would be evicted by the same flush are never stored
+    if (m_pending.size() > m_capacity) {
+        m_pending.removeFirst();
+        m_droppedLines++;
+    }
+}
+
+void OutputLogModel::flush()
+{
+    if (m_pending.isEmpty()) {
+        return;
+    }
+    
+    int incoming = m_pending.size();
+    int overflow = m_count + incoming - m_capacity;
+    
+    // Evict the oldest rows first so the view can drop them in one step
+    if (overflow > 0) {
+        int removed = qMin(overflow, m_count);
+        beginRemoveRows(QModelIndex(), 0, removed - 1);
+        for (int i = 0; i < removed; ++i) {
+            m_lines[(m_first + i) % m_capacity].clear();
+        }
+        m_first = (m_first + removed) % m_capacity;
+        m_count -= removed;
+        m_droppedLines += removed;
+        endRemoveRows();
+    }
+    
+    beginInsertRows(QModelIndex(), m_count, m_count + incoming - 1);
+    for (const QString& line : m_pending) {
+        m_lines[(m_first + m_count) % m_capacity] = line;
+        m_count++;
+    }
+    m_pending.clear();
+    endInsertRows();
+}
+
+void OutputLogModel::clear()
+{
+    beginResetModel();
+    m_lines.fill(QString());
+    m_first = 0;
+    m_count = 0;
+    m_pending.clear();
+    m_droppedLines = 0;
+    endResetModel();
+}
+
+void OutputLogModel::setCapacity(int capacity)
+{
+    capacity = qMax(1, capacity);
+    if (capacity == m_capacity) {
+        return;
+    }
+    
+    // Keep the newest lines that still fit
+    beginResetModel();
+    int kept = qMin(m_count, capacity);
+    QVector<QString> lines(capacity);
+    for (int i = 0; i < kept; ++i) {
+        lines[i] = m_lines[(m_first + m_count - kept + i) % m_capacity];
+    }
+    m_droppedLines += m_count - kept;
+    m_lines = lines;
+    m_capacity = capacity;
+    m_first = 0;
+    m_count = kept;
+    endResetModel();
+}
+
+QString OutputLogModel::lineAt(int row) const
+{
+    if (row < 0 || row >= m_count) {
+        return QString();
+    }
+    return m_lines[(m_first + row) % m_capacity];
+}
+
+QString OutputLogModel::toPlainText() const
+{
+    QStringList lines;
+    lines.reserve(m_count + m_pending.size());
+    for (int row = 0; row < m_count; ++row) {
+        lines << lineAt(row);
+    }
+    lines << m_pending;
+    return lines.join("\n");
+}
+
+OutputLogView::OutputLogView(QWidget* parent)
+    : QListView(parent)
+    , m_model(new OutputLogModel(10000, this))
+    , m_flushTimer(new QTimer(this))
+{
+    setModel(m_model);
+    
+    // Every row is a single line, so the view never measures more than it shows
+    setUniformItemSizes(true);
+    setSelectionMode(QAbstractItemView::ExtendedSelection);
+    setEditTriggers(QAbstractItemView::NoEditTriggers);
+    setVerticalScrollMode(QAbstractItemView::ScrollPerPixel);
+    setHorizontalScrollBarPolicy(Qt::ScrollBarAsNeeded);
+    setWordWrap(false);
+    
+    m_flushTimer->setSingleShot(true);
+    m_flushTimer->setInterval(FLUSH_INTERVAL_MS);
+    connect(m_flushTimer, &QTimer::timeout, this, &OutputLogView::flushPending);
+}
+
+void OutputLogView::appendLine(const QString& line)
+{
+    m_model->appendLine(line);
+    if (!m_flushTimer->isActive()) {
+        m_flushTimer->start();
+    }
+}
+
+void OutputLogView::clear()
+{
+    m_flushTimer->stop();
+    m_model->clear();
+}
+
+QString OutputLogView::toPlainText() const
+{
+    return m_model->toPlainText();
+}
+
+void OutputLogView::keyPressEvent(QKeyEvent* event)
+{
+    if (event->matches(QKeySequence::Copy)) {
+        QModelIndexList selected = selectionModel()->selectedRows();
+        std::sort(selected.begin(), selected.end());
+        
+        QStringList lines;
+        for (const QModelIndex& index : selected) {
+            lines << m_model->lineAt(index.row());
+        }
+        if (!lines.isEmpty()) {
+            QApplication::clipboard()->setText(lines.join("\n"));
+        }
+        return;
+    }
+    
+    QListView::keyPressEvent(event);
+}
+
+void OutputLogView::flushPending()
+{
+    // Follow the tail only if the user is looking at it
+    QScrollBar* scrollBar = verticalScrollBar();
+    bool atBottom = scrollBar->value() >= scrollBar->maximum();
+    
+    m_model->flush();
+    
+    if (atBottom) {
+        scrollToBottom();
+    }
+}
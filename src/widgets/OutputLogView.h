@@ -0,0 +1,74 @@
+#ifndef OUTPUTLOGVIEW_H
+#define OUTPUTLOGVIEW_H
+
+#include <QAbstractListModel>
+#include <QListView>
+#include <QStringList>
+#include <QVector>
+#include <QTimer>
+#include <QKeyEvent>
+
+// Bounded log for the Output tab. Lines are kept in a fixed size ring buffer;
+// appended lines are only staged and become rows when flush() runs, so the
+// view sees one insert per batch instead of one per line.
+class OutputLogModel : public QAbstractListModel
+{
+    Q_OBJECT
+
+public:
+    explicit OutputLogModel(int capacity = 10000, QObject* parent = nullptr);
+    
+    int rowCount(const QModelIndex& parent = QModelIndex()) const override;
+    QVariant data(const QModelIndex& index, int role = Qt::DisplayRole) const override;
+    
+    void appendLine(const QString& line);
+    bool hasPendingLines() const { return !m_pending.isEmpty(); }
+    void flush();
+    void clear();
+    
+    int capacity() const { return m_capacity; }
+    void setCapacity(int capacity);
+    
+    // Lines pushed out of the buffer since the last clear()
+    qint64 droppedLines() const { return m_droppedLines; }
+    
+    QString lineAt(int row) const;
+    QString toPlainText() const;
+
+private:
+    QVector<QString> m_lines;   // ring storage, m_capacity slots
+    int m_capacity;
+    int m_first;                // slot of row 0
+    int m_count;
+    QStringList m_pending;
+    qint64 m_droppedLines;
+};
+
+// Virtualized view over an OutputLogModel. Only visible rows are laid out and
+// painted; staged lines are flushed at most once per frame (~16 ms) and the
+// view follows the tail unless the user has scrolled up.
+class OutputLogView : public QListView
+{
+    Q_OBJECT
+
+public:
+    explicit OutputLogView(QWidget* parent = nullptr);
+    
+    OutputLogModel* logModel() const { return m_model; }
+    
+    void appendLine(const QString& line);
+    void clear();
+    QString toPlainText() const;
+
+protected:
+    void keyPressEvent(QKeyEvent* event) override;
+
+private slots:
+    void flushPending();
+
+private:
+    OutputLogModel* m_model;
+    QTimer* m_flushTimer;
+};
+
+#endif // OUTPUTLOGVIEW_H
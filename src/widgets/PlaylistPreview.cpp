@@ -1,5 +1,9 @@
 #include "PlaylistPreview.h"
 #include "../addons/WNELAddon.h"  // Add WNELAddon include
+#include "../core/PreviewPixmapCache.h"
+#include "../core/PreviewAnimator.h"
+#include "../core/PreviewPlaceholder.h"
+#include "PreviewCardPainter.h"
 #include <QApplication>
 #include <QStyle>
 #include <QPixmap>
@@ -12,9 +16,46 @@
 #include <QDebug>
 #include <QFileInfo>
 #include <QLoggingCategory>
+#include <QScrollBar>
 
 Q_LOGGING_CATEGORY(playlistPreview, "app.playlistpreview")
 
+namespace {
+// Playlist position badge over the preview
+const QColor BADGE_COLOR(52, 152, 219, 200);
+constexpr int BADGE_SIZE = 30;
+
+// Round button over the preview, painted from its palette's Button and
+// ButtonText colours. Per-button style sheets made every item carry its own
+// style and re-polish on theme changes
+class OverlayButton : public QAbstractButton
+{
+public:
+    OverlayButton(const QString& text, const QColor& color, QWidget* parent)
+        : QAbstractButton(parent)
+    {
+        setText(text);
+        setAttribute(Qt::WA_Hover);
+        
+        QPalette buttonPalette = palette();
+        buttonPalette.setColor(QPalette::Button, color);
+        buttonPalette.setColor(QPalette::ButtonText, Qt::white);
+        setPalette(buttonPalette);
+    }
+
+protected:
+    void paintEvent(QPaintEvent* event) override
+    {
+        Q_UNUSED(event)
+        QPainter painter(this);
+        QColor background = palette().color(QPalette::Button);
+        background.setAlpha(underMouse() || isDown() ? 255 : 200);
+        painter.setFont(font());
+        PreviewCardPainter::drawBadge(painter, rect(), text(), background, palette().color(QPalette::ButtonText));
+    }
+};
+}
+
 PlaylistPreview::PlaylistPreview(WallpaperPlaylist* playlist, WallpaperManager* wallpaperManager, QWidget* parent)
     : QWidget(parent)
     , m_playlist(playlist)
@@ -54,6 +95,13 @@ PlaylistPreview::PlaylistPreview(WallpaperPlaylist* playlist, WallpaperManager*
     // Enable drag and drop
     setAcceptDrops(true);
     
+    // Animation policy changes from Settings apply to the items already shown
+    connect(&PreviewAnimator::instance(), &PreviewAnimator::policyChanged, this, [this]() {
+        for (PlaylistPreviewItem* item : m_itemWidgets) {
+            item->updateAnimation();
+        }
+    });
+    
     // Initial refresh    
     qCDebug(playlistPreview) << "PlaylistPreview::PlaylistPreview() - About to call refreshPlaylist()";
     refreshPlaylist();
@@ -65,7 +113,7 @@ void PlaylistPreview::setupUI()
     m_mainLayout = new QVBoxLayout(this);
     m_mainLayout->setContentsMargins(10, 10, 10, 10);
     m_mainLayout->setSpacing(10);
-
+    
     // Setup playback controls
     setupPlaylistControls();
     
@@ -85,6 +133,15 @@ void PlaylistPreview::setupUI()
     
     m_scrollArea->setWidget(m_scrollContent);
     m_mainLayout->addWidget(m_scrollArea, 1); // Give it most of the space
+    
+    // Drop queued preview decodes for items that scroll out of view
+    connect(m_scrollArea->verticalScrollBar(), &QScrollBar::valueChanged, this, [this]() {
+        for (PlaylistPreviewItem* item : m_itemWidgets) {
+            if (item->hasPendingPreview() && item->visibleRegion().isEmpty()) {
+                item->cancelPreviewRequest();
+            }
+        }
+    });
 }
 
 void PlaylistPreview::setupPlaylistControls()
@@ -577,6 +634,7 @@ void PlaylistPreview::adjustGridForNewColumnCount(int newColumnCount)
 void PlaylistPreview::clearCurrentItems()
 {
     for (auto* widget : m_itemWidgets) {
+        widget->cancelPreviewRequest();
         widget->deleteLater();
     }
     m_itemWidgets.clear();
@@ -591,7 +649,9 @@ PlaylistPreviewItem::PlaylistPreviewItem(const PlaylistItem& item, int index, Pl
     , m_isCurrent(false)
     , m_selected(false)
     , m_playlistPreview(parent)
-    , m_previewMovie(nullptr)
+    , m_animation(0)
+    , m_previewRequest(0)
+    , m_previewFailed(false)
     , m_useCustomPainting(true)
 {
     setFixedSize(ITEM_WIDTH, ITEM_HEIGHT + 20);
@@ -625,46 +685,38 @@ PlaylistPreviewItem::PlaylistPreviewItem(const PlaylistItem& item, int index, Pl
     loadPreviewImage();
 }
 
+PlaylistPreviewItem::~PlaylistPreviewItem()
+{
+    // Hand the shared pixmap back to the cache
+    stopAnimation();
+    cancelPreviewRequest();
+    releasePreview();
+}
+
 void PlaylistPreviewItem::setupUI()
 {
     setContentsMargins(0, 0, 0, 0);
     
     // Create control buttons (positioned over the preview)
-    m_removeButton = new QPushButton("×", this);
+    m_removeButton = new OverlayButton("×", QColor(231, 76, 60), this);
     m_removeButton->setFixedSize(24, 24);
-    m_removeButton->setStyleSheet(
-        "QPushButton { background-color: rgba(231, 76, 60, 200); color: white; border: none; border-radius: 12px; font-weight: bold; }"
-        "QPushButton:hover { background-color: rgba(231, 76, 60, 255); }"
-    );
     m_removeButton->setToolTip("Remove from playlist");
     
-    m_moveUpButton = new QPushButton("↑", this);
+    m_moveUpButton = new OverlayButton("↑", QColor(52, 152, 219), this);
     m_moveUpButton->setFixedSize(24, 24);
-    m_moveUpButton->setStyleSheet(
-        "QPushButton { background-color: rgba(52, 152, 219, 200); color: white; border: none; border-radius: 12px; font-weight: bold; }"
-        "QPushButton:hover { background-color: rgba(52, 152, 219, 255); }"
-    );
     m_moveUpButton->setToolTip("Move up");
     
-    m_moveDownButton = new QPushButton("↓", this);
+    m_moveDownButton = new OverlayButton("↓", QColor(52, 152, 219), this);
     m_moveDownButton->setFixedSize(24, 24);
-    m_moveDownButton->setStyleSheet(
-        "QPushButton { background-color: rgba(52, 152, 219, 200); color: white; border: none; border-radius: 12px; font-weight: bold; }"
-        "QPushButton:hover { background-color: rgba(52, 152, 219, 255); }"
-    );
     m_moveDownButton->setToolTip("Move down");
     
-    m_positionLabel = new QLabel(QString::number(m_index + 1), this);
-    m_positionLabel->setFixedSize(30, 30);
-    m_positionLabel->setAlignment(Qt::AlignCenter);
-    m_positionLabel->setStyleSheet(
-        "QLabel { background-color: rgba(52, 152, 219, 200); color: white; border: none; border-radius: 15px; font-weight: bold; }"
-    );
+    // Hover is painted as a frame around the card
+    setAttribute(Qt::WA_Hover);
     
     // Connect signals
-    connect(m_removeButton, &QPushButton::clicked, this, &PlaylistPreviewItem::onRemoveClicked);
-    connect(m_moveUpButton, &QPushButton::clicked, this, &PlaylistPreviewItem::onMoveUpClicked);
-    connect(m_moveDownButton, &QPushButton::clicked, this, &PlaylistPreviewItem::onMoveDownClicked);
+    connect(m_removeButton, &QAbstractButton::clicked, this, &PlaylistPreviewItem::onRemoveClicked);
+    connect(m_moveUpButton, &QAbstractButton::clicked, this, &PlaylistPreviewItem::onMoveUpClicked);
+    connect(m_moveDownButton, &QAbstractButton::clicked, this, &PlaylistPreviewItem::onMoveDownClicked);
 }
 
 void PlaylistPreviewItem::loadPreviewImage()
@@ -675,23 +727,58 @@ void PlaylistPreviewItem::loadPreviewImage()
         qCDebug(playlistPreview) << "Loading preview image from:" << m_wallpaperInfo.previewPath;
         // Check if it's an animated preview first
         if (hasAnimatedPreview()) {
-            loadAnimatedPreview();
+            updateAnimation();
             return;
         }
         
-        // Load static image
-        QPixmap pixmap(m_wallpaperInfo.previewPath);
-        if (!pixmap.isNull()) {
-            qCDebug(playlistPreview) << "Successfully loaded static preview, size:" << pixmap.size();
-            setPreviewPixmap(pixmap);
-        } else {
-            qCDebug(playlistPreview) << "Failed to load pixmap from:" << m_wallpaperInfo.previewPath;
-        }
+        // The still is decoded off the GUI thread once the item is first painted
     } else {
         qCDebug(playlistPreview) << "Preview path is empty or doesn't exist:" << m_wallpaperInfo.previewPath;
     }
 }
 
+void PlaylistPreviewItem::requestPreview()
+{
+    if (m_previewRequest != 0 || m_previewFailed || m_wallpaperInfo.previewPath.isEmpty()) {
+        return;
+    }
+    
+    QSize previewSize(PREVIEW_WIDTH, PREVIEW_HEIGHT);
+    qreal dpr = devicePixelRatioF();
+    QString previewKey = PreviewPixmapCache::key(m_wallpaperInfo.previewPath, previewSize, dpr);
+    m_previewRequest = PreviewPixmapCache::instance().load(m_wallpaperInfo.previewPath, previewSize, this,
+        [this, previewKey](const QPixmap& pixmap) {
+            m_previewRequest = 0;
+            if (pixmap.isNull()) {
+                qCDebug(playlistPreview) << "Failed to load pixmap from:" << m_wallpaperInfo.previewPath;
+                m_previewFailed = true;
+                return;
+            }
+            releasePreview();
+            m_previewKey = previewKey;
+            // A running animation has newer frames than the cached still
+            if (!isAnimationPlaying() || m_scaledPreview.isNull()) {
+                setPreviewPixmap(pixmap);
+            }
+        }, true, dpr);
+}
+
+void PlaylistPreviewItem::cancelPreviewRequest()
+{
+    if (m_previewRequest != 0) {
+        PreviewPixmapCache::instance().cancel(m_previewRequest);
+        m_previewRequest = 0;
+    }
+}
+
+void PlaylistPreviewItem::releasePreview()
+{
+    if (!m_previewKey.isEmpty()) {
+        PreviewPixmapCache::instance().release(m_previewKey);
+        m_previewKey.clear();
+    }
+}
+
 void PlaylistPreviewItem::setPreviewPixmap(const QPixmap& pixmap)
 {
     if (pixmap.isNull()) {
@@ -704,10 +791,17 @@ void PlaylistPreviewItem::setPreviewPixmap(const QPixmap& pixmap)
 
 QPixmap PlaylistPreviewItem::scalePreviewKeepAspectRatio(const QPixmap& original)
 {
-    QSize containerSize(PREVIEW_WIDTH, PREVIEW_HEIGHT);
+    // Fit in device pixels; a preview decoded for this screen passes through
+    qreal dpr = devicePixelRatioF();
+    QSize containerSize = QSize(PREVIEW_WIDTH, PREVIEW_HEIGHT) * dpr;
     QSize scaledSize = calculateFitSize(original.size(), containerSize);
+    if (scaledSize == original.size() && original.devicePixelRatio() == dpr) {
+        return original;
+    }
     
-    return original.scaled(scaledSize, Qt::KeepAspectRatio, Qt::SmoothTransformation);
+    QPixmap scaled = original.scaled(scaledSize, Qt::KeepAspectRatio, Qt::SmoothTransformation);
+    scaled.setDevicePixelRatio(dpr);
+    return scaled;
 }
 
 QSize PlaylistPreviewItem::calculateFitSize(const QSize& imageSize, const QSize& containerSize)
@@ -726,8 +820,7 @@ bool PlaylistPreviewItem::hasAnimatedPreview() const
         return false;
     }
     
-    QString lowerPath = m_wallpaperInfo.previewPath.toLower();
-    return lowerPath.endsWith(".gif") || lowerPath.endsWith(".webp");
+    return PreviewAnimator::isAnimatedPreview(m_wallpaperInfo.previewPath);
 }
 
 void PlaylistPreviewItem::loadAnimatedPreview()
@@ -736,71 +829,46 @@ void PlaylistPreviewItem::loadAnimatedPreview()
         return;
     }
     
-    // Clean up existing movie if any
-    if (m_previewMovie) {
-        m_previewMovie->stop();
-        m_previewMovie->deleteLater();
-        m_previewMovie = nullptr;
-    }
-    
-    // Create and configure QMovie for animation
-    m_previewMovie = new QMovie(m_wallpaperInfo.previewPath, QByteArray(), this);
-    
-    if (!m_previewMovie->isValid()) {
-        m_previewMovie->deleteLater();
-        m_previewMovie = nullptr;
-        // Fall back to static image
-        QPixmap staticPixmap(m_wallpaperInfo.previewPath);
-        if (!staticPixmap.isNull()) {
-            setPreviewPixmap(staticPixmap);
-        }
-        return;
-    }
+    stopAnimation();
     
-    // Connect to movie signals for frame updates
-    connect(m_previewMovie, &QMovie::frameChanged, this, [this](int frameNumber) {
-        Q_UNUSED(frameNumber)
-        if (m_previewMovie) {
-            QPixmap currentFrame = m_previewMovie->currentPixmap();
-            if (!currentFrame.isNull()) {
-                m_scaledPreview = scalePreviewKeepAspectRatio(currentFrame);
-                update();
-            }
-        }
-    });
+    // The shared animator only decodes while this item is on screen, and
+    // hands over frames already fitted to the preview
+    m_animation = PreviewAnimator::instance().start(m_wallpaperInfo.previewPath,
+        QSize(PREVIEW_WIDTH, PREVIEW_HEIGHT), this,
+        [this](const QPixmap& frame) {
+            m_scaledPreview = frame;
+            update();
+        });
     
-    // Get the first frame
-    m_previewMovie->jumpToFrame(0);
-    QPixmap firstFrame = m_previewMovie->currentPixmap();
-    if (!firstFrame.isNull()) {
-        m_scaledPreview = scalePreviewKeepAspectRatio(firstFrame);
-        update();
-    }
+    // The first frame comes from the thumbnail cache when the item is painted
 }
 
 void PlaylistPreviewItem::startAnimation()
 {
-    if (m_previewMovie && m_previewMovie->isValid()) {
-        m_previewMovie->start();
+    if (m_animation == 0) {
+        loadAnimatedPreview();
     }
 }
 
 void PlaylistPreviewItem::stopAnimation()
 {
-    if (m_previewMovie && m_previewMovie->state() == QMovie::Running) {
-        m_previewMovie->stop();
+    if (m_animation != 0) {
+        PreviewAnimator::instance().stop(m_animation);
+        m_animation = 0;
     }
 }
 
 bool PlaylistPreviewItem::isAnimationPlaying() const
 {
-    return m_previewMovie && m_previewMovie->state() == QMovie::Running;
+    return m_animation != 0;
 }
 
 void PlaylistPreviewItem::setIndex(int index)
 {
-    m_index = index;
-    m_positionLabel->setText(QString::number(index + 1));
+    if (m_index != index) {
+        m_index = index;
+        update();
+    }
 }
 
 void PlaylistPreviewItem::setCurrent(bool current)
@@ -813,10 +881,42 @@ void PlaylistPreviewItem::setSelected(bool selected)
 {
     if (m_selected != selected) {
         m_selected = selected;
+        updateAnimation();
         update();
     }
 }
 
+void PlaylistPreviewItem::updateAnimation()
+{
+    bool animate = hasAnimatedPreview() && PreviewAnimator::instance().shouldAnimate(underMouse(), m_selected);
+    if (animate) {
+        startAnimation();
+    } else if (isAnimationPlaying()) {
+        stopAnimation();
+        
+        // Back to the still; the reference we hold keeps it cached, so the
+        // next paint gets it right away
+        m_scaledPreview = QPixmap();
+        update();
+    }
+}
+
+void PlaylistPreviewItem::enterEvent(QEnterEvent* event)
+{
+    QWidget::enterEvent(event);
+    if (PreviewAnimator::instance().policy() == PreviewAnimator::Policy::Hover) {
+        updateAnimation();
+    }
+}
+
+void PlaylistPreviewItem::leaveEvent(QEvent* event)
+{
+    QWidget::leaveEvent(event);
+    if (PreviewAnimator::instance().policy() == PreviewAnimator::Policy::Hover) {
+        updateAnimation();
+    }
+}
+
 void PlaylistPreviewItem::paintEvent(QPaintEvent* event)
 {
     if (!event || !isVisible()) {
@@ -828,26 +928,28 @@ void PlaylistPreviewItem::paintEvent(QPaintEvent* event)
         return;
     }
     
+    // Only items scrolled into view get painted, and so decoded; moving to a
+    // screen with another pixel ratio decodes a sharp copy
+    if (m_scaledPreview.isNull() ||
+        (!isAnimationPlaying() && m_scaledPreview.devicePixelRatio() != devicePixelRatioF())) {
+        requestPreview();
+    }
+    
     QPainter painter(this);
     painter.setRenderHint(QPainter::Antialiasing);
     painter.setRenderHint(QPainter::TextAntialiasing);
     
-    // Background with selection/current state
-    QColor bgColor;
+    // Background with selection/current state; the frames are cached pixmaps
     if (m_isCurrent) {
-        bgColor = QColor(52, 152, 219, 100); // Blue for current
+        PreviewCardPainter::drawFrame(painter, rect(), QColor(52, 152, 219, 100), QColor(52, 152, 219), 3);
     } else if (m_selected) {
-        bgColor = palette().color(QPalette::Highlight);
+        PreviewCardPainter::drawFrame(painter, rect(), palette().color(QPalette::Highlight),
+                                      palette().color(QPalette::Highlight), 3);
+    } else if (underMouse()) {
+        PreviewCardPainter::drawFrame(painter, rect(), palette().color(QPalette::Base),
+                                      palette().color(QPalette::Midlight), 3);
     } else {
-        bgColor = palette().color(QPalette::Base);
-    }
-    painter.fillRect(rect(), bgColor);
-    
-    // Border for current or selected
-    if (m_isCurrent || m_selected) {
-        QPen borderPen(m_isCurrent ? QColor(52, 152, 219) : palette().color(QPalette::Highlight), 3);
-        painter.setPen(borderPen);
-        painter.drawRect(rect().adjusted(1, 1, -1, -1));
+        PreviewCardPainter::drawFrame(painter, rect(), palette().color(QPalette::Base));
     }
     
     int availableWidth = currentSize.width() - 2 * PREVIEW_CONTAINER_MARGIN;
@@ -861,8 +963,9 @@ void PlaylistPreviewItem::paintEvent(QPaintEvent* event)
                                  previewWidth, previewHeight);
         
         QRect imageRect = previewRect;
-        if (m_scaledPreview.size() != previewRect.size()) {
-            QSize scaledSize = m_scaledPreview.size().scaled(previewRect.size(), Qt::KeepAspectRatio);
+        QSize previewSize = m_scaledPreview.deviceIndependentSize().toSize();
+        if (previewSize != previewRect.size()) {
+            QSize scaledSize = previewSize.scaled(previewRect.size(), Qt::KeepAspectRatio);
             imageRect = QRect(
                 previewRect.x() + (previewRect.width() - scaledSize.width()) / 2,
                 previewRect.y() + (previewRect.height() - scaledSize.height()) / 2,
@@ -875,14 +978,18 @@ void PlaylistPreviewItem::paintEvent(QPaintEvent* event)
     } else {
         QRect previewRect = QRect(PREVIEW_CONTAINER_MARGIN, PREVIEW_CONTAINER_MARGIN, 
                                  previewWidth, previewHeight);
-        
-        if (previewRect.width() > 0 && previewRect.height() > 0) {
-            painter.fillRect(previewRect, QColor(60, 60, 60));
-            painter.setPen(QColor(120, 120, 120));
-            painter.drawText(previewRect, Qt::AlignCenter, "Loading...");
-        }
+        QByteArray placeholder = m_wallpaperInfo.previewPlaceholder.isEmpty()
+            ? PreviewPlaceholder::instance().cached(m_wallpaperInfo.previewPath)
+            : m_wallpaperInfo.previewPlaceholder;
+        PreviewCardPainter::drawPlaceholder(painter, previewRect, placeholder);
     }
     
+    // Playlist position in the top-left corner of the preview
+    int badgeMargin = 4;
+    QRect badgeRect(PREVIEW_CONTAINER_MARGIN + badgeMargin, PREVIEW_CONTAINER_MARGIN + badgeMargin,
+                    BADGE_SIZE, BADGE_SIZE);
+    PreviewCardPainter::drawBadge(painter, badgeRect, QString::number(m_index + 1), BADGE_COLOR, Qt::white);
+    
     // Draw text information
     int textY = PREVIEW_CONTAINER_MARGIN + previewHeight + TEXT_MARGIN;
     int maxTextWidth = availableWidth - TEXT_MARGIN;
@@ -891,8 +998,6 @@ void PlaylistPreviewItem::paintEvent(QPaintEvent* event)
     if (maxTextWidth > 0 && maxTextHeight > 0) {
         QRect textRect = QRect(PREVIEW_CONTAINER_MARGIN + TEXT_MARGIN/2, textY, maxTextWidth, maxTextHeight);
         
-        painter.setPen(palette().color(QPalette::Text));
-        
         QFont nameFont = font();
         nameFont.setBold(true);
         nameFont.setPointSize(qMax(8, font().pointSize()));
@@ -904,7 +1009,7 @@ void PlaylistPreviewItem::paintEvent(QPaintEvent* event)
         int maxNameLines = qMax(1, qMin(3, maxTextHeight / nameLineHeight - 2));
         
         QRect nameRect = QRect(textRect.x(), textRect.y(), textRect.width(), nameLineHeight * maxNameLines);
-        drawTextWithWordWrap(painter, displayName, nameRect, nameFont, palette().color(QPalette::Text));
+        PreviewCardPainter::drawWrappedText(painter, displayName, nameRect, nameFont, palette().color(QPalette::Text));
         
         QFont infoFont = font();
         infoFont.setPointSize(qMax(7, font().pointSize() - 1));
@@ -920,77 +1025,12 @@ void PlaylistPreviewItem::paintEvent(QPaintEvent* event)
             
             QString infoText = infoLines.join(" • ");
             if (!infoText.isEmpty()) {
-                painter.setPen(palette().color(QPalette::Mid));
-                drawTextWithWordWrap(painter, infoText, infoRect, infoFont, palette().color(QPalette::Mid));
+                PreviewCardPainter::drawWrappedText(painter, infoText, infoRect, infoFont, palette().color(QPalette::Mid));
             }
         }
     }
 }
 
-void PlaylistPreviewItem::drawTextWithWordWrap(QPainter& painter, const QString& text, const QRect& rect, 
-                                             const QFont& font, const QColor& color, Qt::Alignment alignment)
-{
-    if (text.isEmpty() || rect.isEmpty()) {
-        return;
-    }
-    
-    painter.setFont(font);
-    painter.setPen(color);
-    
-    QFontMetrics fm(font);
-    QStringList words = text.split(' ', Qt::SkipEmptyParts);
-    
-    if (words.isEmpty()) {
-        return;
-    }
-    
-    QStringList lines;
-    QString currentLine;
-    
-    for (const QString& word : words) {
-        QString testLine = currentLine.isEmpty() ? word : currentLine + " " + word;
-        
-        if (fm.horizontalAdvance(testLine) <= rect.width()) {
-            currentLine = testLine;
-        } else {
-            if (!currentLine.isEmpty()) {
-                lines.append(currentLine);
-                currentLine = word;
-            } else {
-                currentLine = fm.elidedText(word, Qt::ElideRight, rect.width());
-                lines.append(currentLine);
-                currentLine = "";
-            }
-        }
-    }
-    
-    if (!currentLine.isEmpty()) {
-        lines.append(currentLine);
-    }
-    
-    int lineHeight = fm.height();
-    int startY = rect.y();
-    
-    Qt::Alignment vAlign = alignment & Qt::AlignVertical_Mask;
-    if (vAlign == Qt::AlignVCenter) {
-        int usedHeight = lines.size() * lineHeight;
-        startY = rect.y() + (rect.height() - usedHeight) / 2;
-    } else if (vAlign == Qt::AlignBottom) {
-        int usedHeight = lines.size() * lineHeight;
-        startY = rect.bottom() - usedHeight;
-    }
-    
-    for (int i = 0; i < lines.size(); ++i) {
-        QString line = lines[i];
-        QRect lineRect = QRect(rect.x(), startY + i * lineHeight, rect.width(), lineHeight);
-        
-        Qt::Alignment hAlign = alignment & Qt::AlignHorizontal_Mask;
-        if (hAlign == 0) hAlign = Qt::AlignLeft;
-        
-        painter.drawText(lineRect, hAlign | Qt::AlignVCenter, line);
-    }
-}
-
 void PlaylistPreviewItem::resizeEvent(QResizeEvent* event)
 {
     if (!event) {
@@ -1011,9 +1051,6 @@ void PlaylistPreviewItem::resizeEvent(QResizeEvent* event)
     m_moveUpButton->move(buttonX, buttonY + buttonSize + 2);
     m_moveDownButton->move(buttonX, buttonY + 2 * (buttonSize + 2));
     
-    // Position label in top-left corner
-    m_positionLabel->move(PREVIEW_CONTAINER_MARGIN + margin, PREVIEW_CONTAINER_MARGIN + margin);
-    
     if (isVisible() && !m_wallpaperInfo.id.isEmpty()) {
         updateTextLayout();
     }
@@ -1059,13 +1096,13 @@ void PlaylistPreviewItem::mouseMoveEvent(QMouseEvent* event)
         QWidget::mouseMoveEvent(event);
         return;
     }
-
+    
     int distance = (event->pos() - m_dragStartPosition).manhattanLength();
     if (distance < QApplication::startDragDistance()) {
         QWidget::mouseMoveEvent(event);
         return;
     }
-
+    
     // Start drag operation
     QDrag* drag = new QDrag(this);
     QMimeData* mimeData = new QMimeData;
@@ -1079,14 +1116,17 @@ void PlaylistPreviewItem::mouseMoveEvent(QMouseEvent* event)
     // Create a drag pixmap from the preview
     QPixmap dragPixmap;
     if (!m_scaledPreview.isNull()) {
-        dragPixmap = m_scaledPreview.scaled(64, 64, Qt::KeepAspectRatio, Qt::SmoothTransformation);
+        // Keep the preview's pixel ratio so the drag image stays 64 logical pixels
+        dragPixmap = m_scaledPreview.scaled(QSize(64, 64) * m_scaledPreview.devicePixelRatio(), Qt::KeepAspectRatio, Qt::SmoothTransformation);
+        dragPixmap.setDevicePixelRatio(m_scaledPreview.devicePixelRatio());
     } else {
         dragPixmap = QPixmap(64, 64);
         dragPixmap.fill(Qt::gray);
     }
     
     drag->setPixmap(dragPixmap);
-    drag->setHotSpot(QPoint(dragPixmap.width() / 2, dragPixmap.height() / 2));
+    QSize dragSize = dragPixmap.deviceIndependentSize().toSize();
+    drag->setHotSpot(QPoint(dragSize.width() / 2, dragSize.height() / 2));
     
     // Execute the drag
     drag->exec(Qt::CopyAction);
@@ -1168,8 +1208,8 @@ void PlaylistPreview::startAllPreviewAnimations()
             if (layoutItem && layoutItem->widget()) {
                 PlaylistPreviewItem* item = qobject_cast<PlaylistPreviewItem*>(layoutItem->widget());
                 if (item && item->hasAnimatedPreview() && !item->isAnimationPlaying()) {
-                    // Re-trigger animation loading (this will start it automatically)
-                    item->loadAnimatedPreview();
+                    // Only the items the animation policy picks start again
+                    item->updateAnimation();
                 }
             }
         }
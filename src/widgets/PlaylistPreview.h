@@ -8,6 +8,7 @@
 #include <QVBoxLayout>
 #include <QHBoxLayout>
 #include <QPushButton>
+#include <QAbstractButton>
 #include <QSpinBox>
 #include <QComboBox>
 #include <QCheckBox>
@@ -19,11 +20,11 @@
 #include <QMimeData>
 #include <QDrag>
 #include <QMouseEvent>
+#include <QEnterEvent>
 #include <QPaintEvent>
 #include <QPainter>
 #include <QResizeEvent>
 #include <QTimer>
-#include <QMovie>
 #include <QNetworkAccessManager>
 #include <QRandomGenerator>
 #include "../playlist/WallpaperPlaylist.h"
@@ -154,6 +155,7 @@ class PlaylistPreviewItem : public QWidget
 
 public:
     explicit PlaylistPreviewItem(const PlaylistItem& item, int index, PlaylistPreview* parent = nullptr);
+    ~PlaylistPreviewItem() override;
     
     const PlaylistItem& playlistItem() const { return m_item; }
     int getIndex() const { return m_index; }
@@ -172,8 +174,15 @@ public:
     void startAnimation();
     void stopAnimation();
     void loadAnimatedPreview();
+    // Starts or stops the animation as PreviewAnimator's policy asks for
+    void updateAnimation();
     
-    // Layout constants (same as WallpaperPreviewItem)
+    // Asynchronous preview decoding; cancelled for items scrolled out of view
+    void requestPreview();
+    void cancelPreviewRequest();
+    bool hasPendingPreview() const { return m_previewRequest != 0; }
+    
+    // Layout constants (same as WallpaperGridDelegate)
     static constexpr int ITEM_WIDTH = 280;
     static constexpr int ITEM_HEIGHT = 240;
     static constexpr int PREVIEW_WIDTH = 256;
@@ -195,6 +204,8 @@ protected:
     void mouseDoubleClickEvent(QMouseEvent* event) override;
     void mouseMoveEvent(QMouseEvent* event) override;
     void resizeEvent(QResizeEvent* event) override;
+    void enterEvent(QEnterEvent* event) override;
+    void leaveEvent(QEvent* event) override;
 
 private slots:
     void onRemoveClicked();
@@ -204,11 +215,10 @@ private slots:
 private:
     void setupUI();
     void loadPreviewImage();
+    void releasePreview();
     void setPreviewPixmap(const QPixmap& pixmap);
     QPixmap scalePreviewKeepAspectRatio(const QPixmap& original);
     QSize calculateFitSize(const QSize& imageSize, const QSize& containerSize);
-    void drawTextWithWordWrap(QPainter& painter, const QString& text, const QRect& rect, 
-                             const QFont& font, const QColor& color, Qt::Alignment alignment = Qt::AlignLeft);
     void updateTextLayout();
 
     PlaylistItem m_item;
@@ -220,14 +230,16 @@ private:
     
     // Preview display
     QPixmap m_scaledPreview;
-    QMovie* m_previewMovie;
+    quint64 m_animation;    // PreviewAnimator id
+    quint64 m_previewRequest;
+    QString m_previewKey;   // reference held in PreviewPixmapCache
+    bool m_previewFailed;
     bool m_useCustomPainting;
     
-    // Control buttons (positioned over the preview)
-    QPushButton* m_removeButton;
-    QPushButton* m_moveUpButton;
-    QPushButton* m_moveDownButton;
-    QLabel* m_positionLabel;
+    // Control buttons (positioned over the preview); the position badge is painted
+    QAbstractButton* m_removeButton;
+    QAbstractButton* m_moveUpButton;
+    QAbstractButton* m_moveDownButton;
     
     // Drag support
     QPoint m_dragStartPosition;
@@ -0,0 +1,204 @@
+#include "PreviewCardPainter.h"
+#include "../core/PreviewPlaceholder.h"
+#include <QCache>
+#include <QFontMetrics>
+#include <QPixmapCache>
+#include <QStaticText>
+#include <QVector>
+
+namespace {
+// Roughly three lines per card for a few thousand cards
+constexpr int TEXT_CACHE_LINES = 8192;
+
+struct WrappedText {
+    QVector<QStaticText> lines;
+    int lineHeight = 0;
+};
+
+QCache<QString, WrappedText>& textCache()
+{
+    static QCache<QString, WrappedText> cache(TEXT_CACHE_LINES);
+    return cache;
+}
+
+QString colorKey(const QColor& color)
+{
+    return color.isValid() ? QString::number(color.rgba(), 16) : QStringLiteral("none");
+}
+}
+
+QStringList PreviewCardPainter::wrapText(const QString& text, const QFont& font, const QRect& rect)
+{
+    QFontMetrics fm(font);
+    QStringList words = text.split(' ', Qt::SkipEmptyParts);
+    
+    QStringList lines;
+    QString currentLine;
+    
+    for (const QString& word : words) {
+        QString testLine = currentLine.isEmpty() ? word : currentLine + " " + word;
+        
+        if (fm.horizontalAdvance(testLine) <= rect.width()) {
+            currentLine = testLine;
+        } else {
+            if (!currentLine.isEmpty()) {
+                lines.append(currentLine);
+                currentLine = word;
+            } else {
+                currentLine = fm.elidedText(word, Qt::ElideRight, rect.width());
+                lines.append(currentLine);
+                currentLine.clear();
+            }
+        }
+    }
+    
+    if (!currentLine.isEmpty()) {
+        lines.append(currentLine);
+    }
+    
+    int maxLines = qMax(1, rect.height() / fm.height());
+    if (lines.size() > maxLines) {
+        lines = lines.mid(0, maxLines);
+        QString& lastLine = lines.last();
+        lastLine = fm.elidedText(lastLine, Qt::ElideRight, rect.width());
+    }
+    
+    return lines;
+}
+
+void PreviewCardPainter::drawWrappedText(QPainter& painter, const QString& text, const QRect& rect,
+                                         const QFont& font, const QColor& color)
+{
+    if (text.isEmpty() || rect.isEmpty()) {
+        return;
+    }
+    
+    // Wrapping measures every word; do it once per text, font and box
+    QString key = QString("%1\n%2\n%3x%4").arg(text, font.key()).arg(rect.width()).arg(rect.height());
+    WrappedText* wrapped = textCache().object(key);
+    if (!wrapped) {
+        wrapped = new WrappedText;
+        wrapped->lineHeight = QFontMetrics(font).height();
+        for (const QString& line : wrapText(text, font, rect)) {
+            QStaticText staticLine(line);
+            staticLine.setTextFormat(Qt::PlainText);
+            staticLine.prepare(QTransform(), font);
+            wrapped->lines.append(staticLine);
+        }
+        textCache().insert(key, wrapped, qMax(1, wrapped->lines.size()));
+    }
+    
+    painter.setFont(font);
+    painter.setPen(color);
+    for (int i = 0; i < wrapped->lines.size(); ++i) {
+        painter.drawStaticText(QPointF(rect.x(), rect.y() + i * wrapped->lineHeight), wrapped->lines.at(i));
+    }
+}
+
+QPixmap PreviewCardPainter::cachedPixmap(QPainter& painter, const QString& key, const QSize& size,
+                                         const std::function<void(QPainter&)>& draw)
+{
+    qreal dpr = painter.device() ? painter.device()->devicePixelRatioF() : 1.0;
+    QString fullKey = QString("%1@%2").arg(key).arg(dpr);
+    
+    QPixmap pixmap;
+    if (QPixmapCache::find(fullKey, &pixmap)) {
+        return pixmap;
+    }
+    
+    pixmap = QPixmap(size * dpr);
+    pixmap.setDevicePixelRatio(dpr);
+    pixmap.fill(Qt::transparent);
+    
+    QPainter pixmapPainter(&pixmap);
+    pixmapPainter.setRenderHint(QPainter::Antialiasing);
+    pixmapPainter.setRenderHint(QPainter::TextAntialiasing);
+    draw(pixmapPainter);
+    pixmapPainter.end();
+    
+    QPixmapCache::insert(fullKey, pixmap);
+    return pixmap;
+}
+
+void PreviewCardPainter::drawFrame(QPainter& painter, const QRect& rect, const QColor& background,
+                                   const QColor& borderColor, int borderWidth)
+{
+    if (rect.isEmpty()) {
+        return;
+    }
+    
+    QString key = QString("card-frame:%1x%2:%3:%4:%5")
+                      .arg(rect.width()).arg(rect.height())
+                      .arg(colorKey(background), colorKey(borderColor))
+                      .arg(borderWidth);
+    QPixmap frame = cachedPixmap(painter, key, rect.size(), [&](QPainter& p) {
+        QRect local(QPoint(0, 0), rect.size());
+        p.fillRect(local, background);
+        if (borderColor.isValid() && borderWidth > 0) {
+            p.setPen(QPen(borderColor, borderWidth));
+            p.drawRect(local.adjusted(1, 1, -1, -1));
+        }
+    });
+    painter.drawPixmap(rect.topLeft(), frame);
+}
+
+void PreviewCardPainter::drawPlaceholder(QPainter& painter, const QRect& rect, const QByteArray& placeholder)
+{
+    if (rect.isEmpty()) {
+        return;
+    }
+    
+    qreal aspect = PreviewPlaceholder::aspectRatio(placeholder);
+    if (aspect > 0.0) {
+        QSize size = QSizeF(aspect, 1.0).scaled(QSizeF(rect.size()), Qt::KeepAspectRatio).toSize();
+        if (!size.isEmpty()) {
+            QRect blurRect(rect.x() + (rect.width() - size.width()) / 2,
+                           rect.y() + (rect.height() - size.height()) / 2,
+                           size.width(), size.height());
+            QString key = QString("card-blur:%1:%2x%3")
+                              .arg(QString::fromLatin1(placeholder.toHex()))
+                              .arg(size.width()).arg(size.height());
+            QPixmap blur = cachedPixmap(painter, key, size, [&](QPainter& p) {
+                p.setRenderHint(QPainter::SmoothPixmapTransform);
+                p.drawImage(QRect(QPoint(0, 0), size), PreviewPlaceholder::render(placeholder, size));
+            });
+            painter.drawPixmap(blurRect.topLeft(), blur);
+            return;
+        }
+    }
+    
+    QFont font = painter.font();
+    QString key = QString("card-placeholder:%1x%2:%3").arg(rect.width()).arg(rect.height()).arg(font.key());
+    QPixmap loadingBox = cachedPixmap(painter, key, rect.size(), [&](QPainter& p) {
+        QRect local(QPoint(0, 0), rect.size());
+        p.fillRect(local, QColor(60, 60, 60));
+        p.setFont(font);
+        p.setPen(QColor(120, 120, 120));
+        p.drawText(local, Qt::AlignCenter, "Loading...");
+    });
+    painter.drawPixmap(rect.topLeft(), loadingBox);
+}
+
+void PreviewCardPainter::drawBadge(QPainter& painter, const QRect& rect, const QString& text,
+                                   const QColor& background, const QColor& foreground)
+{
+    if (rect.isEmpty()) {
+        return;
+    }
+    
+    QFont font = painter.font();
+    font.setBold(true);
+    QString key = QString("card-badge:%1x%2:%3:%4:%5:%6")
+                      .arg(rect.width()).arg(rect.height())
+                      .arg(text, colorKey(background), colorKey(foreground), font.key());
+    QPixmap badge = cachedPixmap(painter, key, rect.size(), [&](QPainter& p) {
+        QRect local(QPoint(0, 0), rect.size());
+        p.setPen(Qt::NoPen);
+        p.setBrush(background);
+        p.drawEllipse(local);
+        p.setFont(font);
+        p.setPen(foreground);
+        p.drawText(local, Qt::AlignCenter, text);
+    });
+    painter.drawPixmap(rect.topLeft(), badge);
+}
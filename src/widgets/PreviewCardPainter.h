@@ -0,0 +1,49 @@
+#ifndef PREVIEWCARDPAINTER_H
+#define PREVIEWCARDPAINTER_H
+
+#include <QPainter>
+#include <QPixmap>
+#include <QByteArray>
+#include <QColor>
+#include <QFont>
+#include <QRect>
+#include <QSize>
+#include <QString>
+#include <QStringList>
+#include <functional>
+
+// Shared drawing for the wallpaper and playlist preview cards. Everything that
+// doesn't change between repaints is cached: wrapped and elided text as
+// QStaticText lines per text, font and box, and card frames, placeholders and
+// badges as pixmaps per size, colour and device pixel ratio. A scroll or hover
+// repaint then comes down to a few blits. GUI thread only.
+class PreviewCardPainter
+{
+public:
+    // Word wrapped text, elided on the last line that fits in rect
+    static void drawWrappedText(QPainter& painter, const QString& text, const QRect& rect,
+                                const QFont& font, const QColor& color);
+    
+    // Card background with an optional border; no border if borderColor is invalid
+    static void drawFrame(QPainter& painter, const QRect& rect, const QColor& background,
+                          const QColor& borderColor = QColor(), int borderWidth = 0);
+    
+    // Stand-in shown until the preview is decoded: the blurred placeholder
+    // (see PreviewPlaceholder) fitted into rect like the preview will be, or a
+    // grey "Loading..." box when there is none yet
+    static void drawPlaceholder(QPainter& painter, const QRect& rect,
+                                const QByteArray& placeholder = QByteArray());
+    
+    // Round label with centered bold text, e.g. the playlist position
+    static void drawBadge(QPainter& painter, const QRect& rect, const QString& text,
+                          const QColor& background, const QColor& foreground);
+    
+    // Lines text is broken into for rect, as drawn by drawWrappedText
+    static QStringList wrapText(const QString& text, const QFont& font, const QRect& rect);
+
+private:
+    static QPixmap cachedPixmap(QPainter& painter, const QString& key, const QSize& size,
+                                const std::function<void(QPainter&)>& draw);
+};
+
+#endif // PREVIEWCARDPAINTER_H
@@ -0,0 +1,1323 @@
+#include "WallpaperGridView.h"
+#include "../core/PreviewPixmapCache.h"
+#include "../core/PreviewAnimator.h"
+#include "../core/PreviewLoader.h"
+#include "../core/ThumbnailCache.h"
+#include "../core/AnimatedPreviewCache.h"
+#include "../core/PreviewPlaceholder.h"
+#include "../core/ConfigManager.h"
+#include "PreviewCardPainter.h"
+#include <QPainter>
+#include <QFontMetrics>
+#include <QScrollBar>
+#include <QResizeEvent>
+#include <QKeyEvent>
+#include <QHoverEvent>
+#include <QGuiApplication>
+#include <QDrag>
+#include <QMimeData>
+#include <QDir>
+#include <QFile>
+#include <QFileInfo>
+#include <QStandardPaths>
+#include <QJsonDocument>
+#include <QJsonArray>
+#include <QNetworkRequest>
+#include <QNetworkReply>
+#include <QRegularExpression>
+#include <QTextStream>
+#include <QDateTime>
+#include <QLoggingCategory>
+
+Q_LOGGING_CATEGORY(wallpaperGrid, "app.wallpaperGrid")
+
+// WallpaperGridModel implementation
+WallpaperGridModel::WallpaperGridModel(QObject* parent)
+    : QAbstractListModel(parent)
+    , m_firstVisible(-1)
+    , m_lastVisible(-1)
+    , m_animationsEnabled(true)
+    , m_animationHost(nullptr)
+    , m_hoveredRow(-1)
+    , m_currentRow(-1)
+    , m_prefetchTimer(new QTimer(this))
+    , m_prefetchBytes(0)
+    , m_scrollingUp(false)
+    , m_warmRequest(0)
+    , m_networkManager(new QNetworkAccessManager(this))
+    , m_workshopLoadTimer(new QTimer(this))
+{
+    connect(m_workshopLoadTimer, &QTimer::timeout, this, &WallpaperGridModel::loadWorkshopDataBatch);
+    
+    m_prefetchTimer->setSingleShot(true);
+    connect(m_prefetchTimer, &QTimer::timeout, this, &WallpaperGridModel::prefetchStep);
+    
+    connect(&PreviewAnimator::instance(), &PreviewAnimator::policyChanged, this, &WallpaperGridModel::updateAnimations);
+}
+
+WallpaperGridModel::~WallpaperGridModel()
+{
+    // Hand the shared pixmaps back to the cache
+    for (PreviewState& state : m_previews) {
+        releasePreviewState(state);
+    }
+    cancelWarmStrip();
+}
+
+int WallpaperGridModel::rowCount(const QModelIndex& parent) const
+{
+    return parent.isValid() ? 0 : m_wallpapers.size();
+}
+
+QVariant WallpaperGridModel::data(const QModelIndex& index, int role) const
+{
+    if (!index.isValid() || index.row() < 0 || index.row() >= m_wallpapers.size()) {
+        return QVariant();
+    }
+    
+    const WallpaperInfo& wallpaper = m_wallpapers.at(index.row());
+    switch (role) {
+    case Qt::DisplayRole:
+        return wallpaper.name;
+    case WallpaperIdRole:
+        return wallpaper.id;
+    case AuthorRole:
+        return wallpaper.author;
+    case TypeRole:
+        return wallpaper.type;
+    case PreviewRole: {
+        auto it = m_previews.constFind(wallpaper.id);
+        if (it == m_previews.constEnd()) {
+            return QPixmap();
+        }
+        // A running animation has newer frames than the cached still
+        return it->frame.isNull() ? it->preview : it->frame;
+    }
+    case PlaceholderRole:
+        // Previews first decoded after the scan only have one in the store
+        return wallpaper.previewPlaceholder.isEmpty()
+            ? PreviewPlaceholder::instance().cached(wallpaper.previewPath)
+            : wallpaper.previewPlaceholder;
+    default:
+        return QVariant();
+    }
+}
+
+Qt::ItemFlags WallpaperGridModel::flags(const QModelIndex& index) const
+{
+    if (!index.isValid()) {
+        return Qt::NoItemFlags;
+    }
+    return Qt::ItemIsEnabled | Qt::ItemIsSelectable | Qt::ItemIsDragEnabled;
+}
+
+QStringList WallpaperGridModel::mimeTypes() const
+{
+    return { "application/x-wallpaper-id", "text/plain" };
+}
+
+QMimeData* WallpaperGridModel::mimeData(const QModelIndexList& indexes) const
+{
+    if (indexes.isEmpty() || !indexes.first().isValid()) {
+        return nullptr;
+    }
+    
+    // Set the wallpaper ID as MIME data
+    QString wallpaperId = m_wallpapers.at(indexes.first().row()).id;
+    QMimeData* mimeData = new QMimeData;
+    mimeData->setText(wallpaperId);
+    mimeData->setData("application/x-wallpaper-id", wallpaperId.toUtf8());
+    return mimeData;
+}
+
+void WallpaperGridModel::setWallpapers(const QList<WallpaperInfo>& wallpapers)
+{
+    beginResetModel();
+    
+    for (PreviewState& state : m_previews) {
+        releasePreviewState(state);
+    }
+    m_previews.clear();
+    m_workshopQueue.clear();
+    m_workshopLoadTimer->stop();
+    m_prefetchTimer->stop();
+    m_prefetchRows.clear();
+    m_prefetchId.clear();
+    cancelWarmStrip();
+    
+    m_wallpapers = wallpapers;
+    m_rows.clear();
+    m_rows.reserve(m_wallpapers.size());
+    for (int row = 0; row < m_wallpapers.size(); ++row) {
+        // Workshop metadata fetched earlier in the session still applies
+        auto it = m_workshopData.constFind(m_wallpapers[row].id);
+        if (it != m_workshopData.constEnd()) {
+            m_wallpapers[row] = it.value();
+        }
+        m_rows.insert(m_wallpapers[row].id, row);
+    }
+    
+    m_firstVisible = -1;
+    m_lastVisible = -1;
+    m_hoveredRow = -1;
+    m_currentRow = -1;
+    endResetModel();
+}
+
+bool WallpaperGridModel::reorderWallpapers(const QList<WallpaperInfo>& wallpapers)
+{
+    if (wallpapers.size() != m_wallpapers.size()) {
+        return false;
+    }
+    for (const WallpaperInfo& wallpaper : wallpapers) {
+        if (!m_rows.contains(wallpaper.id)) {
+            return false;
+        }
+    }
+    
+    emit layoutAboutToBeChanged({}, QAbstractItemModel::VerticalSortHint);
+    
+    QModelIndexList from = persistentIndexList();
+    QStringList fromIds;
+    for (const QModelIndex& index : from) {
+        fromIds.append(m_wallpapers.at(index.row()).id);
+    }
+    QString hoveredId = m_hoveredRow >= 0 ? m_wallpapers.at(m_hoveredRow).id : QString();
+    QString currentId = m_currentRow >= 0 ? m_wallpapers.at(m_currentRow).id : QString();
+    
+    m_wallpapers = wallpapers;
+    m_rows.clear();
+    for (int row = 0; row < m_wallpapers.size(); ++row) {
+        auto it = m_workshopData.constFind(m_wallpapers[row].id);
+        if (it != m_workshopData.constEnd()) {
+            m_wallpapers[row] = it.value();
+        }
+        m_rows.insert(m_wallpapers[row].id, row);
+    }
+    
+    QModelIndexList to;
+    for (const QString& wallpaperId : fromIds) {
+        to.append(index(rowOf(wallpaperId)));
+    }
+    changePersistentIndexList(from, to);
+    m_hoveredRow = hoveredId.isEmpty() ? -1 : rowOf(hoveredId);
+    m_currentRow = currentId.isEmpty() ? -1 : rowOf(currentId);
+    
+    // The prefetch plan's rows hold other wallpapers now
+    cancelPrefetch();
+    
+    emit layoutChanged({}, QAbstractItemModel::VerticalSortHint);
+    return true;
+}
+
+int WallpaperGridModel::rowOf(const QString& wallpaperId) const
+{
+    return m_rows.value(wallpaperId, -1);
+}
+
+void WallpaperGridModel::setVisibleRows(int first, int last)
+{
+    // Prefetch ahead in the direction the user is scrolling
+    if (m_firstVisible >= 0 && first != m_firstVisible) {
+        m_scrollingUp = first < m_firstVisible;
+    }
+    m_firstVisible = first;
+    m_lastVisible = last;
+    
+    // Keep one screen above and below warm so short scrolls don't flicker
+    int margin = last >= first ? last - first + 1 : 0;
+    int keepFirst = first - margin;
+    int keepLast = last + margin;
+    
+    for (auto it = m_previews.begin(); it != m_previews.end();) {
+        int row = m_rows.value(it.key(), -1);
+        if (row < 0 || row < keepFirst || row > keepLast) {
+            releasePreviewState(it.value());
+            it = m_previews.erase(it);
+            continue;
+        }
+        
+        // Queued decodes for rows that scrolled off are dropped; painting asks again
+        if ((row < first || row > last) && it->previewRequest != 0) {
+            PreviewPixmapCache::instance().cancel(it->previewRequest);
+            it->previewRequest = 0;
+        }
+        ++it;
+    }
+    
+    updateAnimations();
+    queueWorkshopData();
+    schedulePrefetch();
+}
+
+void WallpaperGridModel::requestPreview(int row)
+{
+    if (row < 0 || row >= m_wallpapers.size()) {
+        return;
+    }
+    
+    const WallpaperInfo& wallpaper = m_wallpapers.at(row);
+    if (wallpaper.previewPath.isEmpty()) {
+        return;
+    }
+    
+    // After the window moved to a screen with another pixel ratio the old
+    // preview stays up until the sharp one is decoded
+    qreal dpr = devicePixelRatio();
+    PreviewState& state = m_previews[wallpaper.id];
+    if ((!state.preview.isNull() && state.preview.devicePixelRatio() == dpr) ||
+        state.previewRequest != 0 || state.previewFailed) {
+        return;
+    }
+    
+    QString wallpaperId = wallpaper.id;
+    QSize previewSize(WallpaperGridDelegate::PREVIEW_WIDTH, WallpaperGridDelegate::PREVIEW_HEIGHT);
+    QString previewKey = PreviewPixmapCache::key(wallpaper.previewPath, previewSize, dpr);
+    quint64 request = PreviewPixmapCache::instance().load(wallpaper.previewPath, previewSize, this,
+        [this, wallpaperId, previewKey](const QPixmap& pixmap) {
+            auto it = m_previews.find(wallpaperId);
+            if (it == m_previews.end()) {
+                if (!pixmap.isNull()) {
+                    PreviewPixmapCache::instance().release(previewKey);
+                }
+                return;
+            }
+            
+            it->previewRequest = 0;
+            if (pixmap.isNull()) {
+                it->previewFailed = true;
+                return;
+            }
+            if (!it->previewKey.isEmpty()) {
+                PreviewPixmapCache::instance().release(it->previewKey);
+            }
+            it->preview = pixmap;
+            it->previewKey = previewKey;
+            notifyPreviewChanged(wallpaperId);
+        }, true, dpr);
+    
+    // A cache hit has already called back and returned 0
+    if (request != 0) {
+        m_previews[wallpaperId].previewRequest = request;
+    }
+}
+
+qreal WallpaperGridModel::devicePixelRatio() const
+{
+    return m_animationHost ? m_animationHost->devicePixelRatioF() : qApp->devicePixelRatio();
+}
+
+void WallpaperGridModel::schedulePrefetch()
+{
+    m_prefetchTimer->stop();
+    m_prefetchRows.clear();
+    m_prefetchId.clear();
+    m_prefetchBytes = 0;
+    
+    if (m_firstVisible < 0 || !ConfigManager::instance().previewPrefetchEnabled()) {
+        return;
+    }
+    
+    // One screen each way, which is also what setVisibleRows keeps around;
+    // the screen the user is heading to goes first
+    int screen = m_lastVisible - m_firstVisible + 1;
+    QList<int> below;
+    for (int row = m_lastVisible + 1; row <= m_lastVisible + screen && row < m_wallpapers.size(); ++row) {
+        below.append(row);
+    }
+    QList<int> above;
+    for (int row = m_firstVisible - 1; row >= m_firstVisible - screen && row >= 0; --row) {
+        above.append(row);
+    }
+    m_prefetchRows = m_scrollingUp ? above + below : below + above;
+    
+    if (!m_prefetchRows.isEmpty()) {
+        m_prefetchTimer->start(PREFETCH_IDLE_DELAY);
+    }
+}
+
+void WallpaperGridModel::cancelPrefetch()
+{
+    if (!m_prefetchId.isEmpty()) {
+        auto it = m_previews.find(m_prefetchId);
+        if (it != m_previews.end() && it->previewRequest != 0) {
+            PreviewPixmapCache::instance().cancel(it->previewRequest);
+            it->previewRequest = 0;
+        }
+    }
+    cancelWarmStrip();
+    schedulePrefetch();
+}
+
+void WallpaperGridModel::prefetchStep()
+{
+    if (!m_prefetchId.isEmpty()) {
+        // Still decoding the previous row
+        auto it = m_previews.constFind(m_prefetchId);
+        if (it != m_previews.constEnd() && it->previewRequest != 0) {
+            m_prefetchTimer->start(PREFETCH_INTERVAL);
+            return;
+        }
+        
+        // Rest in proportion to the work just done to stay within the CPU share
+        m_prefetchId.clear();
+        qint64 rest = m_prefetchClock.elapsed() * (100 - PREFETCH_CPU_SHARE) / PREFETCH_CPU_SHARE;
+        if (rest > PREFETCH_INTERVAL) {
+            m_prefetchTimer->start(int(qMin<qint64>(rest, PREFETCH_IDLE_DELAY)));
+            return;
+        }
+    }
+    
+    // Whatever is on screen, here or in the playlist, decodes first
+    if (PreviewLoader::instance().pendingRequests() > 0) {
+        m_prefetchTimer->start(PREFETCH_IDLE_DELAY);
+        return;
+    }
+    
+    PreviewPixmapCache& cache = PreviewPixmapCache::instance();
+    qreal dpr = devicePixelRatio();
+    qint64 previewBytes = qint64(WallpaperGridDelegate::PREVIEW_WIDTH * dpr) *
+                          qint64(WallpaperGridDelegate::PREVIEW_HEIGHT * dpr) * 4;
+    while (!m_prefetchRows.isEmpty()) {
+        if (m_prefetchBytes + previewBytes > cache.memoryBudget() * PREFETCH_MEMORY_SHARE / 100) {
+            qCDebug(wallpaperGrid) << "Prefetch stopped at its share of the preview memory budget";
+            m_prefetchRows.clear();
+            return;
+        }
+        
+        int row = m_prefetchRows.takeFirst();
+        if (row < 0 || row >= m_wallpapers.size()) {
+            continue;
+        }
+        
+        const WallpaperInfo& wallpaper = m_wallpapers.at(row);
+        const QString& wallpaperId = wallpaper.id;
+        if (!m_workshopData.contains(wallpaperId) && !m_workshopInFlight.contains(wallpaperId) &&
+            !m_workshopQueue.contains(wallpaperId)) {
+            m_workshopQueue.append(wallpaperId);
+            if (!m_workshopLoadTimer->isActive()) {
+                m_workshopLoadTimer->start(WORKSHOP_BATCH_DELAY);
+            }
+        }
+        if (hasAnimatedPreview(wallpaper)) {
+            warmAnimationStrip(wallpaper);
+        }
+        
+        auto it = m_previews.constFind(wallpaperId);
+        if (wallpaper.previewPath.isEmpty() || (it != m_previews.constEnd() && !it->preview.isNull())) {
+            continue;
+        }
+        
+        m_prefetchBytes += previewBytes;
+        m_prefetchClock.start();
+        requestPreview(row);
+        
+        // A memory cache hit is already done; otherwise wait for the decode
+        it = m_previews.constFind(wallpaperId);
+        if (it != m_previews.constEnd() && it->previewRequest != 0) {
+            m_prefetchId = wallpaperId;
+            m_prefetchTimer->start(PREFETCH_INTERVAL);
+            return;
+        }
+    }
+}
+
+void WallpaperGridModel::warmAnimationStrip(const WallpaperInfo& wallpaper)
+{
+    // Strips only help later if they are kept on disk; one at a time, so
+    // the strips of rows coming on screen never queue behind several
+    if (m_warmRequest != 0 || !ThumbnailCache::instance().isEnabled()) {
+        return;
+    }
+    
+    // PreviewAnimator asks for the strip at device pixels; warm the same key
+    QSize previewSize(WallpaperGridDelegate::PREVIEW_WIDTH, WallpaperGridDelegate::PREVIEW_HEIGHT);
+    m_warmRequest = AnimatedPreviewCache::instance().load(wallpaper.previewPath, previewSize * devicePixelRatio(), this,
+        [this](AnimatedPreviewCache::StripPtr) {
+            m_warmRequest = 0;
+        });
+}
+
+void WallpaperGridModel::cancelWarmStrip()
+{
+    if (m_warmRequest != 0) {
+        AnimatedPreviewCache::instance().cancel(m_warmRequest);
+        m_warmRequest = 0;
+    }
+}
+
+void WallpaperGridModel::releasePreviewState(PreviewState& state)
+{
+    if (state.previewRequest != 0) {
+        PreviewPixmapCache::instance().cancel(state.previewRequest);
+        state.previewRequest = 0;
+    }
+    if (!state.previewKey.isEmpty()) {
+        PreviewPixmapCache::instance().release(state.previewKey);
+        state.previewKey.clear();
+    }
+    if (state.animation != 0) {
+        PreviewAnimator::instance().stop(state.animation);
+        state.animation = 0;
+    }
+    state.preview = QPixmap();
+    state.frame = QPixmap();
+}
+
+void WallpaperGridModel::notifyPreviewChanged(const QString& wallpaperId)
+{
+    int row = rowOf(wallpaperId);
+    if (row >= 0) {
+        QModelIndex changed = index(row);
+        emit dataChanged(changed, changed, { PreviewRole });
+    }
+}
+
+void WallpaperGridModel::setAnimationsEnabled(bool enabled)
+{
+    if (m_animationsEnabled == enabled) {
+        return;
+    }
+    
+    m_animationsEnabled = enabled;
+    updateAnimations();
+}
+
+void WallpaperGridModel::setHoveredRow(int row)
+{
+    if (m_hoveredRow != row) {
+        m_hoveredRow = row;
+        if (PreviewAnimator::instance().policy() == PreviewAnimator::Policy::Hover) {
+            updateAnimations();
+        }
+    }
+}
+
+void WallpaperGridModel::setCurrentRow(int row)
+{
+    if (m_currentRow != row) {
+        m_currentRow = row;
+        if (PreviewAnimator::instance().policy() == PreviewAnimator::Policy::Selected) {
+            updateAnimations();
+        }
+    }
+}
+
+bool WallpaperGridModel::shouldAnimate(int row) const
+{
+    return m_animationsEnabled && row >= 0 && row >= m_firstVisible && row <= m_lastVisible &&
+           PreviewAnimator::instance().shouldAnimate(row == m_hoveredRow, row == m_currentRow);
+}
+
+void WallpaperGridModel::updateAnimations()
+{
+    // Only rows on screen that the policy picks animate; everything else shows its still
+    for (auto it = m_previews.begin(); it != m_previews.end(); ++it) {
+        if (!shouldAnimate(m_rows.value(it.key(), -1)) && it->animation != 0) {
+            PreviewAnimator::instance().stop(it->animation);
+            it->animation = 0;
+            it->frame = QPixmap();
+            notifyPreviewChanged(it.key());
+        }
+    }
+    
+    if (!m_animationsEnabled || m_firstVisible < 0) {
+        return;
+    }
+    
+    for (int row = m_firstVisible; row <= m_lastVisible && row < m_wallpapers.size(); ++row) {
+        if (shouldAnimate(row)) {
+            startAnimation(row);
+        }
+    }
+}
+
+void WallpaperGridModel::startAnimation(int row)
+{
+    const WallpaperInfo& wallpaper = m_wallpapers.at(row);
+    if (!m_animationHost || !hasAnimatedPreview(wallpaper)) {
+        return;
+    }
+    
+    PreviewState& state = m_previews[wallpaper.id];
+    if (state.animation != 0) {
+        return;
+    }
+    
+    // Frames arrive already fitted to the preview, on the shared clock
+    QString wallpaperId = wallpaper.id;
+    QSize previewSize(WallpaperGridDelegate::PREVIEW_WIDTH, WallpaperGridDelegate::PREVIEW_HEIGHT);
+    state.animation = PreviewAnimator::instance().start(wallpaper.previewPath, previewSize, m_animationHost,
+        [this, wallpaperId](const QPixmap& frame) {
+            auto it = m_previews.find(wallpaperId);
+            if (it != m_previews.end()) {
+                it->frame = frame;
+                notifyPreviewChanged(wallpaperId);
+            }
+        });
+}
+
+bool WallpaperGridModel::hasAnimatedPreview(const WallpaperInfo& wallpaper)
+{
+    return PreviewAnimator::isAnimatedPreview(wallpaper.previewPath) && QFileInfo::exists(wallpaper.previewPath);
+}
+
+void WallpaperGridModel::queueWorkshopData()
+{
+    // Rows that scrolled away before their turn are simply not fetched
+    m_workshopQueue.clear();
+    
+    if (m_firstVisible >= 0) {
+        for (int row = m_firstVisible; row <= m_lastVisible && row < m_wallpapers.size(); ++row) {
+            const QString& wallpaperId = m_wallpapers.at(row).id;
+            if (!m_workshopData.contains(wallpaperId) && !m_workshopInFlight.contains(wallpaperId)) {
+                m_workshopQueue.append(wallpaperId);
+            }
+        }
+    }
+    
+    if (m_workshopQueue.isEmpty()) {
+        m_workshopLoadTimer->stop();
+    } else if (!m_workshopLoadTimer->isActive()) {
+        m_workshopLoadTimer->start(WORKSHOP_BATCH_DELAY);
+    }
+}
+
+void WallpaperGridModel::loadWorkshopDataBatch()
+{
+    int started = 0;
+    while (!m_workshopQueue.isEmpty() && started < WORKSHOP_BATCH_SIZE) {
+        QString wallpaperId = m_workshopQueue.takeFirst();
+        int row = rowOf(wallpaperId);
+        if (row < 0 || m_workshopData.contains(wallpaperId) || m_workshopInFlight.contains(wallpaperId)) {
+            continue;
+        }
+        
+        loadWorkshopData(m_wallpapers.at(row));
+        ++started;
+    }
+    
+    if (m_workshopQueue.isEmpty()) {
+        m_workshopLoadTimer->stop();
+    }
+}
+
+void WallpaperGridModel::loadWorkshopData(WallpaperInfo wallpaper)
+{
+    m_workshopInFlight.insert(wallpaper.id);
+    
+    QString workshopId = extractWorkshopId(wallpaper);
+    if (!workshopId.isEmpty()) {
+        fetchWorkshopInfoHTTP(wallpaper, workshopId);
+    } else {
+        setFallbackValues(wallpaper);
+    }
+}
+
+QString WallpaperGridModel::extractWorkshopId(const WallpaperInfo& wallpaper)
+{
+    QRegularExpression workshopRegex(R"(/workshop/content/431960/(\d+))");
+    QRegularExpressionMatch match = workshopRegex.match(wallpaper.path);
+    
+    if (match.hasMatch()) {
+        return match.captured(1);
+    }
+    
+    QString dirName = QFileInfo(wallpaper.path).fileName();
+    
+    bool ok;
+    dirName.toULongLong(&ok);
+    if (ok) {
+        return dirName;
+    }
+    
+    return QString();
+}
+
+void WallpaperGridModel::fetchWorkshopInfoHTTP(const WallpaperInfo& wallpaper, const QString& workshopId)
+{
+    QString url = QString("https://api.steampowered.com/ISteamRemoteStorage/GetPublishedFileDetails/v1/");
+    
+    QNetworkRequest request(url);
+    request.setHeader(QNetworkRequest::ContentTypeHeader, "application/x-www-form-urlencoded");
+    request.setHeader(QNetworkRequest::UserAgentHeader, "WallpaperEngineGUI/1.0");
+    
+    QByteArray postData;
+    postData.append("itemcount=1");
+    postData.append("&publishedfileids[0]=");
+    postData.append(workshopId.toUtf8());
+    
+    QNetworkReply* reply = m_networkManager->post(request, postData);
+    
+    connect(reply, &QNetworkReply::finished, this, [this, reply, wallpaper, workshopId]() mutable {
+        if (reply->error() == QNetworkReply::NoError) {
+            QByteArray responseData = reply->readAll();
+            
+            QJsonParseError error;
+            QJsonDocument doc = QJsonDocument::fromJson(responseData, &error);
+            
+            if (error.error == QJsonParseError::NoError) {
+                parseWorkshopDataFromJson(wallpaper, doc.object(), workshopId);
+            } else {
+                qCWarning(wallpaperGrid) << "Failed to parse Steam API response:" << error.errorString();
+                setFallbackValues(wallpaper);
+            }
+        } else {
+            qCWarning(wallpaperGrid) << "Steam API request failed:" << reply->errorString();
+            tryAlternativeWorkshopMethods(wallpaper);
+        }
+        
+        reply->deleteLater();
+    });
+}
+
+void WallpaperGridModel::parseWorkshopDataFromJson(WallpaperInfo& wallpaper, const QJsonObject& response, const QString& workshopId)
+{
+    QJsonObject responseObj = response.value("response").toObject();
+    QJsonArray publishedFileDetails = responseObj.value("publishedfiledetails").toArray();
+    
+    if (publishedFileDetails.isEmpty()) {
+        qCWarning(wallpaperGrid) << "No published file details found for workshop ID:" << workshopId;
+        setFallbackValues(wallpaper);
+        return;
+    }
+    
+    QJsonObject fileDetails = publishedFileDetails.first().toObject();
+    
+    QString title = fileDetails.value("title").toString();
+    if (!title.isEmpty()) {
+        wallpaper.name = title;
+        qCDebug(wallpaperGrid) << "Updated wallpaper name from Steam API:" << title;
+    }
+    
+    QString description = fileDetails.value("description").toString();
+    if (!description.isEmpty()) {
+        description = cleanBBCode(description);
+        wallpaper.description = description;
+        qCDebug(wallpaperGrid) << "Found description from Steam API:" << description.left(50) << "...";
+    }
+    
+    qint64 fileSize = fileDetails.value("file_size").toVariant().toLongLong();
+    if (fileSize > 0) {
+        wallpaper.fileSize = fileSize;
+        qCDebug(wallpaperGrid) << "Found file size from Steam API:" << fileSize << "bytes";
+    }
+    
+    qint64 timeCreated = fileDetails.value("time_created").toVariant().toLongLong();
+    qint64 timeUpdated = fileDetails.value("time_updated").toVariant().toLongLong();
+    
+    if (timeCreated > 0) {
+        wallpaper.created = QDateTime::fromSecsSinceEpoch(timeCreated);
+        qCDebug(wallpaperGrid) << "Created:" << wallpaper.created.toString("dd MMM, yyyy @ h:mmap");
+    }
+    
+    if (timeUpdated > 0) {
+        wallpaper.updated = QDateTime::fromSecsSinceEpoch(timeUpdated);
+        qCDebug(wallpaperGrid) << "Updated:" << wallpaper.updated.toString("dd MMM, yyyy @ h:mmap");
+    }
+    
+    QJsonArray tagsArray = fileDetails.value("tags").toArray();
+    QStringList tags;
+    QString type;
+    
+    for (const QJsonValue& tagValue : tagsArray) {
+        QJsonObject tagObj = tagValue.toObject();
+        QString tag = tagObj.value("tag").toString();
+        if (!tag.isEmpty()) {
+            tags.append(tag);
+            
+            if (tag == "Scene" || tag == "Video" || tag == "Web") {
+                type = tag;
+            }
+        }
+    }
+    
+    if (!tags.isEmpty()) {
+        wallpaper.tags = tags;
+        qCDebug(wallpaperGrid) << "Found tags from Steam API:" << tags;
+    }
+    
+    if (!type.isEmpty()) {
+        wallpaper.type = type;
+        qCDebug(wallpaperGrid) << "Updated type from tags:" << type;
+    }
+    
+    QString creatorSteamId = fileDetails.value("creator").toString();
+    if (!creatorSteamId.isEmpty()) {
+        QString localUsername = getUsernameFromLocalSteamData(creatorSteamId);
+        if (!localUsername.isEmpty()) {
+            wallpaper.author = localUsername;
+            qCDebug(wallpaperGrid) << "Found username from local Steam data:" << localUsername;
+        } else {
+            wallpaper.author = QString("Steam User %1").arg(creatorSteamId.right(8));
+            qCDebug(wallpaperGrid) << "Using Steam ID fallback:" << wallpaper.author;
+        }
+    }
+    
+    emit workshopDataLoaded(wallpaper);
+    finishWorkshopData(wallpaper);
+}
+
+QString WallpaperGridModel::getUsernameFromLocalSteamData(const QString& steamId)
+{
+    QStringList steamCachePaths = {
+        QStandardPaths::writableLocation(QStandardPaths::HomeLocation) + "/.steam/steam",
+        QStandardPaths::writableLocation(QStandardPaths::HomeLocation) + "/.local/share/Steam",
+        QStandardPaths::writableLocation(QStandardPaths::HomeLocation) + "/.var/app/com.valvesoftware.Steam/.local/share/Steam"
+    };
+    
+    for (const QString& steamPath : steamCachePaths) {
+        QString userDataPath = QDir(steamPath).filePath("userdata");
+        QDir userDataDir(userDataPath);
+        
+        if (userDataDir.exists()) {
+            QStringList userDirs = userDataDir.entryList(QDir::Dirs | QDir::NoDotAndDotDot);
+            for (const QString& userDir : userDirs) {
+                QString configPath = userDataDir.filePath(userDir + "/config/localconfig.vdf");
+                if (QFileInfo::exists(configPath)) {
+                    QString username = extractUsernameFromVdf(configPath, steamId);
+                    if (!username.isEmpty()) {
+                        return username;
+                    }
+                }
+            }
+        }
+        
+        QString loginUsersPath = QDir(steamPath).filePath("config/loginusers.vdf");
+        if (QFileInfo::exists(loginUsersPath)) {
+            QString username = extractUsernameFromLoginUsers(loginUsersPath, steamId);
+            if (!username.isEmpty()) {
+                return username;
+            }
+        }
+    }
+    
+    return QString();
+}
+
+QString WallpaperGridModel::extractUsernameFromVdf(const QString& vdfPath, const QString& steamId)
+{
+    QFile file(vdfPath);
+    if (!file.open(QIODevice::ReadOnly | QIODevice::Text)) {
+        return QString();
+    }
+    
+    QTextStream in(&file);
+    QString content = in.readAll();
+    
+    QRegularExpression steamIdRegex(QString("\"76561[0-9]{12}\"\\s*\\{[^}]*\"PersonaName\"\\s*\"([^\"]+)\""));
+    QRegularExpressionMatchIterator matches = steamIdRegex.globalMatch(content);
+    
+    while (matches.hasNext()) {
+        QRegularExpressionMatch match = matches.next();
+        if (match.captured(0).contains(steamId)) {
+            return match.captured(1);
+        }
+    }
+    
+    return QString();
+}
+
+QString WallpaperGridModel::extractUsernameFromLoginUsers(const QString& loginUsersPath, const QString& steamId)
+{
+    QFile file(loginUsersPath);
+    if (!file.open(QIODevice::ReadOnly | QIODevice::Text)) {
+        return QString();
+    }
+    
+    QTextStream in(&file);
+    QString content = in.readAll();
+    
+    QRegularExpression userBlockRegex(QString("\"%1\"\\s*\\{([^}]+)\\}").arg(steamId));
+    QRegularExpressionMatch userMatch = userBlockRegex.match(content);
+    
+    if (userMatch.hasMatch()) {
+        QString userBlock = userMatch.captured(1);
+        QRegularExpression nameRegex("\"PersonaName\"\\s*\"([^\"]+)\"");
+        QRegularExpressionMatch nameMatch = nameRegex.match(userBlock);
+        
+        if (nameMatch.hasMatch()) {
+            return nameMatch.captured(1);
+        }
+    }
+    
+    return QString();
+}
+
+QString WallpaperGridModel::cleanBBCode(const QString& text)
+{
+    QString cleaned = text;
+    
+    QStringList bbcodeTags = {
+        "\\[b\\]", "\\[/b\\]",
+        "\\[i\\]", "\\[/i\\]",
+        "\\[u\\]", "\\[/u\\]",
+        "\\[h1\\]", "\\[/h1\\]",
+        "\\[quote\\]", "\\[/quote\\]",
+        "\\[code\\]", "\\[/code\\]",
+        "\\[list\\]", "\\[/list\\]",
+        "\\[\\*\\]",
+        "\\[hr\\]", "\\[/hr\\]",
+        "\\[img\\]", "\\[/img\\]"
+    };
+    
+    for (const QString& tag : bbcodeTags) {
+        QRegularExpression regex(tag, QRegularExpression::CaseInsensitiveOption);
+        cleaned = cleaned.replace(regex, "");
+    }
+    
+    QRegularExpression urlRegex("\\[url=[^\\]]*\\]([^\\[]*)\\[/url\\]", QRegularExpression::CaseInsensitiveOption);
+    cleaned = cleaned.replace(urlRegex, "\\1");
+    
+    QRegularExpression simpleUrlRegex("\\[url\\]([^\\[]*)\\[/url\\]", QRegularExpression::CaseInsensitiveOption);
+    cleaned = cleaned.replace(simpleUrlRegex, "\\1");
+    
+    cleaned = cleaned.replace(QRegularExpression("\\s+"), " ");
+    cleaned = cleaned.trimmed();
+    
+    return cleaned;
+}
+
+void WallpaperGridModel::tryAlternativeWorkshopMethods(WallpaperInfo& wallpaper)
+{
+    parseWorkshopDataFromFilesystem(wallpaper);
+    tryLoadFromSteamCache(wallpaper);
+    emit workshopDataLoaded(wallpaper);
+    finishWorkshopData(wallpaper);
+}
+
+void WallpaperGridModel::parseWorkshopDataFromFilesystem(WallpaperInfo& wallpaper)
+{
+    qCDebug(wallpaperGrid) << "parseWorkshopDataFromFilesystem called for wallpaper:" << wallpaper.name;
+    
+    QString workshopMetaPath = QDir(wallpaper.path).filePath(".workshop_metadata.json");
+    
+    if (QFileInfo::exists(workshopMetaPath)) {
+        QFile file(workshopMetaPath);
+        if (file.open(QIODevice::ReadOnly)) {
+            QJsonParseError error;
+            QJsonDocument doc = QJsonDocument::fromJson(file.readAll(), &error);
+            
+            if (error.error == QJsonParseError::NoError) {
+                QJsonObject metadata = doc.object();
+                
+                if (wallpaper.author.isEmpty()) {
+                    wallpaper.author = metadata.value("author").toString();
+                    qCDebug(wallpaperGrid) << "Found author in filesystem metadata:" << wallpaper.author;
+                }
+                
+                if (wallpaper.description.isEmpty()) {
+                    wallpaper.description = metadata.value("description").toString();
+                    qCDebug(wallpaperGrid) << "Found description in filesystem metadata";
+                }
+                
+                if (wallpaper.tags.isEmpty()) {
+                    QJsonArray tagsArray = metadata.value("tags").toArray();
+                    for (const QJsonValue& tag : tagsArray) {
+                        wallpaper.tags.append(tag.toString());
+                    }
+                }
+            }
+        }
+    }
+    
+    QString projectPath = QDir(wallpaper.path).filePath("project.json");
+    if (QFileInfo::exists(projectPath)) {
+        QFile file(projectPath);
+        if (file.open(QIODevice::ReadOnly)) {
+            QJsonParseError error;
+            QJsonDocument doc = QJsonDocument::fromJson(file.readAll(), &error);
+            
+            if (error.error == QJsonParseError::NoError) {
+                QJsonObject project = doc.object();
+                QJsonObject generalObj = project.value("general").toObject();
+                
+                if (wallpaper.author.isEmpty()) {
+                    wallpaper.author = project.value("author").toString();
+                    if (wallpaper.author.isEmpty()) {
+                        wallpaper.author = generalObj.value("author").toString();
+                    }
+                }
+                
+                if (wallpaper.description.isEmpty()) {
+                    wallpaper.description = project.value("description").toString();
+                }
+            }
+        }
+    }
+}
+
+void WallpaperGridModel::tryLoadFromSteamCache(WallpaperInfo& wallpaper)
+{
+    qCDebug(wallpaperGrid) << "tryLoadFromSteamCache called for wallpaper:" << wallpaper.name;
+    
+    QString workshopId = extractWorkshopId(wallpaper);
+    if (workshopId.isEmpty()) {
+        qCDebug(wallpaperGrid) << "No workshop ID found, cannot load from Steam cache";
+        return;
+    }
+    
+    QStringList steamCachePaths = {
+        QStandardPaths::writableLocation(QStandardPaths::HomeLocation) + "/.steam/steam/appcache/workshop",
+        QStandardPaths::writableLocation(QStandardPaths::HomeLocation) + "/.local/share/Steam/appcache/workshop",
+        QStandardPaths::writableLocation(QStandardPaths::HomeLocation) + "/.var/app/com.valvesoftware.Steam/.local/share/Steam/appcache/workshop"
+    };
+    
+    for (const QString& cachePath : steamCachePaths) {
+        QString metaFile = QDir(cachePath).filePath(QString("431960_%1.meta").arg(workshopId));
+        
+        if (QFileInfo::exists(metaFile)) {
+            qCDebug(wallpaperGrid) << "Found Steam cache file:" << metaFile;
+            
+            QFile file(metaFile);
+            if (file.open(QIODevice::ReadOnly)) {
+                QByteArray data = file.readAll();
+                QString content = QString::fromUtf8(data);
+                
+                QRegularExpression authorRegex("\"creator\"\\s*\"([^\"]+)\"");
+                QRegularExpressionMatch match = authorRegex.match(content);
+                if (match.hasMatch() && wallpaper.author.isEmpty()) {
+                    QString creator = match.captured(1);
+                    if (creator.length() > 10 && creator.toULongLong() > 0) {
+                        wallpaper.author = QString("Steam User %1").arg(creator.right(8));
+                    } else {
+                        wallpaper.author = creator;
+                    }
+                    qCDebug(wallpaperGrid) << "Found author in Steam cache:" << wallpaper.author;
+                }
+                
+                QRegularExpression titleRegex("\"title\"\\s*\"([^\"]+)\"");
+                match = titleRegex.match(content);
+                if (match.hasMatch() && wallpaper.name.isEmpty()) {
+                    wallpaper.name = match.captured(1);
+                    qCDebug(wallpaperGrid) << "Found title in Steam cache:" << wallpaper.name;
+                }
+                
+                QRegularExpression descRegex("\"description\"\\s*\"([^\"]+)\"");
+                match = descRegex.match(content);
+                if (match.hasMatch() && wallpaper.description.isEmpty()) {
+                    QString description = match.captured(1);
+                    description = description.replace("\\n", "\n").replace("\\t", "\t");
+                    wallpaper.description = description;
+                    qCDebug(wallpaperGrid) << "Found description in Steam cache";
+                }
+                
+                break;
+            }
+        }
+    }
+}
+
+void WallpaperGridModel::setFallbackValues(WallpaperInfo& wallpaper)
+{
+    if (wallpaper.author.isEmpty()) {
+        wallpaper.author = "Unknown Author";
+    }
+    
+    if (wallpaper.description.isEmpty()) {
+        wallpaper.description = "No description available";
+    }
+    
+    finishWorkshopData(wallpaper);
+}
+
+void WallpaperGridModel::setPreviewPath(const QString& wallpaperId, const QString& previewPath)
+{
+    // Metadata fetched earlier is reapplied on every reset; keep it current too
+    auto cached = m_workshopData.find(wallpaperId);
+    if (cached != m_workshopData.end()) {
+        cached->previewPath = previewPath;
+    }
+    
+    int row = rowOf(wallpaperId);
+    if (row < 0) {
+        return;
+    }
+    
+    m_wallpapers[row].previewPath = previewPath;
+    auto it = m_previews.find(wallpaperId);
+    if (it != m_previews.end()) {
+        releasePreviewState(it.value());
+        m_previews.erase(it);
+    }
+    
+    // Repainting the card requests the new preview if it is on screen
+    notifyPreviewChanged(wallpaperId);
+}
+
+void WallpaperGridModel::finishWorkshopData(const WallpaperInfo& wallpaper)
+{
+    m_workshopInFlight.remove(wallpaper.id);
+    
+    // A preview generated while the fetch was running is newer than its copy
+    WallpaperInfo updated = wallpaper;
+    int row = rowOf(wallpaper.id);
+    if (row >= 0) {
+        updated.previewPath = m_wallpapers[row].previewPath;
+    }
+    m_workshopData.insert(wallpaper.id, updated);
+    
+    if (row >= 0) {
+        m_wallpapers[row] = updated;
+        QModelIndex changed = index(row);
+        emit dataChanged(changed, changed);
+    }
+}
+
+// WallpaperGridDelegate implementation
+WallpaperGridDelegate::WallpaperGridDelegate(WallpaperGridModel* model, QObject* parent)
+    : QStyledItemDelegate(parent)
+    , m_model(model)
+{
+}
+
+QSize WallpaperGridDelegate::sizeHint(const QStyleOptionViewItem& option, const QModelIndex& index) const
+{
+    Q_UNUSED(option)
+    Q_UNUSED(index)
+    // Same footprint the item widgets had
+    return QSize(ITEM_WIDTH, ITEM_HEIGHT + 20);
+}
+
+void WallpaperGridDelegate::paint(QPainter* painter, const QStyleOptionViewItem& option, const QModelIndex& index) const
+{
+    if (!index.isValid() || option.rect.isEmpty()) {
+        return;
+    }
+    
+    // Only cells that actually get painted, i.e. are scrolled into view, decode
+    QPixmap preview = index.data(WallpaperGridModel::PreviewRole).value<QPixmap>();
+    if (preview.isNull() || preview.devicePixelRatio() != painter->device()->devicePixelRatioF()) {
+        m_model->requestPreview(index.row());
+        preview = index.data(WallpaperGridModel::PreviewRole).value<QPixmap>();
+    }
+    
+    painter->save();
+    painter->translate(option.rect.topLeft());
+    painter->setRenderHint(QPainter::Antialiasing);
+    painter->setRenderHint(QPainter::TextAntialiasing);
+    
+    const QPalette& palette = option.palette;
+    QRect rect(QPoint(0, 0), option.rect.size());
+    bool selected = option.state & QStyle::State_Selected;
+    bool hovered = option.state & QStyle::State_MouseOver;
+    
+    if (selected) {
+        PreviewCardPainter::drawFrame(*painter, rect, palette.color(QPalette::Highlight),
+                                      palette.color(QPalette::Highlight), 2);
+    } else if (hovered) {
+        PreviewCardPainter::drawFrame(*painter, rect, palette.color(QPalette::Base),
+                                      palette.color(QPalette::Midlight), 2);
+    } else {
+        PreviewCardPainter::drawFrame(*painter, rect, palette.color(QPalette::Base));
+    }
+    
+    int availableWidth = rect.width() - 2 * PREVIEW_CONTAINER_MARGIN;
+    int availableHeight = rect.height() - 2 * PREVIEW_CONTAINER_MARGIN;
+    int previewHeight = qMin(PREVIEW_HEIGHT, availableHeight - TEXT_AREA_HEIGHT);
+    int previewWidth = qMin(PREVIEW_WIDTH, availableWidth);
+    QRect previewRect(PREVIEW_CONTAINER_MARGIN, PREVIEW_CONTAINER_MARGIN, previewWidth, previewHeight);
+    
+    if (!preview.isNull()) {
+        // Previews are decoded at the screen's pixel ratio, so this is a plain blit
+        QRect imageRect = previewRect;
+        QSize previewSize = preview.deviceIndependentSize().toSize();
+        if (previewSize != previewRect.size()) {
+            QSize scaledSize = previewSize.scaled(previewRect.size(), Qt::KeepAspectRatio);
+            imageRect = QRect(
+                previewRect.x() + (previewRect.width() - scaledSize.width()) / 2,
+                previewRect.y() + (previewRect.height() - scaledSize.height()) / 2,
+                scaledSize.width(),
+                scaledSize.height()
+            );
+        }
+        
+        painter->drawPixmap(imageRect, preview);
+    } else {
+        painter->setFont(option.font);
+        PreviewCardPainter::drawPlaceholder(*painter, previewRect,
+                                            index.data(WallpaperGridModel::PlaceholderRole).toByteArray());
+    }
+    
+    int textY = PREVIEW_CONTAINER_MARGIN + previewHeight + TEXT_MARGIN;
+    int maxTextWidth = availableWidth - TEXT_MARGIN;
+    int maxTextHeight = rect.height() - textY - TEXT_MARGIN;
+    
+    if (maxTextWidth > 0 && maxTextHeight > 0) {
+        QRect textRect = QRect(PREVIEW_CONTAINER_MARGIN + TEXT_MARGIN/2, textY, maxTextWidth, maxTextHeight);
+        
+        QFont nameFont = option.font;
+        nameFont.setBold(true);
+        nameFont.setPointSize(qMax(8, option.font.pointSize()));
+        
+        QString name = index.data(Qt::DisplayRole).toString();
+        QString displayName = name.isEmpty() ? "Unknown" : name;
+        
+        QFontMetrics nameFm(nameFont);
+        int nameLineHeight = nameFm.height();
+        int maxNameLines = qMax(1, qMin(3, maxTextHeight / nameLineHeight - 2));
+        
+        QRect nameRect = QRect(textRect.x(), textRect.y(), textRect.width(), nameLineHeight * maxNameLines);
+        PreviewCardPainter::drawWrappedText(*painter, displayName, nameRect, nameFont, palette.color(QPalette::Text));
+        
+        QFont infoFont = option.font;
+        infoFont.setPointSize(qMax(7, option.font.pointSize() - 1));
+        
+        int infoY = nameRect.bottom() + TEXT_MARGIN/2;
+        QRect infoRect = QRect(textRect.x(), infoY, textRect.width(), textRect.bottom() - infoY);
+        
+        if (infoRect.height() > 0) {
+            QString author = index.data(WallpaperGridModel::AuthorRole).toString();
+            QString type = index.data(WallpaperGridModel::TypeRole).toString();
+            
+            QStringList infoLines;
+            if (!author.isEmpty()) {
+                infoLines << QString("By: %1").arg(author);
+            }
+            if (!type.isEmpty()) {
+                infoLines << QString("Type: %1").arg(type);
+            }
+            
+            QString infoText = infoLines.join(" • ");
+            if (!infoText.isEmpty()) {
+                PreviewCardPainter::drawWrappedText(*painter, infoText, infoRect, infoFont, palette.color(QPalette::Mid));
+            }
+        }
+    }
+    
+    painter->restore();
+}
+
+// WallpaperGridView implementation
+WallpaperGridView::WallpaperGridView(QWidget* parent)
+    : QListView(parent)
+    , m_model(new WallpaperGridModel(this))
+    , m_viewportTimer(new QTimer(this))
+{
+    setModel(m_model);
+    setItemDelegate(new WallpaperGridDelegate(m_model, this));
+    m_model->setAnimationHost(viewport());
+    
+    // Fixed size cells let the view place any row without measuring the others
+    setViewMode(QListView::IconMode);
+    setFlow(QListView::LeftToRight);
+    setWrapping(true);
+    setResizeMode(QListView::Adjust);
+    setMovement(QListView::Static);
+    setUniformItemSizes(true);
+    setGridSize(QSize(WallpaperGridDelegate::ITEM_WIDTH + ITEM_SPACING,
+                      WallpaperGridDelegate::ITEM_HEIGHT + 20 + ITEM_SPACING));
+    setSelectionMode(QAbstractItemView::SingleSelection);
+    setVerticalScrollMode(QAbstractItemView::ScrollPerPixel);
+    verticalScrollBar()->setSingleStep(WallpaperGridDelegate::TEXT_LINE_HEIGHT * 3);
+    
+    setDragEnabled(true);
+    setDragDropMode(QAbstractItemView::DragOnly);
+    setDefaultDropAction(Qt::CopyAction);
+    setContextMenuPolicy(Qt::CustomContextMenu);
+    
+    // Hover only repaints the two cells involved; their frames are cached
+    setMouseTracking(true);
+    viewport()->setAttribute(Qt::WA_Hover);
+    
+    // The current row is what the "selected" animation policy plays
+    connect(selectionModel(), &QItemSelectionModel::currentChanged, this, [this](const QModelIndex& current) {
+        m_model->setCurrentRow(current.isValid() ? current.row() : -1);
+    });
+    
+    // Hand the visible range to the model once scrolling settles
+    m_viewportTimer->setSingleShot(true);
+    m_viewportTimer->setInterval(50);
+    connect(m_viewportTimer, &QTimer::timeout, this, &WallpaperGridView::updateVisibleRows);
+    connect(verticalScrollBar(), &QScrollBar::valueChanged, m_viewportTimer, QOverload<>::of(&QTimer::start));
+    connect(m_model, &QAbstractItemModel::modelReset, m_viewportTimer, QOverload<>::of(&QTimer::start));
+    connect(m_model, &QAbstractItemModel::layoutChanged, m_viewportTimer, QOverload<>::of(&QTimer::start));
+}
+
+void WallpaperGridView::resizeEvent(QResizeEvent* event)
+{
+    QListView::resizeEvent(event);
+    m_viewportTimer->start();
+}
+
+bool WallpaperGridView::viewportEvent(QEvent* event)
+{
+    // Any input takes the CPU back from prefetching straight away
+    switch (event->type()) {
+    case QEvent::Wheel:
+    case QEvent::MouseButtonPress:
+    case QEvent::TouchBegin:
+        m_model->cancelPrefetch();
+        break;
+    case QEvent::HoverEnter:
+    case QEvent::HoverMove:
+        m_model->setHoveredRow(indexAt(static_cast<QHoverEvent*>(event)->position().toPoint()).row());
+        break;
+    case QEvent::HoverLeave:
+        m_model->setHoveredRow(-1);
+        break;
+    default:
+        break;
+    }
+    return QListView::viewportEvent(event);
+}
+
+void WallpaperGridView::keyPressEvent(QKeyEvent* event)
+{
+    m_model->cancelPrefetch();
+    QListView::keyPressEvent(event);
+}
+
+void WallpaperGridView::updateVisibleRows()
+{
+    int count = m_model->rowCount();
+    QSize cell = gridSize();
+    if (count == 0 || cell.isEmpty()) {
+        m_model->setVisibleRows(-1, -1);
+        return;
+    }
+    
+    // Cells sit on a fixed grid, so the visible range is plain arithmetic
+    int columns = qMax(1, viewport()->width() / cell.width());
+    int top = verticalScrollBar()->value();
+    int first = (top / cell.height()) * columns;
+    int last = ((top + viewport()->height()) / cell.height() + 1) * columns - 1;
+    
+    m_model->setVisibleRows(qBound(0, first, count - 1), qBound(0, last, count - 1));
+}
+
+void WallpaperGridView::startDrag(Qt::DropActions supportedActions)
+{
+    Q_UNUSED(supportedActions)
+    
+    QModelIndex index = currentIndex();
+    QMimeData* mimeData = index.isValid() ? m_model->mimeData({ index }) : nullptr;
+    if (!mimeData) {
+        return;
+    }
+    
+    qCDebug(wallpaperGrid) << "Starting drag operation for wallpaper:" << index.data().toString()
+                           << "with ID:" << mimeData->text();
+    
+    QDrag* drag = new QDrag(this);
+    drag->setMimeData(mimeData);
+    
+    // Create a drag pixmap from the preview
+    QPixmap preview = index.data(WallpaperGridModel::PreviewRole).value<QPixmap>();
+    QPixmap dragPixmap;
+    if (!preview.isNull()) {
+        // Keep the preview's pixel ratio so the drag image stays 64 logical pixels
+        dragPixmap = preview.scaled(QSize(64, 64) * preview.devicePixelRatio(), Qt::KeepAspectRatio, Qt::SmoothTransformation);
+        dragPixmap.setDevicePixelRatio(preview.devicePixelRatio());
+    } else {
+        dragPixmap = QPixmap(64, 64);
+        dragPixmap.fill(Qt::gray);
+    }
+    
+    drag->setPixmap(dragPixmap);
+    QSize dragSize = dragPixmap.deviceIndependentSize().toSize();
+    drag->setHotSpot(QPoint(dragSize.width() / 2, dragSize.height() / 2));
+    
+    Qt::DropAction dropAction = drag->exec(Qt::CopyAction);
+    qCDebug(wallpaperGrid) << "Drag completed with action:" << dropAction;
+}
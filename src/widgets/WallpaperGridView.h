@@ -0,0 +1,213 @@
+#ifndef WALLPAPERGRIDVIEW_H
+#define WALLPAPERGRIDVIEW_H
+
+#include <QAbstractListModel>
+#include <QStyledItemDelegate>
+#include <QListView>
+#include <QNetworkAccessManager>
+#include <QPixmap>
+#include <QHash>
+#include <QSet>
+#include <QStringList>
+#include <QTimer>
+#include <QElapsedTimer>
+#include <QJsonObject>
+#include "../core/WallpaperManager.h"
+
+// Flat list of the filtered library for the wallpaper grid. The whole library
+// is held as plain WallpaperInfo rows; previews, animations and workshop
+// metadata requests only exist for the rows around the viewport, so memory
+// follows what is on screen rather than the size of the library.
+class WallpaperGridModel : public QAbstractListModel
+{
+    Q_OBJECT
+
+public:
+    enum Roles {
+        WallpaperIdRole = Qt::UserRole + 1,
+        AuthorRole,
+        TypeRole,
+        PreviewRole,    // QPixmap, null until decoded
+        PlaceholderRole // QByteArray, see PreviewPlaceholder; empty if not made yet
+    };
+    
+    explicit WallpaperGridModel(QObject* parent = nullptr);
+    ~WallpaperGridModel() override;
+    
+    int rowCount(const QModelIndex& parent = QModelIndex()) const override;
+    QVariant data(const QModelIndex& index, int role = Qt::DisplayRole) const override;
+    Qt::ItemFlags flags(const QModelIndex& index) const override;
+    QStringList mimeTypes() const override;
+    QMimeData* mimeData(const QModelIndexList& indexes) const override;
+    
+    void setWallpapers(const QList<WallpaperInfo>& wallpapers);
+    // The same wallpapers in another order, or with new details, moved in
+    // place so selection, current item and scroll position stay. False, and
+    // nothing changed, if the wallpapers aren't the ones already shown
+    bool reorderWallpapers(const QList<WallpaperInfo>& wallpapers);
+    const WallpaperInfo& wallpaperAt(int row) const { return m_wallpapers.at(row); }
+    int rowOf(const QString& wallpaperId) const;
+    // Shows a preview that appeared after the scan, e.g. a generated one
+    void setPreviewPath(const QString& wallpaperId, const QString& previewPath);
+    
+    // Rows first..last are on screen. Everything outside a screen's worth of
+    // margin drops its preview reference, pending decode and animation
+    void setVisibleRows(int first, int last);
+    
+    // Called while painting, so only rows that are actually drawn decode
+    void requestPreview(int row);
+    
+    // Drops in-flight prefetch work; it starts over once input is quiet again
+    void cancelPrefetch();
+    
+    // Animated previews play through PreviewAnimator while host is on screen;
+    // previews are decoded at the host's device pixel ratio
+    void setAnimationHost(QWidget* host) { m_animationHost = host; }
+    qreal devicePixelRatio() const;
+    void setAnimationsEnabled(bool enabled);
+    bool animationsEnabled() const { return m_animationsEnabled; }
+    
+    // Inputs to PreviewAnimator's hover and selected policies; -1 for none
+    void setHoveredRow(int row);
+    void setCurrentRow(int row);
+    
+    // Workshop batch processing constants
+    static constexpr int WORKSHOP_BATCH_SIZE = 3;
+    static constexpr int WORKSHOP_BATCH_DELAY = 200;
+    
+    // Idle prefetch of the next screen: starts this long after the last input,
+    // keeps decoding to this share of one core and to this share of the
+    // preview memory budget
+    static constexpr int PREFETCH_IDLE_DELAY = 500;
+    static constexpr int PREFETCH_INTERVAL = 20;
+    static constexpr int PREFETCH_CPU_SHARE = 25;
+    static constexpr int PREFETCH_MEMORY_SHARE = 25;
+
+signals:
+    // Metadata found on the workshop or in Steam's files, not fallback values
+    void workshopDataLoaded(const WallpaperInfo& wallpaper);
+
+private slots:
+    void loadWorkshopDataBatch();
+    void prefetchStep();
+    void updateAnimations();
+
+private:
+    struct PreviewState {
+        QPixmap preview;
+        QString previewKey;     // reference held in PreviewPixmapCache
+        quint64 previewRequest = 0;
+        bool previewFailed = false;
+        quint64 animation = 0;  // PreviewAnimator id
+        QPixmap frame;          // latest animation frame, fitted to the preview
+    };
+    
+    void releasePreviewState(PreviewState& state);
+    void notifyPreviewChanged(const QString& wallpaperId);
+    bool shouldAnimate(int row) const;
+    void startAnimation(int row);
+    static bool hasAnimatedPreview(const WallpaperInfo& wallpaper);
+    
+    void schedulePrefetch();
+    void warmAnimationStrip(const WallpaperInfo& wallpaper);
+    // Input came back, or the rows changed; the strip is no longer next
+    void cancelWarmStrip();
+    
+    // Workshop metadata, fetched for visible rows and kept for the session
+    void queueWorkshopData();
+    void loadWorkshopData(WallpaperInfo wallpaper);
+    void fetchWorkshopInfoHTTP(const WallpaperInfo& wallpaper, const QString& workshopId);
+    void parseWorkshopDataFromJson(WallpaperInfo& wallpaper, const QJsonObject& response, const QString& workshopId);
+    void tryAlternativeWorkshopMethods(WallpaperInfo& wallpaper);
+    void parseWorkshopDataFromFilesystem(WallpaperInfo& wallpaper);
+    void tryLoadFromSteamCache(WallpaperInfo& wallpaper);
+    void setFallbackValues(WallpaperInfo& wallpaper);
+    void finishWorkshopData(const WallpaperInfo& wallpaper);
+    static QString extractWorkshopId(const WallpaperInfo& wallpaper);
+    static QString getUsernameFromLocalSteamData(const QString& steamId);
+    static QString extractUsernameFromVdf(const QString& vdfPath, const QString& steamId);
+    static QString extractUsernameFromLoginUsers(const QString& loginUsersPath, const QString& steamId);
+    static QString cleanBBCode(const QString& text);
+    
+    QList<WallpaperInfo> m_wallpapers;
+    QHash<QString, int> m_rows;                 // wallpaper id -> row
+    QHash<QString, PreviewState> m_previews;    // rows near the viewport only
+    int m_firstVisible;
+    int m_lastVisible;
+    bool m_animationsEnabled;
+    QWidget* m_animationHost;
+    int m_hoveredRow;
+    int m_currentRow;
+    
+    // Idle prefetch, one row at a time
+    QTimer* m_prefetchTimer;
+    QList<int> m_prefetchRows;
+    QString m_prefetchId;           // row being decoded, if any
+    QElapsedTimer m_prefetchClock;
+    qint64 m_prefetchBytes;
+    bool m_scrollingUp;
+    quint64 m_warmRequest;          // AnimatedPreviewCache strip being warmed, if any
+    
+    QNetworkAccessManager* m_networkManager;
+    QTimer* m_workshopLoadTimer;
+    QStringList m_workshopQueue;
+    QSet<QString> m_workshopInFlight;
+    QHash<QString, WallpaperInfo> m_workshopData;   // finished lookups by id
+};
+
+// Paints one wallpaper card: preview, bold wrapped title and an info line.
+// Text layouts and frames come from PreviewCardPainter's caches
+class WallpaperGridDelegate : public QStyledItemDelegate
+{
+    Q_OBJECT
+
+public:
+    explicit WallpaperGridDelegate(WallpaperGridModel* model, QObject* parent = nullptr);
+    
+    void paint(QPainter* painter, const QStyleOptionViewItem& option, const QModelIndex& index) const override;
+    QSize sizeHint(const QStyleOptionViewItem& option, const QModelIndex& index) const override;
+    
+    // Layout constants with better sizing for text handling
+    static constexpr int ITEM_WIDTH = 280;
+    static constexpr int ITEM_HEIGHT = 240; // Increased to accommodate text properly
+    static constexpr int PREVIEW_WIDTH = 256;
+    static constexpr int PREVIEW_HEIGHT = 144;
+    static constexpr int PREVIEW_CONTAINER_MARGIN = 12;
+    static constexpr int TEXT_AREA_HEIGHT = 80; // Reserved space for text
+    static constexpr int TEXT_LINE_HEIGHT = 16;
+    static constexpr int TEXT_MARGIN = 8;
+    static constexpr int TEXT_MAX_WIDTH = PREVIEW_WIDTH - (TEXT_MARGIN * 2);
+
+private:
+    WallpaperGridModel* m_model;
+};
+
+// Virtualized icon mode view over a WallpaperGridModel. Only visible cells are
+// laid out and painted; the range of visible rows is handed to the model a
+// moment after scrolling or resizing settles.
+class WallpaperGridView : public QListView
+{
+    Q_OBJECT
+
+public:
+    explicit WallpaperGridView(QWidget* parent = nullptr);
+    
+    WallpaperGridModel* gridModel() const { return m_model; }
+    
+    static constexpr int ITEM_SPACING = 16;
+
+protected:
+    bool viewportEvent(QEvent* event) override;
+    void keyPressEvent(QKeyEvent* event) override;
+    void resizeEvent(QResizeEvent* event) override;
+    void startDrag(Qt::DropActions supportedActions) override;
+
+private slots:
+    void updateVisibleRows();
+
+private:
+    WallpaperGridModel* m_model;
+    QTimer* m_viewportTimer;
+};
+
+#endif // WALLPAPERGRIDVIEW_H
@@ -4,11 +4,10 @@
 #include <QWidget>
 #include <QLabel>
 #include <QPixmap>
-#include <QGridLayout>
-#include <QScrollArea>
 #include <QLineEdit>
 #include <QComboBox>
 #include <QPushButton>
+#include <QToolButton>
 #include <QListWidget>
 #include <QListWidgetItem>
 #include <QNetworkAccessManager>
@@ -31,8 +30,14 @@
 #include <QMenu>
 #include <QAction>
 #include <QContextMenuEvent>
+#include <QModelIndex>
 #include <QSet>
 #include "../core/WallpaperManager.h"
+#include "../core/WallpaperSearchIndex.h"
+#include "../core/WallpaperSorter.h"
+#include "../core/WallpaperFacetIndex.h"
+
+class WallpaperGridView;
 
 Q_DECLARE_LOGGING_CATEGORY(wallpaperPreview)
 
@@ -41,115 +46,6 @@ inline bool operator==(const WallpaperInfo& lhs, const WallpaperInfo& rhs) {
     return lhs.id == rhs.id;
 }
 
-class WallpaperPreviewItem : public QWidget
-{
-    Q_OBJECT
-
-public:
-    explicit WallpaperPreviewItem(const WallpaperInfo& wallpaper, QWidget* parent = nullptr);
-    
-    const WallpaperInfo& wallpaperInfo() const { return m_wallpaper; }
-    void setSelected(bool selected);
-    bool isSelected() const { return m_selected; }
-    void updateStyle();
-    void loadWorkshopDataNow();
-    bool isWorkshopDataLoaded() const { return m_workshopDataLoaded; }
-    
-    // Add method to cancel any pending operations
-    void cancelPendingOperations() { m_workshopDataCancelled = true; }
-    bool isCancelled() const { return m_workshopDataCancelled; }
-    
-    // Animation methods - made public
-    void startAnimation();
-    void stopAnimation();
-    bool isAnimationPlaying() const;
-    bool hasAnimatedPreview() const;
-    void loadAnimatedPreview();
-    
-    // Layout constants with better sizing for text handling
-    static constexpr int ITEM_WIDTH = 280;
-    static constexpr int ITEM_HEIGHT = 240; // Increased to accommodate text properly
-    static constexpr int PREVIEW_WIDTH = 256;
-    static constexpr int PREVIEW_HEIGHT = 144;
-    static constexpr int PREVIEW_CONTAINER_MARGIN = 12;
-    static constexpr int TEXT_AREA_HEIGHT = 80; // Reserved space for text
-    static constexpr int TEXT_LINE_HEIGHT = 16;
-    static constexpr int TEXT_MARGIN = 8;
-    static constexpr int TEXT_MAX_WIDTH = PREVIEW_WIDTH - (TEXT_MARGIN * 2);
-
-signals:
-    void clicked(const WallpaperInfo& wallpaper);
-    void doubleClicked(const WallpaperInfo& wallpaper);
-    void toggleHiddenRequested(const WallpaperInfo& wallpaper, bool hidden);
-
-protected:
-    void paintEvent(QPaintEvent* event) override;
-    void mousePressEvent(QMouseEvent* event) override;
-    void mouseDoubleClickEvent(QMouseEvent* event) override;
-    void mouseMoveEvent(QMouseEvent* event) override;
-    void resizeEvent(QResizeEvent* event) override;
-    void contextMenuEvent(QContextMenuEvent* event) override;
-
-private:
-    void setupUI();
-    void loadPreviewImage();
-    void loadWorkshopData();
-    void fetchWorkshopInfoHTTP(const QString& workshopId);
-    void parseWorkshopDataFromJson(const QJsonObject& response, const QString& workshopId);
-    void fetchSteamUserName(const QString& steamId);
-    QString getUsernameFromLocalSteamData(const QString& steamId);  // Add this method
-    QString extractUsernameFromVdf(const QString& vdfPath, const QString& steamId);  // Add this method
-    QString extractUsernameFromLoginUsers(const QString& loginUsersPath, const QString& steamId);  // Add this method
-    QString cleanBBCode(const QString& text);
-    void tryAlternativeWorkshopMethods(const QString& workshopId);
-    QString extractWorkshopId();
-    QString extractWorkshopIdFromPath(const QString& wallpaperPath);
-    QString extractWorkshopIdFromDirectory();
-    void setFallbackValues();
-    void setupTextLabels();
-    QString elidedText(const QString& text, int maxWidth);
-    void setPreviewPixmap(const QPixmap& pixmap);
-    QPixmap scalePreviewKeepAspectRatio(const QPixmap& original);
-    QSize calculateFitSize(const QSize& imageSize, const QSize& containerSize);
-    void updateTextLayout();
-    void drawTextWithWordWrap(QPainter& painter, const QString& text, const QRect& rect, 
-                             const QFont& font, const QColor& color, Qt::Alignment alignment = Qt::AlignLeft);
-    
-    // Enhanced workshop data methods - updated for Steam API
-    void parseWorkshopDataFromFilesystem();
-    void tryLoadFromSteamCache();
-    QString findWorkshopIdInSteamLibraries();
-    
-    // Context menu actions
-    void showContextMenu(const QPoint& pos);
-    void addToFavorites();
-    void removeFromFavorites();
-    void openInBrowser();
-    
-public slots:
-    void loadWorkshopDataDeferred();
-    
-private:
-    WallpaperInfo m_wallpaper;
-    QLabel* m_previewLabel;
-    QLabel* m_nameLabel;
-    QLabel* m_typeLabel;
-    QLabel* m_authorLabel;
-    bool m_selected;
-    bool m_workshopDataLoaded;
-    static QNetworkAccessManager* s_networkManager;
-    QMovie* m_previewMovie;
-    QPixmap m_scaledPreview;
-    bool m_useCustomPainting; // Flag to use custom text rendering
-
-    // Add cancellation flag
-    bool m_cancelled;
-    bool m_workshopDataCancelled;
-    
-    // Drag and drop support
-    QPoint m_dragStartPosition;
-};
-
 class WallpaperPreview : public QWidget
 {
     Q_OBJECT
@@ -175,66 +71,43 @@ public:
     void stopAllPreviewAnimations();
     void startAllPreviewAnimations();
 
-    // Dynamic layout constants
-    static constexpr int ITEMS_PER_PAGE = 20;
-    static constexpr int MIN_ITEMS_PER_ROW = 1;
-    static constexpr int MAX_ITEMS_PER_ROW = 8;
-    static constexpr int PREFERRED_ITEMS_PER_ROW = 4;
-    static constexpr int ITEMS_PER_ROW = PREFERRED_ITEMS_PER_ROW; // Backward compatibility
-    static constexpr int ITEM_SPACING = 16;
-    static constexpr int MIN_CONTAINER_WIDTH = 400; // Minimum width before reducing columns
-    static constexpr int SIDEBAR_WIDTH = 300; // Estimated sidebar width
-    
-    // Workshop batch processing constants
-    static constexpr int WORKSHOP_BATCH_SIZE = 3; // Reduced for better performance
-    static constexpr int WORKSHOP_BATCH_DELAY = 200; // Increased delay
-
 signals:
     void wallpaperSelected(const WallpaperInfo& wallpaper);
     void wallpaperDoubleClicked(const WallpaperInfo& wallpaper);
     void wallpaperHiddenToggled(const WallpaperInfo& wallpaper, bool hidden);
 
-protected:
-    void resizeEvent(QResizeEvent* event) override;
-
 private slots:
     void onWallpapersChanged();
+    void onWallpaperPreviewChanged(const QString& wallpaperId, const QString& previewPath);
+    void onWorkshopDataLoaded(const WallpaperInfo& wallpaper);
+    void onWallpaperDetailsChanged(const WallpaperInfo& wallpaper);
+    void onDetailsSettled();
     void onSearchTextChanged(const QString& text);
     void onFilterChanged();
+    void onSortOrderChanged();
+    void onTagMenuAboutToShow();
+    void onWallpaperLaunched(const QString& wallpaperId);
     void onRefreshClicked();
     void onApplyClicked();
-    void onWallpaperItemClicked(const WallpaperInfo& wallpaper);
-    void onWallpaperItemDoubleClicked(const WallpaperInfo& wallpaper);
-    void onPreviousPage();
-    void onNextPage();
-    void onPageChanged();
-    void loadWorkshopDataBatch();
+    void onCurrentWallpaperChanged(const QModelIndex& current);
+    void onWallpaperDoubleClicked(const QModelIndex& index);
+    void showContextMenu(const QPoint& pos);
 
 private:
     void setupUI();
     void updateWallpaperGrid();
-    void setupPagination();
-    void updatePageInfo();
-    void loadCurrentPage();
-    void clearCurrentPage();
-    QList<WallpaperInfo> getFilteredWallpapers() const;
-    void clearSelection();
-    void startWallpaperDataLoading();
-    void processNextWorkshopBatch();
-    
-    // Enhanced responsive layout methods
-    int calculateItemsPerRow() const;
-    int getCurrentItemsPerRow() const { return m_currentItemsPerRow; }
-    void updateGridLayout();
-    void recalculateLayout();
-    void adjustGridForNewColumnCount(int newColumnCount);
+    void reloadCatalog();
+    void reindexCatalog();
+    void filterWallpapers();
+    QVector<int> sortedRows() const;
+    QList<WallpaperInfo> wallpapersAt(const QVector<int>& rows) const;
+    void applySort();
+    FacetBitmap hiddenRows() const;
+    void updateFacetCounts(const FacetBitmap& typeRows, const FacetBitmap& tagRows);
     
     // Workshop handling improvements
     ::QString getWorkshopDirectory() const;
     QStringList getWorkshopIds() const;
-    ::QString findWallpaperIdForWallpaper(const ::QString& wallpaperPath);
-    bool isAnimatedWallpaper(const WallpaperInfo& wallpaper);
-    void handleAnimatedPreview(WallpaperPreviewItem* item);
     ::QString getWorkshopIdFromFilesystem(const ::QString& wallpaperPath);
     QStringList scanWorkshopDirectory();
 
@@ -244,36 +117,42 @@ private:
     // UI components
     QLineEdit* m_searchEdit;
     QComboBox* m_filterCombo;
+    QComboBox* m_sortCombo;
+    QToolButton* m_tagButton;
+    QMenu* m_tagMenu;
     QPushButton* m_refreshButton;
     QPushButton* m_applyButton;
-    QScrollArea* m_scrollArea;
-    QWidget* m_gridWidget;
-    QGridLayout* m_gridLayout;
-    
-    // Pagination UI
-    QWidget* m_paginationWidget;
-    QPushButton* m_prevPageButton;
-    QPushButton* m_nextPageButton;
-    QLabel* m_pageInfoLabel;
-    
-    // Pagination state
-    QList<WallpaperInfo> m_filteredWallpapers;
-    QList<WallpaperPreviewItem*> m_currentPageItems;
-    WallpaperPreviewItem* m_selectedItem;
-    int m_currentPage;
-    int m_totalPages;
-    
-    // Wallpaper data loading
-    QTimer* m_workshopLoadTimer;
-    QList<WallpaperPreviewItem*> m_pendingWallpaperItems;
-    int m_pendingItemIndex;
-    QList<WallpaperPreviewItem*> m_pendingWorkshopItems;
-    int m_workshopBatchIndex;
-    
-    // Responsive layout
-    int m_currentItemsPerRow;
-    int m_lastContainerWidth;
-    bool m_layoutUpdatePending;
+    WallpaperGridView* m_gridView;
+    
+    // Set while the selection is changed from code, so no signal goes out
+    bool m_selectingWallpaper;
+    
+    // Workshop and external wallpapers as of the last change, and their index
+    QList<WallpaperInfo> m_allWallpapers;
+    QHash<QString, int> m_catalogRows;
+    WallpaperSearchIndex m_searchIndex;
+    WallpaperSorter m_sorter;
+    WallpaperFacetIndex m_facets;
+    
+    // Tag filter, as folded tag keys, and how many results each tag of
+    // m_facets would leave
+    QStringList m_selectedTags;
+    bool m_matchAllTags;
+    QVector<int> m_tagCounts;
+    
+    // Catalog rows that passed search and filters, in scan or relevance
+    // order. A new sort order reorders a copy without filtering again
+    QVector<int> m_filteredRows;
+    QVector<int> m_shownRows;   // m_filteredRows as sorted into the grid
+    QTimer* m_searchTimer;
+    
+    // Typing only filters once it pauses this long
+    static constexpr int SEARCH_DEBOUNCE_MS = 150;
+    
+    // Workshop details arrive a few at a time while browsing; they are
+    // indexed together once they pause this long
+    QTimer* m_detailsTimer;
+    static constexpr int DETAILS_DEBOUNCE_MS = 1000;
     
     // Hidden wallpapers tracking
     QSet<QString> m_hiddenWallpapers;
@@ -282,19 +161,6 @@ private:
     // Helper methods
     void loadHiddenWallpapers();
     void saveHiddenWallpapers();
-
-    // Add helper method to safely cancel all pending operations
-    void cancelAllPendingOperations();
-
-    // add missing calculateLayout alias
-    void calculateLayout();
-    
-    // Scroll to make an item visible in the scroll area
-    void scrollToItem(WallpaperPreviewItem* item);
-    
-    // Animation management methods
-    void startCurrentPageAnimations();
-    void stopCurrentPageAnimations();
 };
 
 #endif // WALLPAPERPREVIEW_H
\ No newline at end of file